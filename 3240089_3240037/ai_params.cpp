@@ -0,0 +1,168 @@
+﻿#include "ai_params.h"
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+const int AIParams::STRATEGY_COUNT;
+const int AIParams::SPELL_COUNT;
+
+// Θέση μιας αριθμητικής παραμέτρου μέσα στο AIParams
+struct ParamField {
+    const char* name;
+    size_t offset;
+};
+
+#define PARAM_AT(member, index) (offsetof(AIParams, member) + (index) * sizeof(float))
+
+// Σειρά του διανύσματος του tuner (και του αρχείου)
+static const ParamField PARAM_FIELDS[] = {
+    { "defensive_count_margin", PARAM_AT(defensive_count_margin, 0) },
+    { "defensive_power_ratio", PARAM_AT(defensive_power_ratio, 0) },
+    { "aggression_aggressive", PARAM_AT(aggression, 0) },
+    { "aggression_defensive", PARAM_AT(aggression, 1) },
+    { "aggression_expansive", PARAM_AT(aggression, 2) },
+    { "aggression_mixed", PARAM_AT(aggression, 3) },
+    { "aggression_slack", PARAM_AT(aggression_slack, 0) },
+    { "target_value_baby", PARAM_AT(kind_target_value, 0) },
+    { "target_value_warrior", PARAM_AT(kind_target_value, 1) },
+    { "target_value_tower", PARAM_AT(kind_target_value, 2) },
+    { "target_value_wizard", PARAM_AT(kind_target_value, 3) },
+    { "level_target_value", PARAM_AT(level_target_value, 0) },
+    { "target_balance_weight", PARAM_AT(target_balance_weight, 0) },
+    { "spell_freeze_baby", PARAM_AT(spell_kind_factor, 0) },
+    { "spell_freeze_warrior", PARAM_AT(spell_kind_factor, 1) },
+    { "spell_freeze_tower", PARAM_AT(spell_kind_factor, 2) },
+    { "spell_freeze_wizard", PARAM_AT(spell_kind_factor, 3) },
+    { "spell_sickness_baby", PARAM_AT(spell_kind_factor, 4) },
+    { "spell_sickness_warrior", PARAM_AT(spell_kind_factor, 5) },
+    { "spell_sickness_tower", PARAM_AT(spell_kind_factor, 6) },
+    { "spell_sickness_wizard", PARAM_AT(spell_kind_factor, 7) },
+    { "spell_convert_baby", PARAM_AT(spell_kind_factor, 8) },
+    { "spell_convert_warrior", PARAM_AT(spell_kind_factor, 9) },
+    { "spell_convert_tower", PARAM_AT(spell_kind_factor, 10) },
+    { "spell_convert_wizard", PARAM_AT(spell_kind_factor, 11) },
+    { "spell_strategy_freeze", PARAM_AT(spell_strategy_factor, 0) },
+    { "spell_strategy_sickness", PARAM_AT(spell_strategy_factor, 1) },
+    { "spell_strategy_convert", PARAM_AT(spell_strategy_factor, 2) },
+    { "spell_threshold", PARAM_AT(spell_threshold, 0) },
+    // Βάρη της policy (σειρά όπως το AIFeatures::Feature)
+    { "policy_bias", PARAM_AT(policy_weights, 0) },
+    { "policy_source_health", PARAM_AT(policy_weights, 1) },
+    { "policy_source_level", PARAM_AT(policy_weights, 2) },
+    { "policy_target_health", PARAM_AT(policy_weights, 3) },
+    { "policy_target_level", PARAM_AT(policy_weights, 4) },
+    { "policy_target_opponent", PARAM_AT(policy_weights, 5) },
+    { "policy_target_baby", PARAM_AT(policy_weights, 6) },
+    { "policy_target_warrior", PARAM_AT(policy_weights, 7) },
+    { "policy_target_tower", PARAM_AT(policy_weights, 8) },
+    { "policy_target_wizard", PARAM_AT(policy_weights, 9) },
+    { "policy_distance", PARAM_AT(policy_weights, 10) },
+    { "policy_path_time", PARAM_AT(policy_weights, 11) },
+    { "policy_route_loss", PARAM_AT(policy_weights, 12) },
+    { "policy_health_margin", PARAM_AT(policy_weights, 13) }
+};
+
+static const int PARAM_COUNT = sizeof(PARAM_FIELDS) / sizeof(PARAM_FIELDS[0]);
+static const int FIRST_POLICY_PARAM = PARAM_COUNT - LinearPolicy::WEIGHT_COUNT;
+
+#undef PARAM_AT
+
+// Οι τιμές του παιχνιδιού
+AIParams::AIParams()
+    : defensive_count_margin(2.0f), defensive_power_ratio(2.0f), aggression_slack(20.0f),
+    level_target_value(10.0f), target_balance_weight(0.1f), spell_threshold(30.0f), use_policy(false) {
+    static const float AGGRESSION[STRATEGY_COUNT] = { 0.7f, 0.3f, 0.4f, 0.5f };
+    static const float KIND_TARGET_VALUE[ENTITY_KIND_COUNT] = { 40.0f, 60.0f, 80.0f, 100.0f };
+    static const float SPELL_KIND_FACTOR[SPELL_COUNT][ENTITY_KIND_COUNT] = {
+        { 1.0f, 1.5f, 2.0f, 3.0f },
+        { 1.0f, 3.0f, 2.0f, 4.0f },
+        { 1.0f, 2.0f, 4.0f, 5.0f }
+    };
+    static const float SPELL_STRATEGY_FACTOR[SPELL_COUNT] = { 1.5f, 1.5f, 2.0f };
+
+    std::copy(AGGRESSION, AGGRESSION + STRATEGY_COUNT, aggression);
+    std::copy(KIND_TARGET_VALUE, KIND_TARGET_VALUE + ENTITY_KIND_COUNT, kind_target_value);
+    for (int s = 0; s < SPELL_COUNT; s++) {
+        std::copy(SPELL_KIND_FACTOR[s], SPELL_KIND_FACTOR[s] + ENTITY_KIND_COUNT, spell_kind_factor[s]);
+    }
+    std::copy(SPELL_STRATEGY_FACTOR, SPELL_STRATEGY_FACTOR + SPELL_COUNT, spell_strategy_factor);
+    std::copy(LinearPolicy::getDefaultWeights(), LinearPolicy::getDefaultWeights() + LinearPolicy::WEIGHT_COUNT, policy_weights);
+}
+
+float& AIParams::at(int index) {
+    return *reinterpret_cast<float*>(reinterpret_cast<char*>(this) + PARAM_FIELDS[index].offset);
+}
+
+float AIParams::at(int index) const {
+    return *reinterpret_cast<const float*>(reinterpret_cast<const char*>(this) + PARAM_FIELDS[index].offset);
+}
+
+int AIParams::getCount() {
+    return PARAM_COUNT;
+}
+
+const char* AIParams::getName(int index) {
+    return (index >= 0 && index < PARAM_COUNT) ? PARAM_FIELDS[index].name : "";
+}
+
+bool AIParams::isPolicyWeight(int index) {
+    return index >= FIRST_POLICY_PARAM && index < PARAM_COUNT;
+}
+
+std::vector<float> AIParams::toVector() const {
+    std::vector<float> values(PARAM_COUNT);
+    for (int i = 0; i < PARAM_COUNT; i++) values[i] = at(i);
+    return values;
+}
+
+// Τα βάρη της policy είναι ελεύθερα, οι υπόλοιπες παράμετροι δεν είναι αρνητικές και το
+// aggression_level μένει στο [0, 1]
+void AIParams::fromVector(const std::vector<float>& values) {
+    int count = std::min(PARAM_COUNT, (int)values.size());
+    for (int i = 0; i < count; i++) {
+        float value = values[i];
+        if (!isPolicyWeight(i)) value = std::max(0.0f, value);
+        at(i) = value;
+    }
+    for (int s = 0; s < STRATEGY_COUNT; s++) aggression[s] = std::min(aggression[s], 1.0f);
+}
+
+bool AIParams::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string name;
+        float value;
+        if (!(fields >> name) || name[0] == '#' || !(fields >> value)) continue;
+
+        if (name == "use_policy") {
+            use_policy = value != 0.0f;
+            continue;
+        }
+        for (int i = 0; i < PARAM_COUNT; i++) {
+            if (name == PARAM_FIELDS[i].name) {
+                at(i) = value;
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+bool AIParams::save(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    file << "# AI parameters (name value)\n";
+    file << "use_policy " << (use_policy ? 1 : 0) << "\n";
+    file << std::setprecision(6);
+    for (int i = 0; i < PARAM_COUNT; i++) {
+        file << PARAM_FIELDS[i].name << " " << at(i) << "\n";
+    }
+    return (bool)file;
+}
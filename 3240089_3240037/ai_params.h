@@ -0,0 +1,54 @@
+﻿#pragma once
+#include "entity.h"
+#include "ai_policy.h"
+#include <string>
+#include <vector>
+
+// Ρυθμίσιμες παράμετροι του AI: κατώφλια επιλογής στρατηγικής, επιθετικότητα ανά στρατηγική,
+// αξίες στόχων και βάρη των spells. Οι προεπιλογές είναι οι τιμές που είχε το AISystem
+// Αποθηκεύονται σε αρχείο κειμένου με μία γραμμή "όνομα τιμή" ανά παράμετρο (# για σχόλια,
+// άγνωστα ονόματα αγνοούνται), οπότε ένα αρχείο του tuner διορθώνεται και με το χέρι
+struct AIParams {
+    static const int STRATEGY_COUNT = 4;   // AGGRESSIVE, DEFENSIVE, EXPANSIVE, MIXED
+    static const int SPELL_COUNT = 3;      // Freeze, Sickness, Convert
+
+    // Επιλογή στρατηγικής: άμυνα όταν ο αντίπαλος έχει περισσότερα entities κατά
+    // defensive_count_margin ή δύναμη πάνω από defensive_power_ratio φορές τη δική μας
+    float defensive_count_margin;
+    float defensive_power_ratio;
+    float aggression[STRATEGY_COUNT];      // aggression_level ανά στρατηγική (σειρά όπως το STRATEGY_COUNT)
+    float aggression_slack;                // Απώλεια υλικού που δέχεται μια αποστολή στο aggression_level 1
+
+    // Αξία κατάληψης στόχου: είδος + level * level_target_value + ισορροπία επιρροής * βάρος
+    float kind_target_value[ENTITY_KIND_COUNT];
+    float level_target_value;
+    float target_balance_weight;
+
+    // Spells: πολλαπλασιαστής ανά spell και είδος στόχου, επιπλέον πολλαπλασιαστής όταν το spell
+    // ταιριάζει στη στρατηγική (Freeze - άμυνα, Sickness - επίθεση, Convert - επέκταση) και
+    // ελάχιστη αξία στόχου για να ριχτεί
+    float spell_kind_factor[SPELL_COUNT][ENTITY_KIND_COUNT];
+    float spell_strategy_factor[SPELL_COUNT];
+    float spell_threshold;
+
+    // Γραμμική policy για τις αποστολές troops (αντί για τους κανόνες της στρατηγικής)
+    bool use_policy;
+    float policy_weights[LinearPolicy::WEIGHT_COUNT];
+
+    AIParams();   // Οι τιμές του παιχνιδιού
+
+    // Αρχείο παραμέτρων (false αν δεν άνοιξε - οι παράμετροι που λείπουν κρατούν την τιμή τους)
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    // Οι αριθμητικές παράμετροι ως διάνυσμα σταθερής σειράς (για τον tuner)
+    static int getCount();
+    static const char* getName(int index);
+    static bool isPolicyWeight(int index);
+    std::vector<float> toVector() const;
+    void fromVector(const std::vector<float>& values);  // Με περιορισμό στα έγκυρα όρια
+
+private:
+    float& at(int index);
+    float at(int index) const;
+};
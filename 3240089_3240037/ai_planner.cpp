@@ -0,0 +1,715 @@
+﻿#include "ai_planner.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+const int AIPlanner::MAX_SEARCH_MOVES = 3;
+const int AIPlanner::SPELL_CAST_CHANCE = 50;
+const int AITroopView::PATH_SAMPLES;
+
+// Βάρος δύναμης ανά είδος entity (σειρά: Baby, Warrior, Tower, Wizard)
+static const int KIND_POWER_FACTOR[ENTITY_KIND_COUNT] = { 1, 2, 2, 3 };
+
+AIPlanner::AIPlanner(Side controlled, Side opposing)
+    : side(controlled), opponent(opposing), stage(Stage::IDLE), next_entity(0),
+    strategy(AIStrategy::ADAPTIVE), aggression_level(0.5f), rng(std::random_device()()),
+    view(nullptr), plan(nullptr), search_move(0), search_started(false), search_spent_ms(0.0f),
+    trace(nullptr), plan_serial(0), plan_cost_us(0.0f) {
+    search.seed(rng());
+}
+
+void AIPlanner::reset() {
+    aggression_level = 0.5f;
+    strategy = AIStrategy::ADAPTIVE;
+}
+
+void AIPlanner::setParams(const AIParams& new_params) {
+    params = new_params;
+    policy.reset();
+    if (params.use_policy) policy.reset(new LinearPolicy(params.policy_weights));
+}
+
+void AIPlanner::seed(unsigned int s) {
+    rng.seed(s);
+    search.seed(s);
+}
+
+// Βάρος δύναμης ανά μονάδα ζωής: πολλαπλασιαστής του τύπου και επιπλέον βάρος για level
+float AIPlanner::getPowerFactor(EntityKind kind, int level) {
+    return KIND_POWER_FACTOR[kindIndex(kind)] * (1.0f + level * 0.2f);
+}
+
+// Σχεδιασμός πάνω σε μια εικόνα - δεν διαβάζει τίποτα εκτός από την εικόνα και την κατάσταση
+// του σχεδιασμού (strategy, aggression_level, rng). Η εικόνα ενημερώνεται τοπικά με τη ζωή
+// που δεσμεύουν οι εντολές, ώστε ένα entity να μη στείλει περισσότερα troops από όσα έχει
+void AIPlanner::planSnapshot(AISnapshot& snapshot, std::vector<AICommand>& out) {
+    begin(snapshot, out);
+    while (!step(-1.0f)) {}
+}
+
+void AIPlanner::begin(AISnapshot& snapshot, std::vector<AICommand>& out) {
+    AITrace::Clock::time_point begin_start = AITrace::Clock::now();
+    view = &snapshot;
+    plan = &out;
+    plan_serial++;
+    influence.update(snapshot);
+
+    if (snapshot.decide) {
+        analyzeGameState();
+        if (snapshot.search_budget_ms <= 0.0f) {
+            buildUtility();
+
+            // Όλες οι ενέργειες βαθμολογούνται μαζί μία φορά ανά απόφαση
+            if (policy) {
+                features.extract(snapshot);
+                policy_scores.resize(features.stride);
+                policy->score(features, policy_scores.data());
+            }
+        }
+    }
+
+    if (trace) {
+        plan_record = AITraceRecord();
+        plan_record.time_us = trace->nowUs();
+        plan_record.type = AITraceRecord::PLAN;
+        plan_record.side = (unsigned char)side;
+        plan_record.plan = plan_serial;
+        plan_record.detail = (unsigned char)strategy;
+        if (snapshot.decide) plan_record.flags |= AITraceRecord::DECIDE;
+        if (snapshot.search_budget_ms > 0.0f) plan_record.flags |= AITraceRecord::SEARCHED;
+        else if (policy) plan_record.flags |= AITraceRecord::WITH_POLICY;
+        plan_record.candidates = (unsigned short)snapshot.own.size();
+        plan_record.score = aggression_level;
+        plan_record.runner_up = snapshot.opponent_power > 0 ? (float)snapshot.own_power / snapshot.opponent_power : 0.0f;
+    }
+
+    stage = Stage::ENTITIES;
+    next_entity = 0;
+    plan_cost_us = AITrace::elapsedUs(begin_start);
+}
+
+// Ένα βήμα του σχεδίου - true όταν τελειώσει (ο χρόνος όλων των βημάτων μετρά στο cost_us του PLAN)
+bool AIPlanner::step(float slice_ms) {
+    AITrace::Clock::time_point step_start = AITrace::Clock::now();
+    if (stage == Stage::ENTITIES) {
+        if (view->decide && next_entity < view->own.size()) {
+            decideEntity(&view->own[next_entity++]);
+        }
+        else if (view->decide && view->search_budget_ms > 0.0f) {
+            beginSearch();
+            stage = Stage::SEARCH;
+        }
+        else {
+            stage = Stage::FINISH;
+        }
+    }
+    else if (stage == Stage::SEARCH) {
+        if (stepSearch(slice_ms)) stage = Stage::FINISH;
+    }
+    else if (stage == Stage::FINISH) {
+        finish();
+        stage = Stage::IDLE;
+    }
+    plan_cost_us += AITrace::elapsedUs(step_start);
+
+    if (stage != Stage::IDLE) return false;
+    if (trace) {
+        plan_record.cost_us = plan_cost_us;
+        trace_records.push_back(plan_record);
+    }
+    return true;
+}
+
+void AIPlanner::finish() {
+    // Ενημέρωση spells των Wizards της πλευράς
+    castEnemySpells();
+
+    plan_record.amount = (int)plan->size();
+    view = nullptr;
+    plan = nullptr;
+}
+
+void AIPlanner::traceCommand(AITraceRecord::Origin origin, float score, float runner_up, int candidates) {
+    static const unsigned char COMMAND_TYPES[] = {
+        AITraceRecord::SEND, AITraceRecord::UPGRADE, AITraceRecord::SPLASH, AITraceRecord::CAST
+    };
+    const AICommand& command = plan->back();
+    if (command.type >= AICommand::DONE) return;
+
+    AITraceRecord entry;
+    entry.time_us = plan_record.time_us;
+    entry.type = COMMAND_TYPES[command.type];
+    entry.side = (unsigned char)side;
+    entry.detail = (unsigned char)origin;
+    entry.actor = (short)command.actor.slot;
+    entry.target = (short)command.target.slot;
+    entry.amount = command.type == AICommand::CAST ? command.spell_id : command.amount;
+    entry.score = score;
+    entry.runner_up = runner_up;
+    entry.candidates = (unsigned short)std::min(std::max(candidates, 0), 0xFFFF);
+    entry.plan = plan_serial;
+    trace_records.push_back(entry);
+}
+
+int AIPlanner::roll(int n) {
+    std::uniform_int_distribution<> dis(0, n - 1);
+    return dis(rng);
+}
+
+// Ανάλυση τρέχουσας κατάστασης παιχνιδιού
+void AIPlanner::analyzeGameState() {
+    // Μετατροπή size_t σε int για αποφυγή warning
+    int opponent_count = static_cast<int>(view->opponents.size());
+    int own_count = static_cast<int>(view->own.size());
+    int neutral_count = static_cast<int>(view->neutral.size());
+
+    // Συνολική δύναμη κάθε πλευράς (υπολογισμένη στην εικόνα)
+    int opponent_power = view->opponent_power;
+    int own_power = view->own_power;
+
+    //Λογική επιλογής στρατηγικής
+    if (opponent_count > own_count + params.defensive_count_margin || opponent_power > own_power * params.defensive_power_ratio) {
+        // Ο αντίπαλος είναι πολύ δυνατός - Άμυνα
+        strategy = AIStrategy::DEFENSIVE;
+    }
+    else if (neutral_count > opponent_count && neutral_count > own_count) {
+        // Υπάρχουν πολλά ουδέτερα - Επέκταση
+        strategy = AIStrategy::EXPANSIVE;
+    }
+    else if (own_count > opponent_count && own_power > opponent_power) {
+        // Αν η δική μας δύναμη είναι μεγαλύτερη - Επιθεση
+        strategy = AIStrategy::AGGRESSIVE;
+    }
+    else {
+        // Ισορροπία - μικτή στρατηγική
+        strategy = AIStrategy::MIXED;
+    }
+    aggression_level = params.aggression[static_cast<int>(strategy)];
+}
+
+// Πίνακας χρησιμότητας της απόφασης (ένας υπολογισμός για όλα τα ζεύγη πηγής - στόχου)
+// Η αξία κατάληψης κάθε στόχου εξαρτάται από το είδος, το level και την ισορροπία
+// επιρροής στη θέση του (στόχοι στην περιοχή μας αξίζουν περισσότερο)
+void AIPlanner::buildUtility() {
+    target_values.clear();
+    const std::vector<AIEntityView>* groups[2] = { &view->opponents, &view->neutral };
+    for (const std::vector<AIEntityView>* group : groups) {
+        for (const AIEntityView& entity : *group) {
+            float value = params.kind_target_value[kindIndex(entity.kind)] + entity.level * params.level_target_value;
+            value += influence.balance(side, entity.x, entity.y) * params.target_balance_weight;
+            target_values.push_back(std::max(0.0f, value));
+        }
+    }
+    utility.build(*view, target_values);
+}
+
+// Λήψη στρατηγικών αποφάσεων για κάθε οντότητα της πλευράς
+void AIPlanner::makeStrategicDecisions() {
+    // Για κάθε entity του AI, παίρνουμε απόφαση
+    for (AIEntityView& entity : view->own) {
+        decideEntity(&entity);
+    }
+}
+
+// Απόφαση για ένα entity της πλευράς
+void AIPlanner::decideEntity(AIEntityView* entity) {
+    EntityKind kind = entity->kind;
+    int health = entity->health;
+
+    // 1. Πάντα δοκιμάζουμε να αναβαθμίσουμε πρώτα (αν έχουμε αρκετή ζωή)
+    if (health > entity->max_health * 0.7f && entity->can_upgrade) {
+        if (roll(100) < 50) { // 50% πιθανότητα αναβάθμισης (ακόμα πιο συχνά)
+            upgrade(entity);
+            return;
+        }
+    }
+
+    // Πύργοι που ξεκλείδωσαν τον κλάδο splash τον παίρνουν όταν έχουν περίσσεια ζωής
+    if (kind == EntityKind::TOWER) {
+        if (entity->can_splash && health > entity->splash_cost * 2 && roll(100) < 30) {
+            AICommand command;
+            command.type = AICommand::SPLASH;
+            command.actor = entity->handle;
+            plan->push_back(command);
+            entity->can_splash = false;
+            if (trace) traceCommand(AITraceRecord::RULE, 0.0f, 0.0f, 0);
+            return;
+        }
+    }
+
+    // 2. Ειδική λογική για BABY: Προτεραιότητα στην αναβάθμιση
+    if (kind == EntityKind::BABY && entity->can_upgrade) {
+        if (roll(100) < 70) { // 70% πιθανότητα το Baby να αναβαθμιστεί
+            upgrade(entity);
+            return;
+        }
+    }
+
+    // Με αναζήτηση οι αποστολές troops επιλέγονται στο στάδιο SEARCH
+    if (view->search_budget_ms > 0.0f) return;
+
+    // Με policy οι αποστολές επιλέγονται από τις βαθμολογίες της
+    if (policy) {
+        sendByPolicy(entity);
+        return;
+    }
+
+    // 3. Λαμβάνουμε απόφαση ανάλογα με τη στρατηγική
+    int decision_roll = roll(100);
+
+    switch (strategy) {
+    case AIStrategy::AGGRESSIVE:
+        if (kind == EntityKind::WARRIOR) {
+            if (decision_roll < 80) attackWeakestPlayerTarget(entity);
+            else if (decision_roll < 95) attackStrategicTarget(entity);
+        }
+        else if (kind == EntityKind::BABY) {
+            if (decision_roll < 60) convertNearestNeutral(entity);
+            else if (decision_roll < 90 && entity->can_upgrade) {
+                upgrade(entity); // Αναβάθμιση Baby
+            }
+        }
+        break;
+
+    case AIStrategy::DEFENSIVE:
+        if (kind == EntityKind::WARRIOR) {
+            if (decision_roll < 50) attackWeakestPlayerTarget(entity);
+            else if (decision_roll < 70) convertNearestNeutral(entity);
+        }
+        else if (kind == EntityKind::BABY) {
+            if (decision_roll < 40) convertNearestNeutral(entity);
+            else if (decision_roll < 80 && entity->can_upgrade) {
+                upgrade(entity);
+            }
+        }
+        break;
+
+    case AIStrategy::EXPANSIVE:
+        if (kind == EntityKind::WARRIOR || kind == EntityKind::BABY) {
+            if (decision_roll < 80) convertNearestNeutral(entity);
+            else if (decision_roll < 95) attackWeakestPlayerTarget(entity);
+        }
+        break;
+
+    case AIStrategy::MIXED:
+        if (kind == EntityKind::WARRIOR) {
+            if (decision_roll < 60) attackWeakestPlayerTarget(entity);
+            else if (decision_roll < 85) convertNearestNeutral(entity);
+            else attackStrategicTarget(entity);
+        }
+        else if (kind == EntityKind::BABY) {
+            if (decision_roll < 50) convertNearestNeutral(entity);
+            else if (decision_roll < 85 && entity->can_upgrade) {
+                upgrade(entity);
+            }
+        }
+        break;
+
+    case AIStrategy::ADAPTIVE:
+    default:
+        if (kind == EntityKind::WARRIOR) {
+            if (decision_roll < 70) attackWeakestPlayerTarget(entity);
+            else if (decision_roll < 90) convertNearestNeutral(entity);
+            else attackStrategicTarget(entity);
+        }
+        else if (kind == EntityKind::BABY) {
+            if (decision_roll < 60) convertNearestNeutral(entity);
+            else if (decision_roll < 90 && entity->can_upgrade) {
+                upgrade(entity);
+            }
+        }
+        break;
+    }
+}
+
+// Αποστολές troops με αναζήτηση (MCTS στον απλοποιημένο κόσμο της εικόνας)
+// Το budget μοιράζεται στις MAX_SEARCH_MOVES αναζητήσεις. Κάθε αποστολή που επιλέγεται
+// εφαρμόζεται στον κόσμο πριν από την επόμενη αναζήτηση, οπότε οι αποστολές συνδυάζονται
+void AIPlanner::beginSearch() {
+    search_world.build(*view);
+    search_move = 0;
+    search_started = false;
+
+    // Εικόνα κάθε θέσης του κόσμου (ίδια σειρά: αντίπαλοι, πλευρά του AI, ουδέτερα)
+    int index = 0;
+    std::vector<AIEntityView>* groups[3] = { &view->opponents, &view->own, &view->neutral };
+    for (std::vector<AIEntityView>* group : groups) {
+        for (AIEntityView& entity : *group) {
+            if (index >= search_world.entity_count) break;
+            search_views[index++] = &entity;
+        }
+    }
+}
+
+// Κάθε αναζήτηση παίρνει συνολικά το μερίδιό της από το budget, όσα κομμάτια κι αν χρειαστεί
+bool AIPlanner::stepSearch(float slice_ms) {
+    float move_budget = view->search_budget_ms / MAX_SEARCH_MOVES;
+    if (!search_started) {
+        if (search_move >= MAX_SEARCH_MOVES || !search.begin(search_world, side)) return true;
+        search_started = true;
+        search_spent_ms = 0.0f;
+    }
+
+    float remaining = move_budget - search_spent_ms;
+    AITrace::Clock::time_point slice_start = AITrace::Clock::now();
+    search.iterate(search_world, slice_ms >= 0.0f ? std::min(slice_ms, remaining) : remaining);
+    search_spent_ms += AITrace::elapsedUs(slice_start) / 1000.0f;
+    if (search_spent_ms < move_budget) return false;
+
+    search_started = false;
+    search_move++;
+    SimAction move = search.bestMove();
+    if (move.from < 0) return true;
+
+    size_t before = plan->size();
+    sendTroops(search_views[move.from], search_views[move.to], search_world.sendAmount(move.from));
+    search_world.send(move.from, move.to);
+
+    // Βαθμολογίες: μέση αξιολόγηση της κίνησης και της δεύτερης πιο δοκιμασμένης
+    if (trace && plan->size() > before) {
+        const SearchStats& stats = search.getLastStats();
+        traceCommand(AITraceRecord::SEARCH, stats.value, stats.runner_up, stats.candidates);
+    }
+    return search_move >= MAX_SEARCH_MOVES;
+}
+
+// Ρίψη spells από τους Wizards της πλευράς
+void AIPlanner::castEnemySpells() {
+    for (AIEntityView& entity : view->own) {
+        if (entity.kind == EntityKind::WIZARD) {
+            // Πιθανότητα ανά σχεδιασμό να ρίξει spell
+            if (roll(100) < SPELL_CAST_CHANCE) {
+                castSmartSpell(&entity);
+            }
+        }
+    }
+}
+
+// Έξυπνη λογική για επιλογή και ρίψη spells
+void AIPlanner::castSmartSpell(AIEntityView* wizard) {
+    if (!wizard) return;
+
+    if (view->opponents.empty()) return;
+
+    // Επιλογή spell με βάση τη στρατηγική
+    int spell_to_cast = -1;
+
+    switch (strategy) {
+    case AIStrategy::AGGRESSIVE:
+        spell_to_cast = 1; // Sickness - για επιθετικότητα
+        break;
+    case AIStrategy::DEFENSIVE:
+        spell_to_cast = 0; // Freeze - για άμυνα
+        break;
+    case AIStrategy::EXPANSIVE:
+        spell_to_cast = 2; // Convert - για επέκταση
+        break;
+    default:
+        // Τυχαία επιλογή
+        spell_to_cast = roll(3);
+        break;
+    }
+
+    // Έλεγχος διαθεσιμότητας επιλεγμενου spell
+    if (!wizard->can_cast[spell_to_cast]) {
+        // Αν δεν μπορεί να ρίξει το επιλεγμένο, δοκιμάζουμε τα υπόλοιπα
+        for (int i = 0; i < 3; i++) {
+            if (wizard->can_cast[i]) {
+                spell_to_cast = i;
+                break;
+            }
+        }
+    }
+
+    // Ρίψη spell αν είναι δυνατή
+    if (spell_to_cast >= 0 && wizard->can_cast[spell_to_cast]) {
+        // Βρίσκουμε τον καλύτερο στόχο για το spell
+        const AIEntityView* best_target = nullptr;
+        float best_value = -1.0f;
+        float second_value = -1.0f;  // Για το ίχνος
+
+        for (const AIEntityView& target : view->opponents) {
+            float value = evaluateSpellValue(spell_to_cast, &target);
+            if (value > best_value) {
+                second_value = best_value;
+                best_value = value;
+                best_target = &target;
+            }
+            else if (value > second_value) {
+                second_value = value;
+            }
+        }
+
+        // Ρίψη spell αν υπάρχει κατάλληλος στόχος
+        if (best_target && best_value > params.spell_threshold) {
+            int cost = wizard->spell_cost[spell_to_cast];
+            if (wizard->health >= cost) {
+                AICommand command;
+                command.type = AICommand::CAST;
+                command.actor = wizard->handle;
+                command.target = best_target->handle;
+                command.spell_id = spell_to_cast;
+                plan->push_back(command);
+                if (trace) traceCommand(AITraceRecord::RULE, best_value, second_value, (int)view->opponents.size());
+
+                wizard->health -= cost;
+                wizard->can_cast[spell_to_cast] = false;
+            }
+        }
+    }
+}
+
+// Αξιολόγηση στόχου για συγκεκριμένο spell
+float AIPlanner::evaluateSpellValue(int spell_id, const AIEntityView* target) {
+    if (!target) return 0.0f;
+
+    float value = static_cast<float>(target->health);
+
+    // Προσαρμογή βάσει τύπου στόχου
+    EntityKind kind = target->kind;
+    if (spell_id >= 0 && spell_id < 3) {
+        // Το Sickness αξίζει σε Warrior μόνο από level 3 και πάνω
+        bool weak_warrior = spell_id == 1 && kind == EntityKind::WARRIOR && target->level <= 2;
+        if (!weak_warrior) value *= params.spell_kind_factor[spell_id][kindIndex(kind)];
+    }
+
+    // Προσαρμογή βάσει στρατηγικής
+    if (strategy == AIStrategy::AGGRESSIVE && spell_id == 1) value *= params.spell_strategy_factor[1];
+    if (strategy == AIStrategy::DEFENSIVE && spell_id == 0) value *= params.spell_strategy_factor[0];
+    if (strategy == AIStrategy::EXPANSIVE && spell_id == 2) value *= params.spell_strategy_factor[2];
+
+    return value;
+}
+
+// Απλοποιημένη εκτέλεση επιθετικής στρατηγικής
+void AIPlanner::executeAggressiveStrategy() {
+    for (AIEntityView& entity : view->own) {
+        if (entity.kind == EntityKind::WARRIOR && roll(100) < 70) {
+            attackWeakestPlayerTarget(&entity);
+        }
+    }
+}
+
+// Απλοποιημένη εκτέλεση αμυντικής στρατηγικής
+void AIPlanner::executeDefensiveStrategy() {
+    for (AIEntityView& entity : view->own) {
+        if (entity.kind == EntityKind::WARRIOR && roll(100) < 30) {
+            convertNearestNeutral(&entity);
+        }
+    }
+}
+
+// Απλοποιημένη εκτέλεση επεκτατικής στρατηγικής
+void AIPlanner::executeExpansiveStrategy() {
+    for (AIEntityView& entity : view->own) {
+        if ((entity.kind == EntityKind::WARRIOR || entity.kind == EntityKind::BABY) && roll(100) < 60) {
+            convertNearestNeutral(&entity);
+        }
+    }
+}
+
+// Απλοποιημένη εκτέλεση μικτής στρατηγικης
+void AIPlanner::executeMixedStrategy() {
+    for (AIEntityView& entity : view->own) {
+        if (entity.kind == EntityKind::WARRIOR) {
+            int decision_roll = roll(100);
+            if (decision_roll < 40) attackWeakestPlayerTarget(&entity);
+            else if (decision_roll < 70) convertNearestNeutral(&entity);
+        }
+    }
+}
+
+// Εκτέλεση προσαρμοστικής στρατηγικής
+void AIPlanner::executeAdaptiveStrategy() {
+    // Χρησιμοποιούμε την makeStrategicDecisions που έχει adaptive λογική
+    makeStrategicDecisions();
+}
+
+// Επίθεση στον καλύτερο στόχο του αντιπάλου (συνήθως τον ασθενέστερο σε απόσταση που φτάνουμε)
+void AIPlanner::attackWeakestPlayerTarget(AIEntityView* attacker) {
+    sendBest(attacker, true, false);
+}
+
+// Επίθεση σε στρατηγικό στόχο (Wizards, πύργους και αναβαθμισμένους Warriors αν υπάρχουν)
+void AIPlanner::attackStrategicTarget(AIEntityView* attacker) {
+    if (!sendBest(attacker, true, true)) sendBest(attacker, true, false);
+}
+
+// Εύρεση πιο απειλητικής οντότητας του αντιπάλου
+AIEntityView* AIPlanner::findMostThreateningPlayerEntity() {
+    if (view->opponents.empty()) return nullptr;
+
+    AIEntityView* most_threatening = nullptr;
+    int max_threat = -1;
+
+    for (AIEntityView& entity : view->opponents) {
+        // Επιρροή του αντιπάλου γύρω από το entity (μαζί με τα troops που κατευθύνονται εκεί)
+        int threat = static_cast<int>(influence.sample(opponent, entity.x, entity.y)) * entity.level;
+        if (entity.kind == EntityKind::WIZARD) threat *= 2;
+
+        if (threat > max_threat) {
+            max_threat = threat;
+            most_threatening = &entity;
+        }
+    }
+
+    return most_threatening;
+}
+
+// Μετατροπή ουδέτερου (του καλύτερου για αυτή την πηγή στον πίνακα χρησιμότητας)
+void AIPlanner::convertNearestNeutral(AIEntityView* converter) {
+    sendBest(converter, false, false);
+}
+
+// Αποστολή με την καλύτερη αξία στη γραμμή της πηγής (στόχοι του αντιπάλου ή ουδέτεροι)
+// Δεκτές είναι και αποστολές με μικρή απώλεια υλικού, ανάλογα με την επιθετικότητα
+bool AIPlanner::sendBest(AIEntityView* attacker, bool opponent_targets, bool threatening_only) {
+    if (!attacker || view->own.empty()) return false;
+
+    int source = (int)(attacker - &view->own[0]);
+    if (source < 0 || source >= utility.getSourceCount()) return false;
+
+    int first = opponent_targets ? 0 : utility.getOpponentCount();
+    int end = opponent_targets ? utility.getOpponentCount() : utility.getTargetCount();
+
+    int best_target = -1;
+    int best_option = -1;
+    float best_score = -aggression_level * params.aggression_slack;
+    float target_scores[2] = { AIUtility::NO_SCORE, AIUtility::NO_SCORE };  // Δύο καλύτεροι στόχοι (για το ίχνος)
+    int candidates = 0;
+    for (int j = first; j < end; j++) {
+        if (threatening_only && !isThreatening(&view->opponents[j])) continue;
+        candidates++;
+
+        float target_score = AIUtility::NO_SCORE;
+        for (int k = 0; k < AIUtility::AMOUNT_OPTIONS; k++) {
+            float score = utility.getScore(source, k, j);
+            target_score = std::max(target_score, score);
+            if (score > best_score) {
+                best_score = score;
+                best_target = j;
+                best_option = k;
+            }
+        }
+        if (target_score > target_scores[0]) {
+            target_scores[1] = target_scores[0];
+            target_scores[0] = target_score;
+        }
+        else if (target_score > target_scores[1]) {
+            target_scores[1] = target_score;
+        }
+    }
+    if (best_target < 0) return false;
+
+    size_t before = plan->size();
+    sendChosen(attacker, source, best_target, best_option);
+    if (trace && plan->size() > before) traceCommand(AITraceRecord::RULE, best_score, target_scores[1], candidates);
+    return true;
+}
+
+// Αποστολή στην ενέργεια με τη μεγαλύτερη θετική βαθμολογία της policy για την πηγή
+// Η ποσότητα είναι η καλύτερη του πίνακα χρησιμότητας για τον στόχο (στόχοι κλειστοί στον
+// πίνακα, π.χ. ήδη καταλαμβάνονται από troops που ταξιδεύουν, παραλείπονται)
+void AIPlanner::sendByPolicy(AIEntityView* attacker) {
+    if (!attacker || view->own.empty()) return;
+
+    int source = (int)(attacker - &view->own[0]);
+    if (source < 0 || source >= features.source_count || source >= utility.getSourceCount()) return;
+
+    int best_target = -1;
+    int best_option = -1;
+    float best_score = 0.0f;
+    float runner_up = 0.0f;  // Καλύτερη βαθμολογία άλλου έγκυρου στόχου (για το ίχνος)
+    int candidates = 0;
+    for (int j = 0; j < features.target_count; j++) {
+        int action = source * features.target_count + j;
+        if (!features.valid[action]) continue;
+        candidates++;
+        if (policy_scores[action] <= best_score) {
+            runner_up = std::max(runner_up, policy_scores[action]);
+            continue;
+        }
+
+        int option = -1;
+        float option_score = AIUtility::NO_SCORE;
+        for (int k = 0; k < AIUtility::AMOUNT_OPTIONS; k++) {
+            float score = utility.getScore(source, k, j);
+            if (score > option_score) {
+                option_score = score;
+                option = k;
+            }
+        }
+        if (option < 0) continue;
+
+        if (best_target >= 0) runner_up = std::max(runner_up, best_score);
+        best_score = policy_scores[action];
+        best_target = j;
+        best_option = option;
+    }
+    if (best_target < 0) return;
+
+    size_t before = plan->size();
+    sendChosen(attacker, source, best_target, best_option);
+    if (trace && plan->size() > before) traceCommand(AITraceRecord::POLICY, best_score, runner_up, candidates);
+}
+
+// Αποστολή της επιλογής (πηγή, στόχος, ποσότητα) του πίνακα χρησιμότητας
+void AIPlanner::sendChosen(AIEntityView* attacker, int source, int target_index, int option) {
+    int opponent_count = utility.getOpponentCount();
+    AIEntityView* target = target_index < opponent_count ? &view->opponents[target_index] : &view->neutral[target_index - opponent_count];
+
+    // Αν η επιλογή καταλαμβάνει τον στόχο, στέλνεται μόνο όσο χρειάζεται (μαζί με ό,τι ήδη ταξιδεύει)
+    int amount = utility.getAmount(source, option);
+    int needed = utility.getCaptureAmount(source, target_index);
+    if (needed > 0 && needed < amount) amount = needed;
+
+    int before = attacker->health;
+    sendTroops(attacker, target, amount);
+    utility.commit(source, target_index, before - attacker->health);
+}
+
+// Αποστολή troops από μία οντότητα σε άλλη (εντολή - η ζωή δεσμεύεται στην εικόνα)
+void AIPlanner::sendTroops(AIEntityView* from, const AIEntityView* to, int amount) {
+    if (!from || !to || amount <= 0) return;
+
+    // Αφήνουμε τουλάχιστον 10 ζωή για να μην πεθάνει αμέσως
+    if (from->health <= amount + 10) {
+        amount = from->health - 10; // Στέλνουμε όσο περισσότερο μπορούμε
+        if (amount < 5) return; // Πολύ λίγο - δεν στέλνουμε
+    }
+
+    AICommand command;
+    command.type = AICommand::SEND;
+    command.actor = from->handle;
+    command.target = to->handle;
+    command.amount = amount;
+    plan->push_back(command);
+
+    from->health -= amount;
+}
+
+// Αναβάθμιση (εντολή - μία ανά entity σε κάθε σχεδιασμό)
+void AIPlanner::upgrade(AIEntityView* entity) {
+    AICommand command;
+    command.type = AICommand::UPGRADE;
+    command.actor = entity->handle;
+    plan->push_back(command);
+
+    entity->can_upgrade = false;
+    if (trace) traceCommand(AITraceRecord::RULE, 0.0f, 0.0f, 0);
+}
+
+// Έλεγχος αν οντότητα είναι απειλητική
+bool AIPlanner::isThreatening(const AIEntityView* entity) {
+    if (!entity) return false;
+
+    switch (entity->kind) {
+    case EntityKind::WIZARD:
+    case EntityKind::TOWER:
+        return true;
+    case EntityKind::WARRIOR:
+        return entity->level > 1;
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,229 @@
+﻿#pragma once
+#include "entity.h"
+#include "ai_search.h"
+#include "influence_map.h"
+#include "ai_utility.h"
+#include "ai_policy.h"
+#include "ai_params.h"
+#include "ai_trace.h"
+#include <vector>
+#include <memory>
+#include <random>
+
+// Αντίγραφο ενός entity για τον σχεδιασμό του AI (ό,τι χρειάζονται οι αποφάσεις)
+struct AIEntityView {
+    EntityHandle handle;
+    EntityKind kind;
+    Side side;
+    int health;
+    int max_health;
+    int level;
+    float x, y;
+    float healing_speed;
+    float defense;
+    int attacking_speed;
+    int tower_damage;      // Tower: ζημιά ανά βολή, διάστημα και ακτίνα (0 για τα υπόλοιπα)
+    float attack_interval;
+    float attack_radius;
+    bool can_upgrade;
+    bool can_splash;       // Tower: μπορεί να πάρει τον κλάδο splash
+    int splash_cost;
+    bool can_cast[3];      // Wizard: διαθέσιμα spells (0=Freeze, 1=Sickness, 2=Convert)
+    int spell_cost[3];
+    Side projected_side;   // Πλευρά και ζωή μετά τα troops που ήδη ταξιδεύουν προς αυτό (TroopLedger)
+    int projected_health;
+};
+
+// Troop σε κίνηση (για την αναζήτηση και τους χάρτες επιρροής - μόνο στις εικόνες λήψης αποφάσεων)
+struct AITroopView {
+    EntityHandle target;
+    Side side;
+    int amount;
+    float x, y;
+    float eta;             // Δευτερόλεπτα μέχρι την άφιξη
+
+    // Σημεία της υπόλοιπης διαδρομής (από την τρέχουσα θέση μέχρι τον στόχο)
+    static const int PATH_SAMPLES = 4;
+    float path_x[PATH_SAMPLES], path_y[PATH_SAMPLES];
+};
+
+// Διαδρομή από entity της πλευράς του AI προς στόχο (από τα μονοπάτια και τους πίνακες έκθεσης του γράφου)
+struct AIRoute {
+    float travel = -1.0f;  // Δευτερόλεπτα διαδρομής (< 0: δεν υπάρχει μονοπάτι)
+    float loss = 0.0f;     // Αναμενόμενη ζημιά από πύργους άλλων πλευρών στη διαδρομή
+};
+
+// Αμετάβλητη εικόνα του κόσμου που παίρνει το thread του AI
+// Φτιάχνεται στο main thread και μετά δεν διαβάζει τίποτα από το GlobalState ή το EntityStore
+struct AISnapshot {
+    std::vector<AIEntityView> opponents;  // Entities του αντιπάλου
+    std::vector<AIEntityView> own;        // Entities της πλευράς του AI
+    std::vector<AIEntityView> neutral;
+    std::vector<AITroopView> troops;
+    std::vector<AIRoute> routes;  // [δικό * (αντίπαλοι + ουδέτερα) + στόχος] (μόνο στις αποφάσεις)
+    int opponent_power = 0;
+    int own_power = 0;
+    Side side = Side::ENEMY;  // Πλευρά του AI
+    bool decide = false;   // Πλήρης λήψη αποφάσεων (αλλιώς μόνο spells)
+    float search_budget_ms = 0.0f;  // Χρόνος αναζήτησης ανά απόφαση (0: μόνο κανόνες)
+};
+
+// Εντολή του AI προς το main thread (εφαρμόζεται στο όριο του frame)
+struct AICommand {
+    enum Type : unsigned char {
+        SEND,      // Αποστολή troops από actor σε target
+        UPGRADE,   // Αναβάθμιση του actor
+        SPLASH,    // Κλάδος splash για τον πύργο actor
+        CAST,      // Spell από τον Wizard actor στο target
+        DONE       // Τέλος του σχεδίου (ο worker είναι ελεύθερος για νέα εικόνα)
+    };
+
+    Type type = DONE;
+    EntityHandle actor;
+    EntityHandle target;
+    int amount = 0;
+    int spell_id = -1;
+};
+
+// Σχεδιασμός του AI μιας πλευράς: από μια εικόνα (AISnapshot) σε εντολές (AICommand)
+// Δεν διαβάζει τίποτα εκτός από την εικόνα και τη δική του κατάσταση (στρατηγική, παράμετροι,
+// rng, χάρτες επιρροής, πίνακας χρησιμότητας, policy, αναζήτηση), οπότε δεν χρειάζεται
+// GlobalState, EntityStore ή γράφο. Το AISystem τον τρέχει στον worker ή σε βήματα στο main
+// thread, και οι αγώνες χωρίς γραφικά (self play, εργαλεία) τον χρησιμοποιούν απευθείας
+// Οι εντολές δεσμεύουν τη ζωή τους στην εικόνα, ώστε ένα entity να μη στείλει περισσότερα
+// troops από όσα έχει. Ένα instance ανά thread - τίποτα δεν μοιράζεται
+class AIPlanner {
+public:
+    static const int MAX_SEARCH_MOVES;      // Μέγιστες αποστολές που επιλέγει η αναζήτηση σε κάθε απόφαση
+
+    // Δύναμη ανά μονάδα ζωής ενός entity (για το AISnapshot::own_power / opponent_power)
+    static float getPowerFactor(EntityKind kind, int level);
+
+private:
+    static const int SPELL_CAST_CHANCE;     // Πιθανότητα (%) να ρίξει spell ένας έτοιμος Wizard
+
+    Side side;                 // Πλευρά που σχεδιάζει
+    Side opponent;             // Πλευρά που αντιμετωπίζει
+
+    // Στάδια του σχεδίου (ένα entity, ένα κομμάτι της αναζήτησης ή τα spells σε κάθε βήμα)
+    enum class Stage {
+        IDLE,           // Κανένα σχέδιο σε εξέλιξη
+        ENTITIES,       // Αποφάσεις ανά entity
+        SEARCH,         // Αναζήτηση (σε κομμάτια)
+        FINISH          // Spells
+    };
+    Stage stage;
+    size_t next_entity;     // Επόμενο entity της εικόνας
+
+    // Στρατηγικές του AI (οι τέσσερις πρώτες με τη σειρά του AIParams::aggression)
+    enum class AIStrategy {
+        AGGRESSIVE,     // Συνεχείς επιθέσεις
+        DEFENSIVE,      // Άμυνα
+        EXPANSIVE,      // Επέκταση με μετατροπή ουδετέρων
+        MIXED,          // Ισορροπημένη προσέγγιση
+        ADAPTIVE        // Προσαρμοστική (αλλάζει βάσει κατάστασης)
+    };
+
+    AIStrategy strategy; // Τρέχουσα στρατηγική
+    float aggression_level; // Επίπεδο επιθετικότητας (0.0 έως 1.0)
+    AIParams params; // Κατώφλια, επιθετικότητα και βάρη των αποφάσεων
+    std::mt19937 rng; // Τυχαίοι αριθμοί του σχεδιασμού
+    AISnapshot* view; // Εικόνα που επεξεργάζεται ο σχεδιασμός
+    std::vector<AICommand>* plan; // Εντολές του τρέχοντος σχεδιασμού
+    AISearch search; // Αναζήτηση για τις αποστολές troops
+    SimWorld search_world; // Κόσμος της αναζήτησης (δεσμευμένος μία φορά)
+    AIEntityView* search_views[SimWorld::MAX_ENTITIES]; // Εικόνα κάθε θέσης του search_world
+    int search_move; // Αποστολή της αναζήτησης που ψάχνεται τώρα
+    bool search_started; // Αν υπάρχει δέντρο για την search_move
+    float search_spent_ms; // Χρόνος που έχει ήδη δοθεί στην search_move
+    InfluenceMap influence; // Χάρτες επιρροής (ενημερώνονται σε κάθε εικόνα)
+    AIUtility utility; // Πίνακας χρησιμότητας αποστολών (μία φορά ανά απόφαση)
+    std::vector<float> target_values;
+    std::unique_ptr<AIPolicy> policy; // Policy για τις αποστολές troops (nullptr: κανόνες στρατηγικής)
+    AIFeatures features; // Features όλων των ενεργειών της απόφασης (για την policy)
+    std::vector<float> policy_scores;
+
+    // Ίχνος (nullptr: ανενεργό). Ο planner μόνο διαβάζει το ρολόι του και αφήνει τις εγγραφές
+    // στο trace_records - τις μεταφέρει στο ίχνος όποιος τον τρέχει
+    const AITrace* trace;
+    std::vector<AITraceRecord> trace_records;
+    AITraceRecord plan_record;   // PLAN του σχεδιασμού σε εξέλιξη
+    unsigned short plan_serial;
+    float plan_cost_us;          // Χρόνος του σχεδιασμού μέχρι τώρα (σε όλα τα βήματα)
+
+    void finish();   // Spells και τέλος του σχεδίου
+    int roll(int n); // Τυχαίος ακέραιος στο [0, n)
+
+    // Ίχνος του σχεδιασμού (μόνο με trace)
+    void traceCommand(AITraceRecord::Origin origin, float score, float runner_up, int candidates); // Η τελευταία εντολή του plan
+
+    // Λήψη αποφάσεων και ανάλυση
+    void analyzeGameState();
+    void buildUtility();
+    void makeStrategicDecisions();
+    void decideEntity(AIEntityView* entity);
+    void beginSearch();
+    bool stepSearch(float slice_ms);  // Κομμάτι της αναζήτησης (slice_ms < 0: χωρίς όριο) - true στο τέλος
+
+    // Υλοποιήσεις στρατηγικών
+    void executeAggressiveStrategy();
+    void executeDefensiveStrategy();
+    void executeExpansiveStrategy();
+    void executeMixedStrategy();
+    void executeAdaptiveStrategy();
+
+    // Τακτικές ενέργειες
+    void attackWeakestPlayerTarget(AIEntityView* attacker);
+    void attackStrategicTarget(AIEntityView* attacker);
+    void convertNearestNeutral(AIEntityView* converter);
+    bool sendBest(AIEntityView* attacker, bool opponent_targets, bool threatening_only);
+    void sendByPolicy(AIEntityView* attacker);
+    void sendChosen(AIEntityView* attacker, int source, int target_index, int option);
+    void sendTroops(AIEntityView* from, const AIEntityView* to, int amount);
+    void upgrade(AIEntityView* entity);
+
+    // Ρίψη spells από Wizards
+    void castEnemySpells();
+    void castSmartSpell(AIEntityView* wizard);
+    float evaluateSpellValue(int spell_id, const AIEntityView* target);
+    bool isThreatening(const AIEntityView* entity);
+
+    // Βοηθητικές συναρτήσεις
+    AIEntityView* findMostThreateningPlayerEntity();
+
+public:
+    AIPlanner(Side controlled = Side::ENEMY, Side opposing = Side::PLAYER); // Constructor
+
+    Side getSide() const { return side; }
+    Side getOpponent() const { return opponent; }
+
+    // Ολόκληρος ο σχεδιασμός μιας εικόνας (η αναζήτηση παίρνει όλο το search_budget_ms της)
+    void planSnapshot(AISnapshot& snapshot, std::vector<AICommand>& out);
+
+    // Σχεδιασμός σε βήματα: begin και μετά step μέχρι να επιστρέψει true. Κάθε step είναι η
+    // απόφαση ενός entity, ένα κομμάτι της αναζήτησης μέχρι slice_ms (< 0: ολόκληρη η
+    // τρέχουσα αναζήτηση) ή τα spells. Οι εντολές είναι ίδιες όπως κι αν μοιραστούν τα βήματα
+    // (εκτός από την αναζήτηση, που είναι anytime). Η εικόνα και το out μένουν ως το τέλος
+    void begin(AISnapshot& snapshot, std::vector<AICommand>& out);
+    bool step(float slice_ms);
+    bool isPlanning() const { return stage != Stage::IDLE; }
+
+    // Αρχική στρατηγική (νέος αγώνας)
+    void reset();
+
+    // Policy για τις αποστολές troops (nullptr: οι κανόνες της στρατηγικής). Χρησιμοποιείται
+    // όταν η εικόνα δεν έχει budget αναζήτησης
+    void setPolicy(std::unique_ptr<AIPolicy> new_policy) { policy = std::move(new_policy); }
+    const AIPolicy* getPolicy() const { return policy.get(); }
+
+    // Παράμετροι των αποφάσεων (π.χ. από αρχείο του tuner). Ορίζουν και την policy: LinearPolicy
+    // με τα βάρη τους αν έχουν use_policy, αλλιώς οι κανόνες της στρατηγικής
+    void setParams(const AIParams& new_params);
+    const AIParams& getParams() const { return params; }
+
+    void seed(unsigned int s); // Ντετερμινιστικός σχεδιασμός (rng και αναζήτηση)
+
+    // Ίχνος αποφάσεων: PLAN και μία εγγραφή ανά εντολή στο getTraceRecords (nullptr: ανενεργό)
+    void setTrace(const AITrace* new_trace) { trace = new_trace; }
+    std::vector<AITraceRecord>& getTraceRecords() { return trace_records; }
+};
@@ -0,0 +1,116 @@
+﻿#include "ai_policy.h"
+#include "ai_planner.h"
+#include "simd.h"
+#include <algorithm>
+#include <cmath>
+
+const int LinearPolicy::WEIGHT_COUNT;
+
+// Σειρά όπως το AIFeatures::Feature
+const float LinearPolicy::DEFAULT_WEIGHTS[WEIGHT_COUNT] = {
+    -0.2f,   // BIAS
+    0.6f,    // SOURCE_HEALTH
+    0.0f,    // SOURCE_LEVEL
+    -1.0f,   // TARGET_HEALTH
+    -0.1f,   // TARGET_LEVEL
+    0.2f,    // TARGET_OPPONENT
+    0.0f,    // TARGET_BABY
+    0.1f,    // TARGET_WARRIOR
+    0.3f,    // TARGET_TOWER
+    0.3f,    // TARGET_WIZARD
+    -0.5f,   // DISTANCE
+    -0.3f,   // PATH_TIME
+    -1.0f,   // ROUTE_LOSS
+    0.8f     // HEALTH_MARGIN
+};
+
+static const float CANVAS_WIDTH = 16.0f;
+
+// Γέμισμα των γραμμών feature ανά ενέργεια
+void AIFeatures::extract(const AISnapshot& snapshot) {
+    source_count = (int)snapshot.own.size();
+    int opponent_count = (int)snapshot.opponents.size();
+    target_count = opponent_count + (int)snapshot.neutral.size();
+    action_count = source_count * target_count;
+    stride = (action_count + 3) & ~3;
+
+    values.assign(FEATURE_COUNT * stride, 0.0f);
+    valid.assign(action_count, 0);
+    if (action_count == 0 || (int)snapshot.routes.size() < action_count) return;
+
+    float* bias = &values[BIAS * stride];
+    float* source_health = &values[SOURCE_HEALTH * stride];
+    float* source_level = &values[SOURCE_LEVEL * stride];
+    float* target_health = &values[TARGET_HEALTH * stride];
+    float* target_level = &values[TARGET_LEVEL * stride];
+    float* target_opponent = &values[TARGET_OPPONENT * stride];
+    float* distance = &values[DISTANCE * stride];
+    float* path_time = &values[PATH_TIME * stride];
+    float* route_loss = &values[ROUTE_LOSS * stride];
+    float* margin = &values[HEALTH_MARGIN * stride];
+
+    for (int i = 0; i < source_count; i++) {
+        const AIEntityView& source = snapshot.own[i];
+        for (int j = 0; j < target_count; j++) {
+            bool opponent = j < opponent_count;
+            const AIEntityView& target = opponent ? snapshot.opponents[j] : snapshot.neutral[j - opponent_count];
+            const AIRoute& route = snapshot.routes[i * target_count + j];
+            int a = i * target_count + j;
+
+            float dx = target.x - source.x;
+            float dy = target.y - source.y;
+
+            bias[a] = 1.0f;
+            source_health[a] = source.health / 100.0f;
+            source_level[a] = source.level / 5.0f;
+            target_health[a] = target.projected_health / 100.0f;
+            target_level[a] = target.level / 5.0f;
+            target_opponent[a] = opponent ? 1.0f : 0.0f;
+            values[(TARGET_BABY + kindIndex(target.kind)) * stride + a] = 1.0f;
+            distance[a] = std::sqrt(dx * dx + dy * dy) / CANVAS_WIDTH;
+            path_time[a] = std::max(0.0f, route.travel) / 10.0f;
+            route_loss[a] = route.loss / 100.0f;
+            margin[a] = (source.health - target.projected_health) / 100.0f;
+            valid[a] = route.travel >= 0.0f ? 1 : 0;
+        }
+    }
+}
+
+// Constructors
+LinearPolicy::LinearPolicy() {
+    setWeights(DEFAULT_WEIGHTS);
+}
+
+LinearPolicy::LinearPolicy(const float* initial_weights) {
+    setWeights(initial_weights);
+}
+
+void LinearPolicy::setWeights(const float* new_weights) {
+    std::copy(new_weights, new_weights + WEIGHT_COUNT, weights);
+}
+
+// Βαθμολογίες όλων των ενεργειών (οι γραμμές των features είναι συνεχείς, άρα 4 ενέργειες ανά πρόσθεση)
+void LinearPolicy::score(const AIFeatures& features, float* scores) const {
+    int stride = features.stride;
+    int a = 0;
+
+#ifdef USE_SSE
+    for (; a < stride; a += 4) {
+        __m128 acc = _mm_setzero_ps();
+        for (int f = 0; f < WEIGHT_COUNT; f++) {
+            __m128 x = _mm_loadu_ps(&features.values[f * stride + a]);
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_set1_ps(weights[f]), x));
+        }
+        _mm_storeu_ps(scores + a, acc);
+    }
+#endif
+
+    // Υπόλοιπα (ή όλα, χωρίς SSE)
+    for (; a < stride; a++) {
+        float acc = 0.0f;
+        for (int f = 0; f < WEIGHT_COUNT; f++) {
+            acc += weights[f] * features.values[f * stride + a];
+        }
+        scores[a] = acc;
+    }
+}
@@ -0,0 +1,79 @@
+﻿#pragma once
+#include <vector>
+
+struct AISnapshot;
+
+// Χαρακτηριστικά (features) όλων των υποψήφιων αποστολών μιας απόφασης, σε σταθερή διάταξη
+// Κάθε ενέργεια είναι ένα ζεύγος (entity της πλευράς του AI, στόχος), με τους στόχους με τη
+// σειρά του πίνακα χρησιμότητας (πρώτα του αντιπάλου, μετά τα ουδέτερα): ενέργεια
+// source * target_count + target. Οι τιμές είναι ανά feature σε συνεχείς γραμμές μήκους
+// stride (πολλαπλάσιο του 4), ώστε μια policy να υπολογίζει 4 ενέργειες ανά εντολή SSE
+// Όλες οι τιμές είναι κανονικοποιημένες σε περίπου [0, 1], ώστε τα βάρη να είναι συγκρίσιμα
+struct AIFeatures {
+    enum Feature {
+        BIAS,               // Πάντα 1
+        SOURCE_HEALTH,      // Ζωή της πηγής / 100
+        SOURCE_LEVEL,       // Level της πηγής / 5
+        TARGET_HEALTH,      // Ζωή του στόχου μετά τα troops που ήδη ταξιδεύουν / 100
+        TARGET_LEVEL,
+        TARGET_OPPONENT,    // 1: στόχος του αντιπάλου, 0: ουδέτερος
+        TARGET_BABY,        // Είδος του στόχου (one-hot)
+        TARGET_WARRIOR,
+        TARGET_TOWER,
+        TARGET_WIZARD,
+        DISTANCE,           // Ευθεία απόσταση / πλάτος του καμβά
+        PATH_TIME,          // Χρόνος διαδρομής στο μονοπάτι / 10 δευτερόλεπτα
+        ROUTE_LOSS,         // Αναμενόμενη ζημιά από πύργους / 100
+        HEALTH_MARGIN,      // (ζωή πηγής - ζωή στόχου) / 100
+        FEATURE_COUNT
+    };
+
+    int source_count = 0;
+    int target_count = 0;
+    int action_count = 0;
+    int stride = 0;                  // action_count στρογγυλεμένο στο 4
+
+    std::vector<float> values;       // [feature * stride + action] (0 στο padding)
+    std::vector<unsigned char> valid; // [action] 0 αν δεν υπάρχει μονοπάτι
+
+    // Εξαγωγή όλων των ενεργειών από εικόνα απόφασης με διαδρομές (ένα πέρασμα)
+    void extract(const AISnapshot& snapshot);
+
+    const float* row(Feature feature) const { return &values[feature * stride]; }
+};
+
+// Policy του AI: βαθμολογεί όλες τις ενέργειες μιας απόφασης μαζί
+// Το AISystem επιλέγει για κάθε entity την ενέργεια με τη μεγαλύτερη θετική βαθμολογία
+// (οι ποσότητες έρχονται από τον πίνακα χρησιμότητας), οπότε μια νέα ή ρυθμισμένη policy
+// αλλάζει το παιχνίδι του AI χωρίς αλλαγές στο AISystem
+// Καλείται από το thread του σχεδιασμού - δεν πρέπει να διαβάζει κοινή κατάσταση
+class AIPolicy {
+public:
+    virtual ~AIPolicy() {}
+
+    // scores: features.stride θέσεις (οι θέσεις του padding αγνοούνται)
+    virtual void score(const AIFeatures& features, float* scores) const = 0;
+    virtual const char* getName() const = 0;
+};
+
+// Γραμμική policy: βαθμολογία = Σ βάρος * feature, 4 ενέργειες ανά εντολή SSE
+class LinearPolicy : public AIPolicy {
+public:
+    static const int WEIGHT_COUNT = AIFeatures::FEATURE_COUNT;
+
+private:
+    static const float DEFAULT_WEIGHTS[WEIGHT_COUNT];  // Χειροκίνητα βάρη (κοντά στους κανόνες του AI)
+
+    float weights[WEIGHT_COUNT];
+
+public:
+    LinearPolicy();
+    explicit LinearPolicy(const float* initial_weights);
+
+    void score(const AIFeatures& features, float* scores) const override;
+    const char* getName() const override { return "linear"; }
+
+    void setWeights(const float* new_weights);
+    const float* getWeights() const { return weights; }
+    static const float* getDefaultWeights() { return DEFAULT_WEIGHTS; }
+};
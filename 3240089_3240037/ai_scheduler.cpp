@@ -0,0 +1,35 @@
+﻿#include "ai_scheduler.h"
+#include <algorithm>
+
+const float AIScheduler::DEFAULT_BUDGET_US = 500.0f;
+
+// Constructor
+AIScheduler::AIScheduler()
+    : tick_start(Clock::now()), budget_us(DEFAULT_BUDGET_US), ticks(0), spilled_ticks(0), spilled(false) {}
+
+void AIScheduler::beginTick() {
+    tick_start = Clock::now();
+    ticks++;
+    spilled = false;
+}
+
+bool AIScheduler::hasTime() const {
+    if (budget_us <= 0.0f) return true;
+    return getElapsedUs() < budget_us;
+}
+
+// Μετράται μία φορά ανά tick
+void AIScheduler::markSpilled() {
+    if (spilled) return;
+    spilled = true;
+    spilled_ticks++;
+}
+
+float AIScheduler::getElapsedUs() const {
+    return std::chrono::duration<float, std::micro>(Clock::now() - tick_start).count();
+}
+
+float AIScheduler::getRemainingUs() const {
+    if (budget_us <= 0.0f) return 0.0f;
+    return std::max(0.0f, budget_us - getElapsedUs());
+}
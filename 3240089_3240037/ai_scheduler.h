@@ -0,0 +1,44 @@
+﻿#pragma once
+#include <chrono>
+
+// Χρονικό όριο (budget) της δουλειάς του AI σε κάθε tick του main thread
+// Η δουλειά του AI στο main thread (εφαρμογή εντολών, σύγχρονος σχεδιασμός ανά entity)
+// γίνεται σε μικρά βήματα και μετά από κάθε βήμα ελέγχεται αν έμεινε χρόνος στο tick.
+// Ό,τι δεν χωρά συνεχίζει στο επόμενο tick, οπότε ένα σχέδιο με πολλά entities μοιράζεται
+// σε λίγα frames αντί να προκαλεί μία αιχμή. Το πρώτο βήμα κάθε tick γίνεται πάντα, ώστε
+// η δουλειά να προχωρά ακόμα και σε πολύ αργό μηχάνημα
+// Το πότε παίρνονται οι αποφάσεις ορίζεται από τα χρονόμετρα του TimerWheel (χρόνος
+// προσομοίωσης), άρα δεν εξαρτάται από τα FPS - το budget αλλάζει μόνο το πόσο γρήγορα
+// εφαρμόζεται ένα σχέδιο που έχει ήδη αποφασιστεί
+class AIScheduler {
+public:
+    static const float DEFAULT_BUDGET_US;   // Μικροδευτερόλεπτα ανά tick
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point tick_start;
+    float budget_us;                         // 0: χωρίς όριο (όλη η δουλειά στο ίδιο tick)
+    long long ticks;                         // Ticks από τη δημιουργία
+    long long spilled_ticks;                 // Ticks που η δουλειά συνέχισε στο επόμενο
+    bool spilled;
+
+public:
+    AIScheduler();
+
+    // Αρχή της δουλειάς του AI σε ένα tick
+    void beginTick();
+
+    // Αν μένει χρόνος για ένα ακόμα βήμα
+    bool hasTime() const;
+
+    // Η δουλειά που έμεινε συνεχίζει στο επόμενο tick (για μετρήσεις)
+    void markSpilled();
+
+    float getElapsedUs() const;
+    float getRemainingUs() const;            // Χρόνος που μένει στο tick (0 αν εξαντλήθηκε ή χωρίς όριο)
+    void setBudget(float us) { budget_us = us; }
+    float getBudget() const { return budget_us; }
+    long long getTicks() const { return ticks; }
+    long long getSpilledTicks() const { return spilled_ticks; }
+};
@@ -0,0 +1,459 @@
+﻿#include "ai_search.h"
+#include "ai_planner.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <chrono>
+
+const int SimWorld::MAX_ENTITIES;
+const int SimWorld::MAX_TROOPS;
+
+const float AISearch::PLY_SECONDS = 1.0f;
+const int AISearch::ROLLOUT_PLIES = 6;
+const int AISearch::MAX_DEPTH = 6;
+const int AISearch::MAX_NODES = 100000;
+const float AISearch::EXPLORATION = 0.7f;
+
+// Απόσταση διαδοχικών waypoints στα μονοπάτια του γράφου (η ταχύτητα των troops μετριέται σε waypoints)
+static const float WAYPOINT_SPACING = 0.2f;
+// Βήμα προσομοίωσης μέσα σε ένα step (αφίξεις και βολές πύργων)
+static const float SUBSTEP_SECONDS = 0.25f;
+// Βάρος κάθε entity στην αξιολόγηση (σε μονάδες ζωής)
+static const float ENTITY_SCORE_WEIGHT = 15.0f;
+
+// Δημιουργία από εικόνα
+void SimWorld::build(const AISnapshot& snapshot) {
+    entity_count = 0;
+    troop_count = 0;
+
+    const std::vector<AIEntityView>* groups[3] = { &snapshot.opponents, &snapshot.own, &snapshot.neutral };
+    for (const std::vector<AIEntityView>* group : groups) {
+        for (const AIEntityView& view : *group) {
+            if (entity_count >= MAX_ENTITIES) break;
+            int i = entity_count++;
+
+            side[i] = view.side;
+            tower[i] = view.kind == EntityKind::TOWER;
+            health[i] = (float)view.health;
+            max_health[i] = (float)view.max_health;
+            healing_speed[i] = view.healing_speed;
+            defense[i] = view.defense;
+            troop_speed[i] = view.attacking_speed * 0.2f * WAYPOINT_SPACING;
+            tower_dps[i] = (tower[i] && view.attack_interval > 0.0f) ? view.tower_damage / view.attack_interval : 0.0f;
+            tower_radius[i] = view.attack_radius;
+            x[i] = view.x;
+            y[i] = view.y;
+        }
+    }
+
+    // Troops σε κίνηση: ο στόχος αντιστοιχίζεται στη θέση του στον κόσμο
+    for (const AITroopView& troop : snapshot.troops) {
+        if (troop_count >= MAX_TROOPS) break;
+
+        int target = -1;
+        int index = 0;
+        for (const std::vector<AIEntityView>* group : groups) {
+            for (const AIEntityView& view : *group) {
+                if (index >= entity_count) break;
+                if (view.handle == troop.target) target = index;
+                index++;
+            }
+        }
+        if (target < 0) continue;
+
+        int t = troop_count++;
+        troop_target[t] = target;
+        troop_side[t] = troop.side;
+        troop_amount[t] = (float)troop.amount;
+        troop_x[t] = troop.x;
+        troop_y[t] = troop.y;
+        troop_eta[t] = std::max(troop.eta, 0.01f);
+        troop_total[t] = troop_eta[t];
+    }
+}
+
+// Ποσότητα αποστολής (ίδιοι κανόνες με το AISystem, με το ανώτερο όριο του 60%)
+int SimWorld::sendAmount(int from) const {
+    int h = (int)health[from];
+    int amount = std::min(100, (int)(h * 0.6f));
+    if (amount < 5) return 0;
+
+    // Αφήνουμε τουλάχιστον 10 ζωή
+    if (h <= amount + 10) {
+        amount = h - 10;
+        if (amount < 5) return 0;
+    }
+    return amount;
+}
+
+// Αποστολή troop σε ευθεία γραμμή
+void SimWorld::send(int from, int to) {
+    send(from, to, sendAmount(from));
+}
+
+void SimWorld::send(int from, int to, int amount) {
+    if (amount <= 0 || troop_count >= MAX_TROOPS || troop_speed[from] <= 0.0f) return;
+
+    float dx = x[to] - x[from];
+    float dy = y[to] - y[from];
+    float travel = std::sqrt(dx * dx + dy * dy) / troop_speed[from];
+
+    health[from] -= amount;
+
+    int t = troop_count++;
+    troop_target[t] = to;
+    troop_side[t] = side[from];
+    troop_amount[t] = (float)amount;
+    troop_x[t] = x[from];
+    troop_y[t] = y[from];
+    troop_eta[t] = std::max(travel, 0.01f);
+    troop_total[t] = troop_eta[t];
+}
+
+// Αφίξεις με τους κανόνες της step, χωρίς healing και βολές πύργων στο μεταξύ
+void SimWorld::project(int target, Side& out_side, float& out_health) const {
+    out_side = side[target];
+    out_health = health[target];
+
+    // Troops προς τον στόχο σε σειρά άφιξης (λίγα, οπότε αρκεί ταξινόμηση με εισαγωγή)
+    int incoming[MAX_TROOPS];
+    int count = 0;
+    for (int t = 0; t < troop_count; t++) {
+        if (troop_target[t] != target || troop_amount[t] <= 0.0f) continue;
+        int i = count++;
+        while (i > 0 && troop_eta[incoming[i - 1]] > troop_eta[t]) {
+            incoming[i] = incoming[i - 1];
+            i--;
+        }
+        incoming[i] = t;
+    }
+
+    for (int i = 0; i < count; i++) {
+        int t = incoming[i];
+        float amount = std::floor(troop_amount[t]);
+        if (out_side == troop_side[t]) {
+            out_health += amount;
+        }
+        else {
+            out_health -= std::max(1.0f, amount - defense[target]);
+            if (out_health < 0.0f) {
+                out_side = troop_side[t];
+                out_health = -out_health;
+            }
+        }
+    }
+}
+
+// Προώθηση σε υποβήματα
+void SimWorld::step(float seconds) {
+    while (seconds > 0.0f) {
+        float dt = std::min(seconds, SUBSTEP_SECONDS);
+        seconds -= dt;
+
+        // Healing μέχρι το μέγιστο (όχι για NEUTRAL) και μείωση πάνω από το μέγιστο
+        for (int i = 0; i < entity_count; i++) {
+            if (side[i] != Side::NEUTRAL && health[i] < max_health[i] && healing_speed[i] > 0.0f) {
+                health[i] = std::min(max_health[i], health[i] + healing_speed[i] * dt);
+            }
+            else if (health[i] > max_health[i]) {
+                health[i] = std::max(max_health[i], health[i] - dt);
+            }
+        }
+
+        // Βολές πύργων στο κοντινότερο troop άλλης πλευράς μέσα στην ακτίνα
+        for (int i = 0; i < entity_count; i++) {
+            if (tower_dps[i] <= 0.0f) continue;
+
+            int closest = -1;
+            float closest_dist_sq = tower_radius[i] * tower_radius[i];
+            for (int t = 0; t < troop_count; t++) {
+                if (troop_side[t] == side[i]) continue;
+
+                float f = troop_eta[t] / troop_total[t];
+                int target = troop_target[t];
+                float px = x[target] + (troop_x[t] - x[target]) * f;
+                float py = y[target] + (troop_y[t] - y[target]) * f;
+                float dx = px - x[i];
+                float dy = py - y[i];
+                float dist_sq = dx * dx + dy * dy;
+                if (dist_sq <= closest_dist_sq) {
+                    closest_dist_sq = dist_sq;
+                    closest = t;
+                }
+            }
+            if (closest >= 0) troop_amount[closest] -= tower_dps[i] * dt;
+        }
+
+        // Κίνηση και αφίξεις (ίδιοι κανόνες με το GlobalState::handleTroopArrivals)
+        int kept = 0;
+        for (int t = 0; t < troop_count; t++) {
+            if (troop_amount[t] <= 0.0f) continue;  // Νεκρό troop
+
+            troop_eta[t] -= dt;
+            if (troop_eta[t] > 0.0f) {
+                if (kept != t) {
+                    troop_target[kept] = troop_target[t];
+                    troop_side[kept] = troop_side[t];
+                    troop_amount[kept] = troop_amount[t];
+                    troop_x[kept] = troop_x[t];
+                    troop_y[kept] = troop_y[t];
+                    troop_eta[kept] = troop_eta[t];
+                    troop_total[kept] = troop_total[t];
+                }
+                kept++;
+                continue;
+            }
+
+            int target = troop_target[t];
+            float amount = std::floor(troop_amount[t]);
+            if (side[target] == troop_side[t]) {
+                health[target] += amount;
+            }
+            else {
+                health[target] -= std::max(1.0f, amount - defense[target]);
+                if (health[target] < 0.0f) {
+                    side[target] = troop_side[t];
+                    health[target] = -health[target];
+                }
+            }
+        }
+        troop_count = kept;
+    }
+}
+
+// Αξιολόγηση: μερίδιο της πλευράς me στη ζωή (και στα troops της) και στα entities
+float SimWorld::score(Side me) const {
+    Side opponent = (me == Side::ENEMY) ? Side::PLAYER : Side::ENEMY;
+    float mine = 0.0f;
+    float theirs = 0.0f;
+
+    for (int i = 0; i < entity_count; i++) {
+        if (side[i] == me) mine += health[i] + ENTITY_SCORE_WEIGHT;
+        else if (side[i] == opponent) theirs += health[i] + ENTITY_SCORE_WEIGHT;
+    }
+    for (int t = 0; t < troop_count; t++) {
+        if (troop_side[t] == me) mine += troop_amount[t];
+        else if (troop_side[t] == opponent) theirs += troop_amount[t];
+    }
+
+    float total = mine + theirs;
+    return total > 0.0f ? mine / total : 0.5f;
+}
+
+// Constructor (ο χώρος των κόμβων δεσμεύεται μία φορά)
+AISearch::AISearch() : rng_state(2463534242u), rollouts(0), root_side(Side::ENEMY) {
+    nodes.reserve(MAX_NODES);
+}
+
+unsigned int AISearch::nextRandom() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Υποψήφιες κινήσεις: καμία, και για κάθε entity που μπορεί να στείλει troops
+// το κοντινότερο ουδέτερο, τον κοντινότερο και τον πιο αδύναμο αντίπαλο
+int AISearch::generateActions(const SimWorld& world, Side side, SimAction* out) const {
+    int count = 0;
+    out[count++] = SimAction();
+
+    for (int from = 0; from < world.entity_count; from++) {
+        if (world.side[from] != side || world.sendAmount(from) <= 0) continue;
+
+        int nearest_neutral = -1, nearest_hostile = -1, weakest_hostile = -1;
+        float neutral_dist = FLT_MAX, hostile_dist = FLT_MAX, weakest_health = FLT_MAX;
+
+        for (int to = 0; to < world.entity_count; to++) {
+            if (world.side[to] == side) continue;
+
+            float dx = world.x[to] - world.x[from];
+            float dy = world.y[to] - world.y[from];
+            float dist = dx * dx + dy * dy;
+
+            if (world.side[to] == Side::NEUTRAL) {
+                if (dist < neutral_dist) { neutral_dist = dist; nearest_neutral = to; }
+            }
+            else {
+                if (dist < hostile_dist) { hostile_dist = dist; nearest_hostile = to; }
+                if (world.health[to] < weakest_health) { weakest_health = world.health[to]; weakest_hostile = to; }
+            }
+        }
+
+        int targets[3] = { nearest_neutral, nearest_hostile, weakest_hostile };
+        for (int k = 0; k < 3; k++) {
+            if (targets[k] < 0) continue;
+            if (k == 2 && targets[2] == targets[1]) continue;
+
+            out[count].from = from;
+            out[count].to = targets[k];
+            count++;
+        }
+    }
+    return count;
+}
+
+// Τυχαία κίνηση για τα rollouts (μισές φορές καμία)
+void AISearch::randomAction(SimWorld& world, Side side) {
+    if (world.entity_count < 2 || (nextRandom() & 1u)) return;
+
+    for (int attempt = 0; attempt < 4; attempt++) {
+        int from = (int)(nextRandom() % (unsigned int)world.entity_count);
+        if (world.side[from] != side || world.sendAmount(from) <= 0) continue;
+
+        int to = (int)(nextRandom() % (unsigned int)world.entity_count);
+        if (world.side[to] == side) continue;
+
+        world.send(from, to);
+        return;
+    }
+}
+
+void AISearch::apply(SimWorld& world, const SimAction& action) const {
+    if (action.from >= 0) world.send(action.from, action.to);
+}
+
+// Επιλογή παιδιού με UCT. Οι τιμές είναι από τη σκοπιά της ρίζας· σε περιττό βάθος
+// παίζει ο αντίπαλος, οπότε διαλέγει ό,τι είναι χειρότερο για αυτήν
+int AISearch::select(int node) const {
+    const Node& parent = nodes[node];
+    bool my_move = (parent.depth % 2) == 0;
+    float log_visits = std::log((float)std::max(1, parent.visits));
+
+    int best = parent.first_child;
+    float best_value = -FLT_MAX;
+    for (int c = parent.first_child; c < parent.first_child + parent.child_count; c++) {
+        const Node& child = nodes[c];
+        if (child.visits == 0) return c;
+
+        float q = child.value / child.visits;
+        if (!my_move) q = 1.0f - q;
+        float ucb = q + EXPLORATION * std::sqrt(log_visits / child.visits);
+        if (ucb > best_value) {
+            best_value = ucb;
+            best = c;
+        }
+    }
+    return best;
+}
+
+// Ανάπτυξη κόμβου με όλες τις υποψήφιες κινήσεις της πλευράς mover
+void AISearch::expand(int node, const SimWorld& world, Side mover) {
+    int count = generateActions(world, mover, actions);
+
+    int first = (int)nodes.size();
+    for (int i = 0; i < count; i++) {
+        Node child;
+        child.action = actions[i];
+        child.parent = node;
+        child.first_child = -1;
+        child.child_count = 0;
+        child.depth = nodes[node].depth + 1;
+        child.visits = 0;
+        child.value = 0.0f;
+        nodes.push_back(child);
+    }
+    nodes[node].first_child = first;
+    nodes[node].child_count = count;
+}
+
+// Αναζήτηση με όριο χρόνου
+SimAction AISearch::findMove(const SimWorld& root, Side me, float budget_ms) {
+    if (!begin(root, me)) return SimAction();  // Μόνο η "καμία κίνηση"
+    iterate(root, budget_ms);
+    return bestMove();
+}
+
+// Νέο δέντρο με ρίζα τον κόσμο root
+bool AISearch::begin(const SimWorld& root, Side me) {
+    root_side = me;
+    last_stats = SearchStats();
+    nodes.clear();
+    Node root_node;
+    root_node.parent = -1;
+    root_node.first_child = -1;
+    root_node.child_count = 0;
+    root_node.depth = 0;
+    root_node.visits = 0;
+    root_node.value = 0.0f;
+    nodes.push_back(root_node);
+
+    expand(0, root, me);
+    return nodes[0].child_count > 1;
+}
+
+// Επαναλήψεις του UCT μέχρι να περάσουν budget_ms (το δέντρο μένει για την επόμενη κλήση)
+void AISearch::iterate(const SimWorld& root, float budget_ms) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point deadline = Clock::now() +
+        std::chrono::microseconds((long long)(budget_ms * 1000.0f));
+    Side me = root_side;
+    Side opponent = (me == Side::ENEMY) ? Side::PLAYER : Side::ENEMY;
+
+    for (int iteration = 0; ; iteration++) {
+        // Έλεγχος χρόνου ανά 8 επαναλήψεις (η ανάγνωση του ρολογιού δεν είναι δωρεάν)
+        if ((iteration & 7) == 0 && Clock::now() >= deadline) break;
+
+        SimWorld world = root;
+        int node = 0;
+
+        // Επιλογή: κάθε ζευγάρι κινήσεων ακολουθείται από ένα βήμα προσομοίωσης
+        while (nodes[node].child_count > 0) {
+            node = select(node);
+            apply(world, nodes[node].action);
+            if (nodes[node].depth % 2 == 0) world.step(PLY_SECONDS);
+        }
+
+        // Ανάπτυξη μετά την πρώτη επίσκεψη (αν υπάρχει χώρος για όλα τα παιδιά)
+        if (nodes[node].visits > 0 && nodes[node].depth < MAX_DEPTH &&
+            (int)nodes.size() + MAX_ACTIONS <= MAX_NODES) {
+            Side mover = (nodes[node].depth % 2 == 0) ? me : opponent;
+            expand(node, world, mover);
+            if (nodes[node].child_count > 0) {
+                node = nodes[node].first_child + (int)(nextRandom() % (unsigned int)nodes[node].child_count);
+                apply(world, nodes[node].action);
+                if (nodes[node].depth % 2 == 0) world.step(PLY_SECONDS);
+            }
+        }
+
+        // Rollout με τυχαίες κινήσεις (ο αντίπαλος ολοκληρώνει πρώτα το ζευγάρι αν είναι η σειρά του)
+        if (nodes[node].depth % 2 == 1) {
+            randomAction(world, opponent);
+            world.step(PLY_SECONDS);
+        }
+        for (int ply = 0; ply < ROLLOUT_PLIES; ply++) {
+            randomAction(world, me);
+            randomAction(world, opponent);
+            world.step(PLY_SECONDS);
+        }
+        float value = world.score(me);
+        rollouts++;
+
+        // Ενημέρωση της διαδρομής μέχρι τη ρίζα
+        for (int n = node; n >= 0; n = nodes[n].parent) {
+            nodes[n].visits++;
+            nodes[n].value += value;
+        }
+    }
+}
+
+// Η πιο δοκιμασμένη κίνηση της ρίζας (και η δεύτερη για τα στατιστικά)
+SimAction AISearch::bestMove() {
+    int best = nodes[0].first_child;
+    int second = -1;
+    for (int c = nodes[0].first_child + 1; c < nodes[0].first_child + nodes[0].child_count; c++) {
+        if (nodes[c].visits > nodes[best].visits) {
+            second = best;
+            best = c;
+        }
+        else if (second < 0 || nodes[c].visits > nodes[second].visits) {
+            second = c;
+        }
+    }
+
+    last_stats.candidates = nodes[0].child_count;
+    last_stats.visits = nodes[best].visits;
+    last_stats.value = nodes[best].visits > 0 ? nodes[best].value / nodes[best].visits : 0.0f;
+    last_stats.runner_up = (second >= 0 && nodes[second].visits > 0) ? nodes[second].value / nodes[second].visits : 0.0f;
+    return nodes[best].action;
+}
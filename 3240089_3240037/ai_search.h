@@ -0,0 +1,127 @@
+﻿#pragma once
+#include "entity.h"
+#include <vector>
+
+struct AISnapshot;
+
+// Απλοποιημένος κόσμος για την αναζήτηση του AI (headless, χωρίς γραφικά και singletons)
+// Κρατά μόνο ό,τι επηρεάζει το αποτέλεσμα μιας αποστολής troops: ζωή, healing, άμυνα,
+// πλευρά, θέση, ταχύτητα troops και βολές πύργων. Όλα τα δεδομένα είναι σε πίνακες
+// σταθερού μεγέθους, οπότε η αντιγραφή ενός κόσμου είναι μία απλή αντιγραφή struct
+// Τα troops κινούνται σε ευθεία προς τον στόχο (το πραγματικό μονοπάτι απέχει λίγο από αυτήν)
+struct SimWorld {
+    static const int MAX_ENTITIES = 64;
+    static const int MAX_TROOPS = 128;
+
+    int entity_count;
+    int troop_count;
+
+    // Entities (ίδια σειρά με την εικόνα: αντίπαλοι, πλευρά του AI, ουδέτερα)
+    Side side[MAX_ENTITIES];
+    bool tower[MAX_ENTITIES];
+    float health[MAX_ENTITIES];
+    float max_health[MAX_ENTITIES];
+    float healing_speed[MAX_ENTITIES];
+    float defense[MAX_ENTITIES];
+    float troop_speed[MAX_ENTITIES];   // Μονάδες καμβά ανά δευτερόλεπτο
+    float tower_dps[MAX_ENTITIES];     // Ζημιά ανά δευτερόλεπτο (0 αν δεν είναι πύργος)
+    float tower_radius[MAX_ENTITIES];
+    float x[MAX_ENTITIES], y[MAX_ENTITIES];
+
+    // Troops σε κίνηση
+    int troop_target[MAX_TROOPS];
+    Side troop_side[MAX_TROOPS];
+    float troop_amount[MAX_TROOPS];
+    float troop_x[MAX_TROOPS], troop_y[MAX_TROOPS];  // Θέση τη στιγμή της αποστολής
+    float troop_eta[MAX_TROOPS];                     // Χρόνος μέχρι την άφιξη
+    float troop_total[MAX_TROOPS];                   // Συνολικός χρόνος διαδρομής
+
+    // Δημιουργία από εικόνα του AI (τα entities πέρα από το MAX_ENTITIES αγνοούνται)
+    void build(const AISnapshot& snapshot);
+
+    // Ποσότητα που θα έστελνε το entity (60% της ζωής, έως 100, αφήνοντας 10) - 0 αν δεν μπορεί
+    int sendAmount(int from) const;
+    void send(int from, int to);
+    void send(int from, int to, int amount);  // Συγκεκριμένη ποσότητα (χωρίς έλεγχο της ζωής που μένει)
+
+    // Πλευρά και ζωή του entity μετά τα troops που ήδη ταξιδεύουν προς αυτό (σειρά άφιξης)
+    void project(int target, Side& out_side, float& out_health) const;
+
+    // Προώθηση κατά seconds (healing, κίνηση troops, βολές πύργων, αφίξεις)
+    void step(float seconds);
+
+    // Αξιολόγηση για την πλευρά me στο [0, 1] (μερίδιο ζωής και entities, μαζί με τα troops)
+    float score(Side me) const;
+};
+
+// Ενέργεια της αναζήτησης
+struct SimAction {
+    int from = -1;   // -1: καμία ενέργεια
+    int to = -1;
+};
+
+// Στατιστικά της ρίζας στην τελευταία αναζήτηση (για το ίχνος αποφάσεων)
+struct SearchStats {
+    int candidates = 0;        // Κινήσεις της ρίζας (μαζί με την "καμία κίνηση")
+    int visits = 0;            // Επισκέψεις της κίνησης που επιλέχθηκε
+    float value = 0.0f;        // Μέση αξιολόγηση της κίνησης που επιλέχθηκε
+    float runner_up = 0.0f;    // Μέση αξιολόγηση της δεύτερης πιο δοκιμασμένης
+};
+
+// Αναζήτηση Monte Carlo (UCT) πάνω στον SimWorld
+// Τα επίπεδα του δέντρου εναλλάσσονται ανάμεσα στις δύο πλευρές και κάθε ζευγάρι κινήσεων
+// ακολουθείται από PLY_SECONDS προσομοίωσης. Η αναζήτηση είναι anytime: σταματά όταν
+// εξαντληθεί το budget σε ms και επιστρέφει την πιο δοκιμασμένη κίνηση της ρίζας, οπότε
+// μεγαλύτερο budget σημαίνει περισσότερες προσομοιώσεις και δυνατότερο αντίπαλο
+// Η findMove κάνει όλη την αναζήτηση μαζί. Με begin/iterate/bestMove η ίδια αναζήτηση
+// μοιράζεται σε κομμάτια (π.χ. στο budget κάθε tick), αφού το δέντρο μένει ανάμεσα στις κλήσεις
+// Το AISearch δεν μοιράζεται τίποτα με άλλα threads (χρησιμοποιείται από τον worker του AI)
+class AISearch {
+private:
+    static const float PLY_SECONDS;      // Χρόνος προσομοίωσης μετά από κάθε ζευγάρι κινήσεων
+    static const int ROLLOUT_PLIES;      // Ζευγάρια τυχαίων κινήσεων σε κάθε rollout
+    static const int MAX_DEPTH;          // Μέγιστο βάθος του δέντρου
+    static const int MAX_NODES;
+    static const float EXPLORATION;      // Σταθερά εξερεύνησης του UCT
+    static const int MAX_ACTIONS = 1 + SimWorld::MAX_ENTITIES * 3;
+
+    struct Node {
+        SimAction action;        // Κίνηση που οδηγεί σε αυτόν τον κόμβο
+        int parent;
+        int first_child;         // -1 αν δεν έχει αναπτυχθεί
+        int child_count;
+        int depth;               // Άρτιο: κινείται η πλευρά me, περιττό: ο αντίπαλος
+        int visits;
+        float value;             // Άθροισμα αξιολογήσεων από την πλευρά me
+    };
+
+    std::vector<Node> nodes;
+    SimAction actions[MAX_ACTIONS];
+    unsigned int rng_state;
+    long long rollouts;          // Συνολικά rollouts (για μετρήσεις)
+    SearchStats last_stats;
+    Side root_side;              // Πλευρά που κινείται στη ρίζα του τρέχοντος δέντρου
+
+    unsigned int nextRandom();   // xorshift - γρήγορο και χωρίς κοινή κατάσταση
+    int generateActions(const SimWorld& world, Side side, SimAction* out) const;
+    void randomAction(SimWorld& world, Side side);
+    void apply(SimWorld& world, const SimAction& action) const;
+    int select(int node) const;
+    void expand(int node, const SimWorld& world, Side mover);
+
+public:
+    AISearch();
+
+    // Καλύτερη κίνηση της πλευράς me μέσα σε budget_ms (SimAction με from = -1 για καμία)
+    SimAction findMove(const SimWorld& root, Side me, float budget_ms);
+
+    // Αναζήτηση σε κομμάτια: begin (false αν η μόνη κίνηση είναι η "καμία"), iterate όσες φορές
+    // χρειάζεται με τον ίδιο root και bestMove στο τέλος
+    bool begin(const SimWorld& root, Side me);
+    void iterate(const SimWorld& root, float budget_ms);
+    SimAction bestMove();
+
+    void seed(unsigned int s) { rng_state = s ? s : 1u; }
+    long long getRollouts() const { return rollouts; }
+    const SearchStats& getLastStats() const { return last_stats; }
+};
@@ -4,587 +4,653 @@
 #include <cmath>
 #include <cstdlib>
 #include <cfloat>
-#include <random>
 #include <map>
 #include "sgg/graphics.h"
 
-// Random number generator για τυχαίες αποφάσεις του AI
-std::random_device rd;
-std::mt19937 gen(rd());
+const float AISystem::SPELL_PLAN_INTERVAL = 0.25f;
+const size_t AISystem::COMMAND_CAPACITY;
+const size_t AISystem::TRACE_QUEUE_CAPACITY;
 
 // Κατασκευαστής AISystem
-AISystem::AISystem(GlobalState* gs, EntityGraph* graph)
-    : global_state(gs), entity_graph(graph),
-    decision_timer(0.0f), decision_interval(2.0f),
-    strategy(AIStrategy::ADAPTIVE), aggression_level(0.5f) {
+AISystem::AISystem(GlobalState* gs, EntityGraph* graph, Side controlled, Side opposing, bool run_async)
+    : global_state(gs), entity_graph(graph), side(controlled), opponent(opposing),
+    decision_due(false), spell_due(false), plan_in_flight(false), decision_interval(2.0f), async(false), search_budget_ms(0.0f), last_tick_us(0.0f),
+    opening_next(0), opening_end(0.0f), opening_start(0.0), opening_due(false),
+    planner(controlled, opposing), sync_active(false), sync_applied(0), stopping(false),
+    trace(nullptr), trace_lost(0),
+    exposure_pass(0), exposure_tower_epoch(0), exposure_graph_version(0) {
+    setAsync(run_async);
 }
 
-// Αρχικοποίηση AI - επαναφορά τιμών
-void AISystem::init() {
-    decision_timer = 0.0f;
-    aggression_level = 0.5f;
-    strategy = AIStrategy::ADAPTIVE;
+// Destructor - τα callbacks των χρονομέτρων δείχνουν σε αυτό το αντικείμενο
+AISystem::~AISystem() {
+    stopWorker();
+    flushTrace();
+    TimerWheel::getInstance()->cancel(decision_timer);
+    TimerWheel::getInstance()->cancel(spell_timer);
+    TimerWheel::getInstance()->cancel(opening_timer);
 }
 
-// Ενημέρωση AI κάθε frame
-void AISystem::update(float dt) {
-    float dt_seconds = dt / 1000.0f;
-    decision_timer += dt_seconds;
-
-    // Έλεγχος αν ήρθε ώρα για λήψη αποφάσεων
-    if (decision_timer >= decision_interval) {
-        analyzeGameState();
-        makeStrategicDecisions();
-        decision_timer = 0.0f;
-        // Τυχαίο διάστημα μεταξύ αποφάσεων (1.5-2.5 δευτερόλεπτα)
-        decision_interval = 1.5f + ((rand() % 1000) / 1000.0f);
-    }
-
-    // Ενημέρωση spells εχθρικών Wizards
-    castEnemySpells();
+// Προγραμματισμός της επόμενης λήψης αποφάσεων
+void AISystem::scheduleDecision(float delay) {
+    TimerWheel* wheel = TimerWheel::getInstance();
+    wheel->cancel(decision_timer);
+    decision_timer = wheel->schedule(delay, [this]() { decision_due = true; });
 }
 
-// Ανάλυση τρέχουσας κατάστασης παιχνιδιού
-void AISystem::analyzeGameState() {
-    auto player_entities = getPlayerEntities();
-    auto enemy_entities = getEnemyEntities();
-    auto neutral_entities = getNeutralEntities();
-
-    // Μετατροπή size_t σε int για αποφυγή warning
-    int player_count = static_cast<int>(player_entities.size());
-    int enemy_count = static_cast<int>(enemy_entities.size());
-    int neutral_count = static_cast<int>(neutral_entities.size());
-
-    // Υπολογισμός συνολικής δύναμης κάθε πλευράς
-    int player_power = calculateTotalPower(player_entities);
-    int enemy_power = calculateTotalPower(enemy_entities);
-
-    //Λογική επιλογής στρατηγικής
-    if (player_count > enemy_count + 2 || player_power > enemy_power * 2) {
-        // Ο παίκτης είναι πολύ δυνατός - Άμυνα
-        strategy = AIStrategy::DEFENSIVE;
-        aggression_level = 0.3f;
-    }
-    else if (neutral_count > player_count && neutral_count > enemy_count) {
-        // Υπάρχουν πολλά ουδέτερα - Επέκταση
-        strategy = AIStrategy::EXPANSIVE;
-        aggression_level = 0.4f;
-    }
-    else if (enemy_count > player_count && enemy_power > player_power) {
-        // Αν η εχθρική δύναμη είναι μεγαλύτερη - Επιθεση
-        strategy = AIStrategy::AGGRESSIVE;
-        aggression_level = 0.7f;
-    }
-    else {
-        // Ισορροπία - μικτή στρατηγική
-        strategy = AIStrategy::MIXED;
-        aggression_level = 0.5f;
-    }
-}
+// Προγραμματισμός της επόμενης αποστολής του ανοίγματος
+void AISystem::scheduleOpening() {
+    TimerWheel* wheel = TimerWheel::getInstance();
+    wheel->cancel(opening_timer);
+    if (opening_next >= opening.size()) return;
 
-// Υπολογισμός συνολικής δύναμης
-int AISystem::calculateTotalPower(const std::vector<Entity*>& entities) {
-    int total_power = 0;
-    for (auto entity : entities) {
-        // Βασική δύναμη = ζωή
-        int power = entity->getHealth();
-
-        // Πολλαπλασιάζουμε με βάση τον τύπο
-        std::string type = entity->getType();
-        if (type == "Wizard") power *= 3;
-        else if (type == "Tower") power *= 2;
-        else if (type == "Warrior") power *= 2;
-
-        // Προσθέτουμε επιπλέον βάρος για level
-        power = static_cast<int>(power * (1.0f + entity->getLevel() * 0.2f));
-
-        total_power += power;
-    }
-    return total_power;
+    float delay = (float)(opening_start + opening[opening_next].time - wheel->now());
+    opening_timer = wheel->schedule(std::max(delay, 0.0f), [this]() { opening_due = true; });
 }
 
-// Λήψη στρατηγικών αποφάσεων για κάθε εχθρική οντότητα
-void AISystem::makeStrategicDecisions() {
-    auto enemy_entities = getEnemyEntities();
-
-    // Για κάθε entity του AI, παίρνουμε απόφαση
-    for (auto entity : enemy_entities) {
-        std::string type = entity->getType();
-        int health = entity->getHealth();
-
-        // 1. Πάντα δοκιμάζουμε να αναβαθμίσουμε πρώτα (αν έχουμε αρκετή ζωή)
-        if (health > entity->getMaxHealth() * 0.7f && entity->canUpgrade()) {
-            if (rand() % 100 < 50) { // 50% πιθανότητα αναβάθμισης (ακόμα πιο συχνά)
-                entity->performUpgrade();
-                continue; // Συνέχεια με επόμενο entity
-            }
+// Αποστολές του ανοίγματος που έφτασαν (η εντολή ελέγχεται ξανά όπως κάθε εντολή του AI)
+void AISystem::playOpening() {
+    opening_due = false;
+    double elapsed = TimerWheel::getInstance()->now() - opening_start;
+
+    do {
+        const AICommand& command = opening[opening_next].command;
+        Entity* actor = EntityStore::getInstance()->resolve(command.actor);
+        if (!actor || actor->getSide() != side) {
+            // Ο κόσμος απομακρύνθηκε από το άνοιγμα - κανονικές αποφάσεις από τώρα
+            opening_next = opening.size();
+            decision_due = true;
+            return;
         }
-
-        // 2. Ειδική λογική για BABY: Προτεραιότητα στην αναβάθμιση
-        if (type == "Baby" && entity->canUpgrade()) {
-            if (rand() % 100 < 70) { // 70% πιθανότητα το Baby να αναβαθμιστεί
-                entity->performUpgrade();
-                continue;
-            }
+        applyCommand(command);
+        if (trace) {
+            AITraceRecord entry;
+            entry.time_us = trace->nowUs();
+            entry.type = AITraceRecord::SEND;
+            entry.side = (unsigned char)side;
+            entry.detail = AITraceRecord::OPENING;
+            entry.actor = (short)command.actor.slot;
+            entry.target = (short)command.target.slot;
+            entry.amount = command.amount;
+            trace->record(entry);
         }
+        opening_next++;
+    } while (opening_next < opening.size() && opening[opening_next].time <= elapsed);
 
-        // 3. Λαμβάνουμε απόφαση ανάλογα με τη στρατηγική
-        int decision_roll = rand() % 100;
-
-        switch (strategy) {
-        case AIStrategy::AGGRESSIVE:
-            if (type == "Warrior") {
-                if (decision_roll < 80) attackWeakestPlayerTarget(entity);
-                else if (decision_roll < 95) attackStrategicTarget(entity);
-            }
-            else if (type == "Baby") {
-                if (decision_roll < 60) convertNearestNeutral(entity);
-                else if (decision_roll < 90 && entity->canUpgrade()) {
-                    entity->performUpgrade(); // Αναβάθμιση Baby
-                }
-            }
-            break;
-
-        case AIStrategy::DEFENSIVE:
-            if (type == "Warrior") {
-                if (decision_roll < 50) attackWeakestPlayerTarget(entity);
-                else if (decision_roll < 70) convertNearestNeutral(entity);
-            }
-            else if (type == "Baby") {
-                if (decision_roll < 40) convertNearestNeutral(entity);
-                else if (decision_roll < 80 && entity->canUpgrade()) {
-                    entity->performUpgrade(); 
-                }
-            }
-            break;
-
-        case AIStrategy::EXPANSIVE:
-            if (type == "Warrior" || type == "Baby") {
-                if (decision_roll < 80) convertNearestNeutral(entity);
-                else if (decision_roll < 95) attackWeakestPlayerTarget(entity);
-            }
-            break;
+    scheduleOpening();
+}
 
-        case AIStrategy::MIXED:
-            if (type == "Warrior") {
-                if (decision_roll < 60) attackWeakestPlayerTarget(entity);
-                else if (decision_roll < 85) convertNearestNeutral(entity);
-                else attackStrategicTarget(entity);
-            }
-            else if (type == "Baby") {
-                if (decision_roll < 50) convertNearestNeutral(entity);
-                else if (decision_roll < 85 && entity->canUpgrade()) {
-                    entity->performUpgrade(); 
-                }
-            }
-            break;
-
-        case AIStrategy::ADAPTIVE:
-        default:
-            if (type == "Warrior") {
-                if (decision_roll < 70) attackWeakestPlayerTarget(entity);
-                else if (decision_roll < 90) convertNearestNeutral(entity);
-                else attackStrategicTarget(entity);
-            }
-            else if (type == "Baby") {
-                if (decision_roll < 60) convertNearestNeutral(entity);
-                else if (decision_roll < 90 && entity->canUpgrade()) {
-                    entity->performUpgrade(); 
-                }
-            }
-            break;
-        }
+void AISystem::setOpening(const OpeningLine& line, const std::vector<EntityHandle>& layout) {
+    opening.clear();
+    opening_next = 0;
+    opening_end = 0.0f;
+
+    int count = (int)layout.size();
+    for (const OpeningMove& move : line.moves) {
+        if (move.from < 0 || move.from >= count || move.to < 0 || move.to >= count) continue;
+
+        OpeningStep step;
+        step.time = move.time;
+        step.command.type = AICommand::SEND;
+        step.command.actor = layout[move.from];
+        step.command.target = layout[move.to];
+        step.command.amount = move.amount;
+        opening.push_back(step);
+        opening_end = std::max(opening_end, move.time);
     }
 }
 
-// Ρίψη spells από εχθρικούς Wizards
-void AISystem::castEnemySpells() {
-    auto enemy_entities = getEnemyEntities();
-
-    for (auto entity : enemy_entities) {
-        if (entity->getType() == "Wizard") {
-            Wizard* wizard = static_cast<Wizard*>(entity);
-
-            // 5% πιθανότητα ανά frame να ρίξει spell
-            if (rand() % 100 < 5) {
-                castSmartSpell(wizard);
-            }
-        }
-    }
+// Προγραμματισμός του επόμενου σχεδιασμού spells
+void AISystem::scheduleSpellPlan() {
+    TimerWheel* wheel = TimerWheel::getInstance();
+    wheel->cancel(spell_timer);
+    spell_timer = wheel->schedule(SPELL_PLAN_INTERVAL, [this]() { spell_due = true; });
 }
 
-// Έξυπνη λογική για επιλογή και ρίψη spells
-void AISystem::castSmartSpell(Wizard* wizard) {
-    if (!wizard) return;
+// Αρχικοποίηση AI - επαναφορά τιμών (πριν από την πρώτη εικόνα, οπότε ο worker είναι αδρανής)
+void AISystem::init() {
+    decision_due = false;
+    spell_due = false;
+    planner.reset();
+
+    // Με άνοιγμα η πρώτη απόφαση έρχεται μαζί με την τελευταία αποστολή του (στην update
+    // το άνοιγμα παίζει πριν από την εικόνα, όπως στους αγώνες του opening_book_gen)
+    opening_next = 0;
+    opening_due = false;
+    opening_start = TimerWheel::getInstance()->now();
+    scheduleDecision(std::max(decision_interval, opening_end));
+    scheduleOpening();
+    scheduleSpellPlan();
+}
 
-    auto player_entities = getPlayerEntities();
-    if (player_entities.empty()) return;
+// Ενημέρωση AI κάθε frame
+void AISystem::update(float dt) {
+    scheduler.beginTick();
 
-    // Επιλογή spell με βάση τη στρατηγική
-    int spell_to_cast = -1;
+    bool worked = false;  // Για το ίχνος: αν το tick είχε δουλειά πέρα από την εφαρμογή εντολών
 
-    switch (strategy) {
-    case AIStrategy::AGGRESSIVE:
-        spell_to_cast = 1; // Sickness - για επιθετικότητα
-        break;
-    case AIStrategy::DEFENSIVE:
-        spell_to_cast = 0; // Freeze - για άμυνα
-        break;
-    case AIStrategy::EXPANSIVE:
-        spell_to_cast = 2; // Convert - για επέκταση
-        break;
-    default:
-        // Τυχαία επιλογή
-        spell_to_cast = rand() % 3;
-        break;
+    // Συνέχεια του σύγχρονου σχεδίου από το προηγούμενο tick
+    if (sync_active) {
+        stepSyncPlan(true);
+        worked = true;
     }
 
-    // Έλεγχος διαθεσιμότητας επιλεγμενου spell
-    if (!wizard->canCastSpell(spell_to_cast)) {
-        // Αν δεν μπορεί να ρίξει το επιλεγμένο, δοκιμάζουμε τα υπόλοιπα
-        for (int i = 0; i < 3; i++) {
-            if (wizard->canCastSpell(i)) {
-                spell_to_cast = i;
-                break;
-            }
-        }
+    // Αποστολές του βιβλίου ανοιγμάτων
+    if (opening_due && isInOpening()) {
+        playOpening();
+        worked = true;
     }
 
-    // Ρίψη spell αν είναι δυνατή
-    if (spell_to_cast >= 0 && wizard->canCastSpell(spell_to_cast)) {
-        // Βρίσκουμε τον καλύτερο στόχο για το spell
-        Entity* best_target = nullptr;
-        float best_value = -1.0f;
-
-        for (auto target : player_entities) {
-            float value = evaluateSpellValue(wizard, spell_to_cast, target);
-            if (value > best_value) {
-                best_value = value;
-                best_target = target;
-            }
+    // Εφαρμογή των εντολών που έχει ετοιμάσει ο worker (χωρίς αναμονή, μέσα στο budget -
+    // οι υπόλοιπες μένουν στην ουρά για το επόμενο tick)
+    int applied = 0;
+    AICommand command;
+    while (scheduler.hasTime() && commands.tryPop(command)) {
+        if (command.type == AICommand::DONE) {
+            plan_in_flight = false;
         }
-
-        // Ρίψη spell αν υπάρχει κατάλληλος στόχος
-        if (best_target && best_value > 30.0f) { // Μικρότερο threshold
-            int cost = wizard->getSpellCost(spell_to_cast);
-            if (wizard->getHealth() >= cost) {
-                wizard->setHealth(wizard->getHealth() - cost);
-                wizard->castSpell(spell_to_cast, best_target);
-            }
+        else {
+            applyCommand(command);
+            applied++;
         }
     }
-}
-
-// Αξιολόγηση στόχου για συγκεκριμένο spell
-float AISystem::evaluateSpellValue(Wizard* wizard, int spell_id, Entity* target) {
-    if (!wizard || !target) return 0.0f;
-
-    float value = static_cast<float>(target->getHealth());
-
-    // Προσαρμογή βάσει τύπου στόχου
-    std::string type = target->getType();
+    if (!commands.empty()) scheduler.markSpilled();
 
-    switch (spell_id) {
-    case 0: // Freeze
-        if (type == "Wizard") value *= 3.0f;
-        else if (type == "Tower") value *= 2.0f;
-        else if (type == "Warrior") value *= 1.5f;
-        break;
-
-    case 1: // Sickness
-        if (type == "Wizard") value *= 4.0f;
-        else if (type == "Warrior" && target->getLevel() > 2) value *= 3.0f;
-        else if (type == "Tower") value *= 2.0f;
-        break;
-
-    case 2: // Convert
-        if (type == "Wizard") value *= 5.0f;
-        else if (type == "Tower") value *= 4.0f;
-        else if (type == "Warrior") value *= 2.0f;
-        break;
+    // Νέα εικόνα αν έληξε κάποιο χρονόμετρο και ο σχεδιασμός είναι ελεύθερος
+    // (αλλιώς τα χρονόμετρα μένουν ληγμένα και η εικόνα στέλνεται σε επόμενο frame)
+    if ((decision_due || spell_due) && !plan_in_flight && !sync_active) {
+        requestPlan();
+        worked = true;
     }
 
-    // Προσαρμογή βάσει στρατηγικής
-    if (strategy == AIStrategy::AGGRESSIVE && spell_id == 1) value *= 1.5f;
-    if (strategy == AIStrategy::DEFENSIVE && spell_id == 0) value *= 1.5f;
-    if (strategy == AIStrategy::EXPANSIVE && spell_id == 2) value *= 2.0f;
-
-    return value;
+    last_tick_us = scheduler.getElapsedUs();
+    if (trace) traceTick(applied, worked);
 }
 
-// Απλοποιημένη εκτέλεση επιθετικής στρατηγικής
-void AISystem::executeAggressiveStrategy() {
-    auto enemy_entities = getEnemyEntities();
-    for (auto entity : enemy_entities) {
-        if (entity->getType() == "Warrior" && rand() % 100 < 70) {
-            attackWeakestPlayerTarget(entity);
-        }
-    }
+// Εγγραφές του worker στο ίχνος και TICK αν το AI έκανε κάτι σε αυτό το tick
+void AISystem::traceTick(int applied, bool worked) {
+    flushTrace();
+    if (!worked && applied == 0) return;
+
+    AITraceRecord entry;
+    entry.time_us = trace->nowUs();
+    entry.type = AITraceRecord::TICK;
+    entry.side = (unsigned char)side;
+    entry.amount = applied;
+    if (!commands.empty() || sync_active) entry.flags = AITraceRecord::SPILLED;
+    entry.cost_us = last_tick_us;
+    trace->record(entry);
 }
 
-// Απλοποιημένη εκτέλεση αμυντικής στρατηγικής
-void AISystem::executeDefensiveStrategy() {
-    auto enemy_entities = getEnemyEntities();
-    for (auto entity : enemy_entities) {
-        if (entity->getType() == "Warrior" && rand() % 100 < 30) {
-            convertNearestNeutral(entity);
-        }
+void AISystem::flushTrace() {
+    AITraceRecord entry;
+    while (trace_queue.tryPop(entry)) {
+        if (trace) trace->record(entry);
     }
+
+    unsigned int lost = trace_lost.exchange(0);
+    if (trace && lost > 0) trace->addDropped(lost);
 }
 
-// Απλοποιημένη εκτέλεση επεκτατικής στρατηγικής
-void AISystem::executeExpansiveStrategy() {
-    auto enemy_entities = getEnemyEntities();
-    for (auto entity : enemy_entities) {
-        if ((entity->getType() == "Warrior" || entity->getType() == "Baby") && rand() % 100 < 60) {
-            convertNearestNeutral(entity);
-        }
-    }
+// Αλλαγή ίχνους (ο worker δεν πρέπει να γράφει εκείνη τη στιγμή)
+void AISystem::setTrace(AITrace* new_trace) {
+    bool was_async = async;
+    setAsync(false);
+    if (sync_active) stepSyncPlan(false);
+    flushTrace();
+    trace = (new_trace && new_trace->isEnabled()) ? new_trace : nullptr;
+    planner.setTrace(trace);
+    setAsync(was_async);
 }
 
-// Απλοποιημένη εκτέλεση μικτής στρατηγικης
-void AISystem::executeMixedStrategy() {
-    auto enemy_entities = getEnemyEntities();
-    for (auto entity : enemy_entities) {
-        if (entity->getType() == "Warrior") {
-            int roll = rand() % 100;
-            if (roll < 40) attackWeakestPlayerTarget(entity);
-            else if (roll < 70) convertNearestNeutral(entity);
-        }
-    }
+// Αλλαγή policy (ο worker δεν πρέπει να τη χρησιμοποιεί εκείνη τη στιγμή)
+void AISystem::setPolicy(std::unique_ptr<AIPolicy> new_policy) {
+    bool was_async = async;
+    setAsync(false);
+    if (sync_active) stepSyncPlan(false);
+    planner.setPolicy(std::move(new_policy));
+    setAsync(was_async);
 }
 
-// Εκτέλεση προσαρμοστικής στρατηγικής
-void AISystem::executeAdaptiveStrategy() {
-    // Χρησιμοποιούμε την makeStrategicDecisions που έχει adaptive λογική
-    makeStrategicDecisions();
+// Αλλαγή παραμέτρων (όπως η setPolicy, ο worker σταματά για την αλλαγή)
+void AISystem::setParams(const AIParams& new_params) {
+    bool was_async = async;
+    setAsync(false);
+    if (sync_active) stepSyncPlan(false);
+    planner.setParams(new_params);
+    setAsync(was_async);
 }
 
-// Επίθεση στον ασθενέστερο στόχο του παίκτη
-void AISystem::attackWeakestPlayerTarget(Entity* attacker) {
-    if (!attacker) return;
+void AISystem::seed(unsigned int s) {
+    bool was_async = async;
+    setAsync(false);
+    if (sync_active) stepSyncPlan(false);
+    planner.seed(s);
+    setAsync(was_async);
+}
 
-    Entity* target = findWeakestPlayerEntity();
-    if (!target) return;
+// Σχεδιασμός σε thread ή σύγχρονα
+// Κατά την απενεργοποίηση ο worker τελειώνει την τρέχουσα εικόνα και οι εντολές της εφαρμόζονται
+void AISystem::setAsync(bool enabled) {
+    if (enabled == async) return;
 
-    int amount = calculateOptimalTroopSize(attacker);
-    if (amount > 0) {
-        sendTroops(attacker, target, amount);
+    if (enabled) {
+        if (sync_active) stepSyncPlan(false);  // Ολοκλήρωση του σύγχρονου σχεδίου
+        startWorker();
+        return;
     }
-}
 
-// Επίθεση σε στρατηγικό στόχο (όχι απαραίτητα τον ασθενέστερο)
-void AISystem::attackStrategicTarget(Entity* attacker) {
-    if (!attacker) return;
+    stopWorker();
 
-    Entity* target = findStrategicPlayerTarget();
-    if (!target) return;
+    AICommand command;
+    while (commands.tryPop(command)) {
+        if (command.type != AICommand::DONE) applyCommand(command);
+    }
 
-    int amount = calculateOptimalTroopSize(attacker);
-    if (amount > 0) {
-        sendTroops(attacker, target, amount);
+    // Εικόνα που δεν πρόλαβε να επεξεργαστεί - ξαναζητείται στο επόμενο frame
+    std::unique_ptr<AISnapshot> pending;
+    if (snapshots.tryPop(pending)) {
+        if (pending->decide) decision_due = true;
+        else spell_due = true;
     }
+    plan_in_flight = false;
 }
 
-// Εύρεση στρατηγικού στόχου (βάσει τύπου, ζωής και level)
-Entity* AISystem::findStrategicPlayerTarget() {
-    auto player_entities = getPlayerEntities();
-    if (player_entities.empty()) return nullptr;
+void AISystem::startWorker() {
+    stopping = false;
+    async = true;
+    worker = std::thread(&AISystem::workerLoop, this);
+}
 
-    Entity* best_target = nullptr;
-    float best_value = -1.0f;
+void AISystem::stopWorker() {
+    if (!worker.joinable()) return;
 
-    for (auto entity : player_entities) {
-        float value = 0.0f;
+    stopping = true;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex);
+    }
+    wake.notify_one();
+    worker.join();
+    async = false;
+}
 
-        // Βασική αξία βάσει τύπου
-        std::string type = entity->getType();
-        if (type == "Wizard") value = 100.0f;
-        else if (type == "Tower") value = 80.0f;
-        else if (type == "Warrior") value = 60.0f;
-        else value = 40.0f; // Baby
+// Βρόχος του worker: αναμονή για εικόνα, σχεδιασμός, αποστολή εντολών
+void AISystem::workerLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wake.wait(lock, [this]() { return stopping.load() || !snapshots.empty(); });
+        }
+        if (stopping) return;
 
-        // Προτεραιότητα σε αδύνατους στόχους
-        value += (100.0f - static_cast<float>(entity->getHealth()));
+        std::unique_ptr<AISnapshot> snapshot;
+        if (!snapshots.tryPop(snapshot)) continue;
 
-        // Προτεραιότητα σε υψηλό level
-        value += static_cast<float>(entity->getLevel() * 10.0f);
+        worker_plan.clear();
+        planner.planSnapshot(*snapshot, worker_plan);
 
-        if (value > best_value) {
-            best_value = value;
-            best_target = entity;
+        // Εγγραφές του ίχνους: αν η ουρά είναι γεμάτη χάνονται (ο worker δεν περιμένει ποτέ)
+        for (const AITraceRecord& entry : planner.getTraceRecords()) {
+            if (!trace_queue.tryPush(entry)) trace_lost.fetch_add(1, std::memory_order_relaxed);
+        }
+        planner.getTraceRecords().clear();
+
+        AICommand done;
+        worker_plan.push_back(done);
+        for (const AICommand& command : worker_plan) {
+            // Γεμάτη ουρά: το main thread την αδειάζει στο επόμενο frame
+            while (!commands.tryPush(command)) {
+                if (stopping) return;
+                std::this_thread::yield();
+            }
         }
-    }
 
-    return best_target;
+        recycled.tryPush(std::move(snapshot));
+    }
 }
 
-// Εύρεση πιο απειλητικής οντότητας του παίκτη
-Entity* AISystem::findMostThreateningPlayerEntity() {
-    auto player_entities = getPlayerEntities();
-    if (player_entities.empty()) return nullptr;
+// Αποστολή εικόνας στον worker (ή σύγχρονος σχεδιασμός)
+void AISystem::requestPlan() {
+    bool decide = decision_due;
+    decision_due = false;
+    spell_due = false;
+    scheduleSpellPlan();
 
-    Entity* most_threatening = nullptr;
-    int max_threat = -1;
+    if (decide) {
+        // Τυχαίο διάστημα μεταξύ αποφάσεων (1.5-2.5 δευτερόλεπτα)
+        decision_interval = 1.5f + ((rand() % 1000) / 1000.0f);
+        scheduleDecision(decision_interval);
+    }
+    else {
+        // Μόνο spells: χωρίς εικόνα αν κανένας Wizard της πλευράς δεν έχει διαθέσιμο spell
+        bool any_ready = false;
+        for (Entity* entity : EntityStore::getInstance()->getMembers(EntityKind::WIZARD)) {
+            if (entity->getSide() != side) continue;
+            Wizard* wizard = static_cast<Wizard*>(entity);
+            for (int i = 0; i < 3 && !any_ready; i++) {
+                any_ready = wizard->canCastSpell(i);
+            }
+            if (any_ready) break;
+        }
+        if (!any_ready) return;
+    }
 
-    for (auto entity : player_entities) {
-        int threat = entity->getHealth() * entity->getLevel();
-        if (entity->getType() == "Wizard") threat *= 2;
+    AITrace::Clock::time_point snapshot_start = AITrace::Clock::now();
+    std::unique_ptr<AISnapshot> snapshot = takeSnapshot(decide);
+    if (trace) {
+        AITraceRecord entry;
+        entry.time_us = trace->nowUs();
+        entry.type = AITraceRecord::SNAPSHOT;
+        entry.side = (unsigned char)side;
+        entry.flags = decide ? AITraceRecord::DECIDE : 0;
+        entry.amount = (int)(snapshot->own.size() + snapshot->opponents.size() + snapshot->neutral.size());
+        entry.candidates = (unsigned short)std::min<size_t>(snapshot->troops.size(), 0xFFFF);
+        entry.cost_us = AITrace::elapsedUs(snapshot_start);
+        trace->record(entry);
+    }
 
-        if (threat > max_threat) {
-            max_threat = threat;
-            most_threatening = entity;
+    if (async) {
+        plan_in_flight = true;
+        snapshots.tryPush(std::move(snapshot));  // Μία εικόνα τη φορά - υπάρχει πάντα θέση
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
         }
+        wake.notify_one();
+        return;
     }
 
-    return most_threatening;
+    // Σύγχρονα: προετοιμασία τώρα και αποφάσεις σε βήματα μέσα στο budget κάθε tick
+    sync_plan.clear();
+    sync_applied = 0;
+    sync_snapshot = std::move(snapshot);
+    planner.begin(*sync_snapshot, sync_plan);
+    sync_active = true;
+    stepSyncPlan(true);
 }
 
-// Μετατροπή του κοντινότερου ουδέτερου
-void AISystem::convertNearestNeutral(Entity* converter) {
-    if (!converter) return;
+// Κάθε βήμα του planner (απόφαση ενός entity, κομμάτι της αναζήτησης ή spells) και η
+// εφαρμογή των εντολών του. Οι αποφάσεις διαβάζουν μόνο την εικόνα και το rng, οπότε οι
+// εντολές είναι ίδιες όπως κι αν μοιραστούν τα βήματα στα ticks
+void AISystem::stepSyncPlan(bool budgeted) {
+    while (sync_active) {
+        if (budgeted && !scheduler.hasTime()) {
+            scheduler.markSpilled();
+            return;
+        }
 
-    Entity* target = findNearestNeutralEntity(converter);
-    if (!target) return;
+        // Η αναζήτηση παίρνει ό,τι μένει από το budget του tick και συνεχίζει στο επόμενο
+        bool sliced = budgeted && scheduler.getBudget() > 0.0f;
+        sync_active = !planner.step(sliced ? scheduler.getRemainingUs() / 1000.0f : -1.0f);
 
-    int amount = calculateOptimalTroopSize(converter);
-    if (amount > 0) {
-        sendTroops(converter, target, amount);
+        for (; sync_applied < sync_plan.size(); sync_applied++) {
+            applyCommand(sync_plan[sync_applied]);
+        }
+
+        std::vector<AITraceRecord>& records = planner.getTraceRecords();
+        if (trace) {
+            for (const AITraceRecord& entry : records) trace->record(entry);
+        }
+        records.clear();
     }
+    spare = std::move(sync_snapshot);
 }
 
-// Υπολογισμός βέλτιστου μεγέθους troop για αποστολή
-int AISystem::calculateOptimalTroopSize(Entity* attacker) {
-    if (!attacker) return 0;
-
-    // Στέλνουμε ποσοστό της ζωής του attacker
-    int max_troops = attacker->getHealth() * 0.6f; // 60% της ζωής
-    if (max_troops < 5) return 0; // Ελάχιστο 5
-
-    // Εξασφαλίζουμε ότι min <= max
-    int min_troops = 5; // Ελάχιστο 5
-    int max_troops_clamped = std::min(100, max_troops); // Μέγιστο 30
-
-    if (min_troops > max_troops_clamped) {
-        return min_troops; // Στέλνουμε τουλάχιστον το ελάχιστο
+// Εικόνα του κόσμου από τις λίστες του EntityStore (επαναχρησιμοποίηση παλιάς εικόνας αν υπάρχει)
+std::unique_ptr<AISnapshot> AISystem::takeSnapshot(bool decide) {
+    std::unique_ptr<AISnapshot> snapshot = std::move(spare);
+    if (!snapshot) recycled.tryPop(snapshot);
+    if (!snapshot) snapshot.reset(new AISnapshot());
+
+    EntityStore* store = EntityStore::getInstance();
+    const std::vector<Entity*>& opponents = store->getMembers(opponent);
+    const std::vector<Entity*>& own = store->getMembers(side);
+    const std::vector<Entity*>& neutral = store->getMembers(Side::NEUTRAL);
+
+    snapshot->opponents.resize(opponents.size());
+    for (size_t i = 0; i < opponents.size(); i++) fillView(snapshot->opponents[i], opponents[i]);
+    snapshot->own.resize(own.size());
+    for (size_t i = 0; i < own.size(); i++) fillView(snapshot->own[i], own[i]);
+    snapshot->neutral.resize(neutral.size());
+    for (size_t i = 0; i < neutral.size(); i++) fillView(snapshot->neutral[i], neutral[i]);
+
+    // Troops σε κίνηση μόνο στις αποφάσεις
+    snapshot->troops.clear();
+    if (decide) {
+        for (Troop* troop : global_state->getTroops()) {
+            if (troop->hasArrived() || troop->isDead()) continue;
+
+            AITroopView troop_view;
+            troop_view.target = troop->getTargetHandle();
+            troop_view.side = troop->getSide();
+            troop_view.amount = troop->getHealthAmount();
+            troop_view.x = troop->getX();
+            troop_view.y = troop->getY();
+            troop_view.eta = troop->getTimeToArrival();
+            for (int i = 0; i < AITroopView::PATH_SAMPLES; i++) {
+                std::pair<float, float> point = troop->getPositionAhead((float)i / (AITroopView::PATH_SAMPLES - 1));
+                troop_view.path_x[i] = point.first;
+                troop_view.path_y[i] = point.second;
+            }
+            snapshot->troops.push_back(troop_view);
+        }
     }
 
-    std::uniform_int_distribution<> dis(min_troops, max_troops_clamped);
-    return dis(gen);
-}
+    // Διαδρομές μόνο για τον πίνακα χρησιμότητας (η αναζήτηση έχει τον δικό της κόσμο)
+    snapshot->routes.clear();
+    if (decide && search_budget_ms <= 0.0f) fillRoutes(*snapshot);
 
-// Αποστολή troops από μία οντότητα σε άλλη
-void AISystem::sendTroops(Entity* from, Entity* to, int amount) {
-    if (!from || !to || amount <= 0) return;
+    snapshot->side = side;
+    snapshot->decide = decide;
+    snapshot->search_budget_ms = search_budget_ms;
+    snapshot->opponent_power = decide ? calculateTotalPower(opponent) : 0;
+    snapshot->own_power = decide ? calculateTotalPower(side) : 0;
+    return snapshot;
+}
 
-    // Αφήνουμε τουλάχιστον 10 ζωή για να μην πεθάνει αμέσως
-    if (from->getHealth() <= amount + 10) {
-        amount = from->getHealth() - 10; // Στέλνουμε όσο περισσότερο μπορούμε
-        if (amount < 5) return; // Πολύ λίγο - δεν στέλνουμε
+// Αντιγραφή ενός entity (οι δυνατότητες upgrade/splash/spells μόνο για τα δικά μας)
+void AISystem::fillView(AIEntityView& view, Entity* entity) {
+    view.handle = entity->getHandle();
+    view.kind = entity->getKind();
+    view.side = entity->getSide();
+    view.health = entity->getHealth();
+    view.max_health = entity->getMaxHealth();
+    view.level = entity->getLevel();
+    view.x = entity->getX();
+    view.y = entity->getY();
+    view.healing_speed = entity->getHealingSpeed();
+    view.defense = entity->getDefense();
+    view.attacking_speed = entity->getAttackingSpeed();
+    view.tower_damage = 0;
+    view.attack_interval = 0.0f;
+    view.attack_radius = 0.0f;
+    if (view.kind == EntityKind::TOWER) {
+        Tower* tower = static_cast<Tower*>(entity);
+        view.tower_damage = tower->isSplash() ? tower->getSplashDamage() : tower->getDamage();
+        view.attack_interval = tower->getAttackInterval();
+        view.attack_radius = tower->getAttackRadius();
     }
 
-    const PathData* path = entity_graph->getPath(from, to);
-    if (path && !path->waypoints.empty()) {
-        auto& troops = global_state->getTroops();
-        troops.push_back(std::make_unique<Troop>(
-            from, to, amount, path->waypoints
-        ));
-        from->setHealth(from->getHealth() - amount);
+    bool own = entity->getSide() == side;
+    view.can_upgrade = own && entity->canUpgrade();
+    view.can_splash = false;
+    view.splash_cost = 0;
+    if (own && view.kind == EntityKind::TOWER) {
+        Tower* tower = static_cast<Tower*>(entity);
+        view.can_splash = tower->canConvertToSplash();
+        view.splash_cost = tower->getSplashCost();
     }
-}
-
-// Βοηθητικές συναρτήσεις για λήψη οντοτήτων
-
-// Λήψη λίστας οντοτήτων του παίκτη
-std::vector<Entity*> AISystem::getPlayerEntities() {
-    std::vector<Entity*> result;
-    auto& entities = global_state->getEntities();
-
-    for (auto& entity : entities) {
-        if (entity->getSide() == Side::PLAYER) {
-            result.push_back(entity.get());
+    for (int i = 0; i < 3; i++) {
+        view.can_cast[i] = false;
+        view.spell_cost[i] = 0;
+    }
+    if (own && view.kind == EntityKind::WIZARD) {
+        Wizard* wizard = static_cast<Wizard*>(entity);
+        for (int i = 0; i < 3; i++) {
+            view.can_cast[i] = wizard->canCastSpell(i);
+            view.spell_cost[i] = wizard->getSpellCost(i);
         }
     }
-    return result;
+
+    // Αποτέλεσμα όλων των troops που έρχονται (από το μητρώο, χωρίς πέρασμα των troops)
+    TroopLedger::Projection projection = global_state->getTroopLedger().project(entity, FLT_MAX);
+    view.projected_side = projection.side;
+    view.projected_health = projection.health;
 }
 
-// Λήψη λίστας ουδετερων οντοτήτων
-std::vector<Entity*> AISystem::getNeutralEntities() {
-    std::vector<Entity*> result;
-    auto& entities = global_state->getEntities();
+// Διαδρομή από την cache (μια θέση που ξαναχρησιμοποιήθηκε από άλλο entity ξεκινά από την αρχή)
+AISystem::CachedRoute& AISystem::cachedRoute(EntityHandle source, EntityHandle target) {
+    long long key = ((long long)source.slot << 32) | (unsigned int)target.slot;
+    CachedRoute& route = route_cache[key];
+    if (route.source != source || route.target != target) {
+        route = CachedRoute();
+        route.source = source;
+        route.target = target;
+    }
+    return route;
+}
 
-    for (auto& entity : entities) {
-        if (entity->getSide() == Side::NEUTRAL) {
-            result.push_back(entity.get());
+// Διαδρομές από κάθε δικό μας entity προς κάθε στόχο (αντιπάλους και ουδέτερα)
+// Ο χρόνος έρχεται από τα waypoints των μονοπατιών του γράφου και η ζημιά από τους πίνακες
+// έκθεσης: ένα πέρασμα από τα διαστήματα κάθε πύργου άλλης πλευράς, χωρίς γεωμετρία
+// Και τα δύο κρατιούνται στην route_cache: ο χρόνος ξαναϋπολογίζεται μόνο όταν αλλάξει το
+// state epoch της πηγής (ταχύτητα troops) ή τα μονοπάτια του γράφου (μετά από αναβάθμιση ή
+// μετατροπή αλλάζουν τα μεγέθη που παρακάμπτουν) και το πέρασμα των πύργων μόνο όταν αλλάξει
+// κάποιος πύργος ή οι πίνακες έκθεσης, οπότε χωρίς αλλαγές κάθε ζεύγος είναι ένα lookup
+void AISystem::fillRoutes(AISnapshot& snapshot) {
+    EntityStore* store = EntityStore::getInstance();
+    int sources = (int)snapshot.own.size();
+    int opponent_count = (int)snapshot.opponents.size();
+    int targets = opponent_count + (int)snapshot.neutral.size();
+    snapshot.routes.assign(sources * targets, AIRoute());
+    if (sources == 0 || targets == 0) return;
+
+    // Ζημιά από πύργους: διάστημα προόδου μέσα στην ακτίνα επί ζημιά ανά δευτερόλεπτο
+    // (διαιρείται με την ταχύτητα κάθε πηγής παρακάτω)
+    unsigned int tower_epoch = store->getKindEpoch(EntityKind::TOWER);
+    unsigned int graph_version = entity_graph->getExposureVersion();
+    unsigned int path_version = entity_graph->getPathVersion();
+    if (exposure_pass == 0 || tower_epoch != exposure_tower_epoch || graph_version != exposure_graph_version) {
+        exposure_pass++;
+        exposure_tower_epoch = tower_epoch;
+        exposure_graph_version = graph_version;
+
+        for (Entity* entity : store->getMembers(EntityKind::TOWER)) {
+            if (entity->getSide() == side) continue;
+
+            Tower* tower = static_cast<Tower*>(entity);
+            const TowerExposure* table = entity_graph->getTowerExposure(tower);
+            if (!table || tower->getAttackInterval() <= 0.0f) continue;
+
+            int damage = tower->isSplash() ? tower->getSplashDamage() : tower->getDamage();
+            float dps = damage / tower->getAttackInterval();
+            for (const EdgeExposure& edge : table->edges) {
+                CachedRoute& route = cachedRoute(edge.from, edge.to);
+                if (route.exposure_pass != exposure_pass) {
+                    route.exposure_pass = exposure_pass;
+                    route.exposed = 0.0f;
+                }
+                route.exposed += (edge.exit - edge.enter) * dps;
+            }
         }
     }
-    return result;
-}
 
-// Λήψη λίστας εχθρικών οντοτητων
-std::vector<Entity*> AISystem::getEnemyEntities() {
-    std::vector<Entity*> result;
-    auto& entities = global_state->getEntities();
+    // Χρόνος διαδρομής (η ταχύτητα των troops μετριέται σε waypoints ανά δευτερόλεπτο)
+    for (int i = 0; i < sources; i++) {
+        EntityHandle source = snapshot.own[i].handle;
+        Entity* from = store->resolve(source);
+        float speed = from ? from->getAttackingSpeed() * 0.2f : 0.0f;
+        if (speed <= 0.0f) continue;
+        unsigned int epoch = store->getStateEpoch(source.slot);
+
+        for (int j = 0; j < targets; j++) {
+            EntityHandle target = (j < opponent_count ? snapshot.opponents[j] : snapshot.neutral[j - opponent_count]).handle;
+            CachedRoute& cached = cachedRoute(source, target);
+            if (cached.source_epoch != epoch || cached.path_version != path_version) {
+                const PathData* path = entity_graph->getPath(from, store->resolve(target));
+                cached.travel = (path && path->waypoints.size() >= 2) ? (path->waypoints.size() - 1) / speed : -1.0f;
+                cached.source_epoch = epoch;
+                cached.path_version = path_version;
+            }
 
-    for (auto& entity : entities) {
-        if (entity->getSide() == Side::ENEMY) {
-            result.push_back(entity.get());
+            AIRoute& route = snapshot.routes[i * targets + j];
+            route.travel = cached.travel;
+            if (cached.travel >= 0.0f && cached.exposure_pass == exposure_pass) route.loss = cached.exposed / speed;
         }
     }
-    return result;
 }
 
-// Εύρεση ασθενέστερης οντότητας του παίκτη
-Entity* AISystem::findWeakestPlayerEntity() {
-    auto player_entities = getPlayerEntities();
-    if (player_entities.empty()) return nullptr;
-
-    Entity* weakest = player_entities[0];
-    for (auto entity : player_entities) {
-        if (entity->getHealth() < weakest->getHealth()) {
-            weakest = entity;
+// Υπολογισμός συνολικής δύναμης
+// Η δύναμη είναι γραμμική ως προς τη ζωή, οπότε αρκούν τα αθροίσματα ζωής του EntityStore
+// ανά είδος και level αντί για πέρασμα από όλα τα entities της πλευράς
+int AISystem::calculateTotalPower(Side side) {
+    EntityStore* store = EntityStore::getInstance();
+    float total_power = 0.0f;
+    for (int k = 0; k < ENTITY_KIND_COUNT; k++) {
+        for (int level = 0; level < EntityStore::LEVEL_COUNT; level++) {
+            // Βασική δύναμη = ζωή
+            float power = static_cast<float>(store->getTotalHealth(side, static_cast<EntityKind>(k), level));
+            total_power += power * AIPlanner::getPowerFactor(static_cast<EntityKind>(k), level);
         }
     }
-    return weakest;
+    return static_cast<int>(total_power);
 }
 
-// Εύρεση κοντινοτερης ουδέτερης οντότητας
-Entity* AISystem::findNearestNeutralEntity(Entity* from) {
-    if (!from) return nullptr;
-
-    auto neutral_entities = getNeutralEntities();
-    if (neutral_entities.empty()) return nullptr;
-
-    Entity* nearest = nullptr;
-    float min_dist = FLT_MAX;
-
-    for (auto entity : neutral_entities) {
-        float dx = entity->getX() - from->getX();
-        float dy = entity->getY() - from->getY();
-        float dist = dx * dx + dy * dy;
-
-        if (dist < min_dist) {
-            min_dist = dist;
-            nearest = entity;
+// Εφαρμογή εντολής στο main thread
+// Ο κόσμος μπορεί να άλλαξε από τη στιγμή της εικόνας, οπότε όλοι οι έλεγχοι γίνονται ξανά
+void AISystem::applyCommand(const AICommand& command) {
+    EntityStore* store = EntityStore::getInstance();
+    Entity* actor = store->resolve(command.actor);
+    if (!actor || actor->getSide() != side) return;
+
+    switch (command.type) {
+    case AICommand::SEND: {
+        Entity* target = store->resolve(command.target);
+        if (!target) return;
+
+        // Αφήνουμε τουλάχιστον 10 ζωή για να μην πεθάνει αμέσως
+        int amount = command.amount;
+        if (actor->getHealth() <= amount + 10) {
+            amount = actor->getHealth() - 10; // Στέλνουμε όσο περισσότερο μπορούμε
+            if (amount < 5) return; // Πολύ λίγο - δεν στέλνουμε
         }
+        global_state->spawnTroop(actor, target, amount);
+        break;
+    }
+    case AICommand::UPGRADE:
+        if (actor->canUpgrade()) {
+            actor->performUpgrade();
+        }
+        break;
+    case AICommand::SPLASH:
+        if (actor->getKind() == EntityKind::TOWER) {
+            Tower* tower = static_cast<Tower*>(actor);
+            if (tower->canConvertToSplash()) tower->convertToSplash();
+        }
+        break;
+    case AICommand::CAST: {
+        Entity* target = store->resolve(command.target);
+        if (!target || target->getSide() != opponent) return;
+        if (actor->getKind() != EntityKind::WIZARD) return;
+
+        Wizard* wizard = static_cast<Wizard*>(actor);
+        int spell_id = command.spell_id;
+        int cost = wizard->getSpellCost(spell_id);
+        if (wizard->canCastSpell(spell_id) && wizard->getHealth() >= cost) {
+            wizard->setHealth(wizard->getHealth() - cost);
+            wizard->castSpell(spell_id, target);
+            global_state->spawnSpellEffect(wizard, target, spell_id);
+        }
+        break;
+    }
+    default:
+        break;
     }
-    return nearest;
 }
 
-// Έλεγχος αν μπορεί να φτάσει από τη μία οντότητα στην άλλη
+// Έλεγχος αν μπορεί να φτάσει από τη μία οντότητα στην άλλη (μόνο από το main thread - ο γράφος δεν είναι στην εικόνα)
 bool AISystem::canReachTarget(Entity* from, Entity* to) {
     if (!from || !to) return false;
 
     const PathData* path = entity_graph->getPath(from, to);
     return path && !path->waypoints.empty();
 }
-
-// Έλεγχος αν οντότητα είναι απειλητική
-bool AISystem::isThreatening(Entity* entity) {
-    if (!entity) return false;
-
-    std::string type = entity->getType();
-    return (type == "Wizard" ||
-        type == "Tower" ||
-        (type == "Warrior" && entity->getLevel() > 1));
-}
\ No newline at end of file
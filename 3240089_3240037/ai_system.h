@@ -1,72 +1,171 @@
 #pragma once
-#include "entity.h"
+#include "ai_planner.h"
 #include "graph.h"
+#include "spsc_queue.h"
+#include "ai_scheduler.h"
+#include "opening_book.h"
 #include <vector>
 #include <memory>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
-// Forward declaration   GlobalState
+// Forward declaration για το GlobalState
 class GlobalState;
 
-//    "AI"  
-//        entities
+// Κλάση για το "AI" μιας πλευράς (προεπιλογή ο εχθρός, με αντίπαλο τον παίκτη)
+// Χειρίζεται τις αποφάσεις και ενέργειες των entities της πλευράς side. Κάθε instance
+// έχει δικό του worker και χρονόμετρα, οπότε μπορούν να παίζουν πολλά στο ίδιο παιχνίδι
+// (π.χ. αυτόματος παίκτης για την πλευρά PLAYER σε αγώνες AI εναντίον AI)
+// Το AISystem είναι η σύνδεση με το παιχνίδι (εικόνες, χρονόμετρα, εφαρμογή εντολών) - ο
+// σχεδιασμός είναι στον AIPlanner. Τρέχει σε δικό του thread: το main thread στέλνει ένα
+// AISnapshot όταν λήξει το χρονόμετρο απόφασης, ο worker το επεξεργάζεται και επιστρέφει
+// εντολές από ουρά χωρίς locks, και το main thread τις ελέγχει ξανά και τις εφαρμόζει στην update
+// Το main thread δεν περιμένει ποτέ τον worker - αν δεν έχει τελειώσει, οι εντολές
+// εφαρμόζονται σε επόμενο frame. Σε σύγχρονη λειτουργία (setAsync(false)) ο ίδιος
+// σχεδιασμός εκτελείται στο main thread, με ντετερμινιστική σειρά, σε βήματα του AIPlanner
+// Σε κάθε tick το AI κάνει στο main thread όσα βήματα χωρούν στο budget του AIScheduler
+// (εφαρμογή εντολών ή αποφάσεις entities) και συνεχίζει τα υπόλοιπα στο επόμενο tick
 class AISystem {
 private:
-    GlobalState* global_state; //     
-    EntityGraph* entity_graph; //    
-
-    //  AI
-    float decision_timer; //    
-    float decision_interval; //    
-    float aggression_level; //   (0.0  1.0)
-
-    //   AI
-    enum class AIStrategy {
-        AGGRESSIVE,     //  
-        DEFENSIVE,      // 
-        EXPANSIVE,      //    
-        MIXED,          //  
-        ADAPTIVE        //  (  )
+    GlobalState* global_state; // Δείκτης σε κεντρική κατάσταση παιχνιδιού
+    EntityGraph* entity_graph; // Δείκτης σε γράφο συνδέσεων
+    Side side;                 // Πλευρά που ελέγχει το AI
+    Side opponent;             // Πλευρά που αντιμετωπίζει (τα υπόλοιπα εκτός από NEUTRAL αγνοούνται)
+
+    static const float SPELL_PLAN_INTERVAL; // Διάστημα σχεδιασμού spells (ανάμεσα στις αποφάσεις)
+    static const size_t COMMAND_CAPACITY = 1024;
+    static const size_t TRACE_QUEUE_CAPACITY = 256;
+
+    // Κατάσταση AI (main thread)
+    TimerHandle decision_timer; // Χρονόμετρο για λήψη αποφάσεων (στο TimerWheel)
+    TimerHandle spell_timer;    // Χρονόμετρο για σχεδιασμό spells
+    bool decision_due; // Αν έληξε το χρονόμετρο (οι αποφάσεις παίρνονται στην update)
+    bool spell_due;
+    bool plan_in_flight; // Ο worker επεξεργάζεται εικόνα (μέχρι την εντολή DONE)
+    float decision_interval; // Χρονικό διάστημα μεταξύ αποφάσεων
+    bool async; // Σχεδιασμός σε ξεχωριστό thread
+    float search_budget_ms; // Χρόνος αναζήτησης ανά απόφαση (περνά στην εικόνα)
+    AIScheduler scheduler; // Budget της δουλειάς του AI ανά tick
+    float last_tick_us; // Δουλειά του AI στο main thread στο τελευταίο tick
+
+    // Βιβλίο ανοιγμάτων: αποστολές σε χρόνους από την αρχή του level, πριν από την πρώτη απόφαση
+    struct OpeningStep {
+        float time;
+        AICommand command;
     };
+    std::vector<OpeningStep> opening;
+    size_t opening_next;       // Επόμενη αποστολή του ανοίγματος
+    float opening_end;         // Χρόνος της τελευταίας αποστολής, όπου αρχίζουν οι αποφάσεις (0: χωρίς άνοιγμα)
+    double opening_start;      // Χρόνος του TimerWheel στο init
+    TimerHandle opening_timer;
+    bool opening_due;
+
+    // Σχεδιασμός: στον worker ή, σε σύγχρονη λειτουργία, σε βήματα στο main thread
+    AIPlanner planner;
+    bool sync_active;       // Σύγχρονο σχέδιο σε εξέλιξη
+    size_t sync_applied;    // Εντολές του sync_plan που έχουν εφαρμοστεί
+
+    // Επικοινωνία με τον worker
+    SpscQueue<std::unique_ptr<AISnapshot>, 2> snapshots;   // main -> worker
+    SpscQueue<std::unique_ptr<AISnapshot>, 2> recycled;    // worker -> main (επαναχρησιμοποίηση)
+    SpscQueue<AICommand, COMMAND_CAPACITY> commands;       // worker -> main
+    std::thread worker;
+    std::mutex wake_mutex; // Μόνο για το ξύπνημα του worker (το main thread δεν περιμένει ποτέ)
+    std::condition_variable wake;
+    std::atomic<bool> stopping;
+    std::vector<AICommand> worker_plan;
+    std::unique_ptr<AISnapshot> spare; // Εικόνα για επαναχρησιμοποίηση στο main thread
+    std::vector<AICommand> sync_plan;
+    std::unique_ptr<AISnapshot> sync_snapshot; // Εικόνα του σύγχρονου σχεδίου σε εξέλιξη
+
+    // Ίχνος αποφάσεων (nullptr: ανενεργό). Γράφεται μόνο στο main thread - οι εγγραφές του
+    // σχεδιασμού στον worker περνούν από την trace_queue και μεταφέρονται στην update
+    AITrace* trace;
+    SpscQueue<AITraceRecord, TRACE_QUEUE_CAPACITY> trace_queue;  // worker -> main
+    std::atomic<unsigned int> trace_lost;  // Εγγραφές του worker που δεν χώρεσαν στην ουρά
+
+    // Cache διαδρομών (main thread) ανά ζεύγος θέσεων πηγής - στόχου, με τα epochs του EntityStore
+    struct CachedRoute {
+        EntityHandle source;
+        EntityHandle target;
+        unsigned int source_epoch = 0;   // State epoch της πηγής στον υπολογισμό του travel (0: δεν υπολογίστηκε)
+        unsigned int path_version = 0;   // Έκδοση των μονοπατιών του γράφου στον υπολογισμό του travel
+        unsigned int exposure_pass = 0;  // Πέρασμα των πύργων που έγραψε το exposed
+        float travel = -1.0f;
+        float exposed = 0.0f;            // Σ διάστημα έκθεσης x ζημιά ανά δευτερόλεπτο (πριν τη διαίρεση με την ταχύτητα)
+    };
+    std::unordered_map<long long, CachedRoute> route_cache;
+    unsigned int exposure_pass;          // Τρέχον πέρασμα των πύργων (0: κανένα)
+    unsigned int exposure_tower_epoch;   // Epoch των πύργων και έκδοση των πινάκων έκθεσης στο πέρασμα
+    unsigned int exposure_graph_version;
+
+    // Main thread
+    void scheduleDecision(float delay);
+    void scheduleOpening();
+    void playOpening();
+    void scheduleSpellPlan();
+    void requestPlan();
+    std::unique_ptr<AISnapshot> takeSnapshot(bool decide);
+    void fillView(AIEntityView& view, Entity* entity);
+    void fillRoutes(AISnapshot& snapshot);
+    CachedRoute& cachedRoute(EntityHandle source, EntityHandle target);
+    int calculateTotalPower(Side side);
+    void applyCommand(const AICommand& command);
+    void startWorker();
+    void stopWorker();
+    void workerLoop();
+    void traceTick(int applied, bool worked);
 
-    AIStrategy strategy; //  
-
-    //    
-    void analyzeGameState();
-    void makeStrategicDecisions();
-    int calculateTotalPower(const std::vector<Entity*>& entities);
-
-    //  
-    void executeAggressiveStrategy();
-    void executeDefensiveStrategy();
-    void executeExpansiveStrategy();
-    void executeMixedStrategy();
-    void executeAdaptiveStrategy();
-
-    //  
-    void attackWeakestPlayerTarget(Entity* attacker);
-    void attackStrategicTarget(Entity* attacker);
-    void convertNearestNeutral(Entity* converter);
-    void sendTroops(Entity* from, Entity* to, int amount);
-    int calculateOptimalTroopSize(Entity* attacker);
-
-    //  spells  Wizards
-    void castEnemySpells();
-    void castSmartSpell(Wizard* wizard);
-    float evaluateSpellValue(Wizard* wizard, int spell_id, Entity* target);
-    bool isThreatening(Entity* entity);
-
-    //  
-    Entity* findWeakestPlayerEntity();
-    Entity* findStrategicPlayerTarget();
-    Entity* findMostThreateningPlayerEntity();
-    Entity* findNearestNeutralEntity(Entity* from);
-    std::vector<Entity*> getPlayerEntities();
-    std::vector<Entity*> getNeutralEntities();
-    std::vector<Entity*> getEnemyEntities();
+    void stepSyncPlan(bool budgeted); // Βήματα του σύγχρονου σχεδίου (όλα αν budgeted = false)
     bool canReachTarget(Entity* from, Entity* to);
 
 public:
-    AISystem(GlobalState* gs, EntityGraph* graph); // Constructor
-    void update(float dt); //  AI
-    void init(); //  AI  frame
-};
\ No newline at end of file
+    // Constructor (με run_async ξεκινά και τον worker του σχεδιασμού)
+    AISystem(GlobalState* gs, EntityGraph* graph, Side controlled = Side::ENEMY, Side opposing = Side::PLAYER, bool run_async = true);
+    ~AISystem(); // Destructor (τερματισμός worker και ακύρωση χρονομέτρων)
+    void update(float dt); // Ενημέρωση AI κάθε frame
+    void init(); // Αρχικοποίηση AI
+
+    Side getSide() const { return side; }
+    Side getOpponent() const { return opponent; }
+
+    // Σχεδιασμός σε ξεχωριστό thread (προεπιλογή) ή σύγχρονα στο main thread
+    void setAsync(bool enabled);
+    bool isAsync() const { return async; }
+
+    // Αντίπαλος με αναζήτηση: οι αποστολές troops επιλέγονται με MCTS μέσα σε budget_ms
+    // ανά απόφαση (μεγαλύτερο budget - δυσκολότερος αντίπαλος). 0: μόνο οι κανόνες ποσοστών
+    void setSearchBudget(float budget_ms) { search_budget_ms = budget_ms; }
+    float getSearchBudget() const { return search_budget_ms; }
+
+    // Policy για τις αποστολές troops (nullptr: οι κανόνες της στρατηγικής). Χρησιμοποιείται
+    // όταν δεν υπάρχει budget αναζήτησης. Ο worker σταματά για την αλλαγή και ξαναξεκινά
+    void setPolicy(std::unique_ptr<AIPolicy> new_policy);
+    const AIPolicy* getPolicy() const { return planner.getPolicy(); }
+
+    // Παράμετροι των αποφάσεων (π.χ. από αρχείο του tuner). Ορίζουν και την policy: LinearPolicy
+    // με τα βάρη τους αν έχουν use_policy, αλλιώς οι κανόνες της στρατηγικής
+    void setParams(const AIParams& new_params);
+    const AIParams& getParams() const { return planner.getParams(); }
+
+    void seed(unsigned int s); // Ντετερμινιστικός σχεδιασμός (rng και αναζήτηση)
+
+    // Άνοιγμα από το βιβλίο (πριν από την init). layout: τα handles των entities του level
+    // με τη σειρά δημιουργίας. Αν μια αποστολή δεν είναι πια δυνατή (η πηγή χάθηκε), το
+    // άνοιγμα εγκαταλείπεται και το AI αποφασίζει αμέσως
+    void setOpening(const OpeningLine& line, const std::vector<EntityHandle>& layout);
+    bool isInOpening() const { return opening_next < opening.size(); }
+
+    // Ίχνος αποφάσεων (nullptr: ανενεργό). Ο worker σταματά για την αλλαγή, όπως στη setPolicy
+    void setTrace(AITrace* new_trace);
+    void flushTrace(); // Μεταφορά των εγγραφών του worker στο ίχνος (πριν από dump)
+
+    // Μικροδευτερόλεπτα ανά tick για τη δουλειά του AI στο main thread (0: χωρίς όριο)
+    void setTickBudget(float budget_us) { scheduler.setBudget(budget_us); }
+    float getTickBudget() const { return scheduler.getBudget(); }
+    const AIScheduler& getScheduler() const { return scheduler; }
+    float getLastTickUs() const { return last_tick_us; } // Χρόνος της τελευταίας update (ίδιος με το cost_us του TICK)
+};
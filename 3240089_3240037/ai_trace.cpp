@@ -0,0 +1,81 @@
+﻿#include "ai_trace.h"
+#include "binary_io.h"
+#include <algorithm>
+#include <fstream>
+
+const unsigned int AITrace::DEFAULT_CAPACITY = 16384;   // 512 KB
+const unsigned char AITrace::VERSION = 1;
+
+static const char TRACE_MAGIC[4] = { 'J', 'G', 'A', 'T' };
+
+// Constructor (ανενεργό μέχρι την enable)
+AITrace::AITrace() : mask(0), written(0), dropped(0), start(Clock::now()) {}
+
+void AITrace::enable(unsigned int capacity) {
+    unsigned int size = 0;
+    if (capacity > 0) {
+        size = 1;
+        while (size < capacity) size <<= 1;
+    }
+    records.assign(size, AITraceRecord());
+    mask = size ? size - 1 : 0;
+    written = 0;
+    dropped = 0;
+    start = Clock::now();
+}
+
+void AITrace::clear() {
+    written = 0;
+    dropped = 0;
+}
+
+unsigned long long AITrace::getCount() const {
+    return written < records.size() ? written : records.size();
+}
+
+// Ακέραιοι little-endian στην κεφαλίδα (binary_io.h) - οι εγγραφές γράφονται όπως είναι στη μνήμη
+bool AITrace::dump(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    unsigned long long count = getCount();
+    file.write(TRACE_MAGIC, 4);
+    writeValue(file, VERSION, 1);
+    writeValue(file, (unsigned int)sizeof(AITraceRecord), 1);
+    writeValue(file, (unsigned int)count, 4);
+    writeValue(file, (unsigned int)(dropped > 0xFFFFFFFFull ? 0xFFFFFFFFull : dropped), 4);
+
+    // Από την παλαιότερη εγγραφή: αν ο buffer γέμισε είναι αυτή στη θέση της επόμενης εγγραφής
+    for (unsigned long long i = written - count; i < written; i++) {
+        file.write(reinterpret_cast<const char*>(&records[i & mask]), sizeof(AITraceRecord));
+    }
+    return (bool)file;
+}
+
+bool AITrace::load(const std::string& path, std::vector<AITraceRecord>& out, unsigned long long& dropped_count) {
+    out.clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    char magic[4];
+    unsigned int version, size, count, lost;
+    if (!file.read(magic, 4) || !std::equal(magic, magic + 4, TRACE_MAGIC)) return false;
+    if (!readValue(file, version, 1) || version != VERSION) return false;
+    if (!readValue(file, size, 1) || size != sizeof(AITraceRecord)) return false;
+    if (!readValue(file, count, 4) || !readValue(file, lost, 4)) return false;
+
+    // Το πλήθος ελέγχεται με το μέγεθος του αρχείου πριν από τη δέσμευση (κατεστραμμένη κεφαλίδα)
+    std::streamoff header = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff available = file.tellg() - header;
+    file.seekg(header);
+    if (!file || (unsigned long long)count > (unsigned long long)available / sizeof(AITraceRecord)) return false;
+
+    out.resize(count);
+    if (count > 0 && !file.read(reinterpret_cast<char*>(out.data()), count * sizeof(AITraceRecord))) {
+        out.clear();
+        return false;
+    }
+    dropped_count = lost;
+    return true;
+}
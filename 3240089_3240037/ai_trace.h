@@ -0,0 +1,89 @@
+﻿#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Εγγραφή του ίχνους αποφάσεων του AI (32 bytes, αντιγράφεται αυτούσια στο αρχείο)
+// Τα πεδία σημαίνουν άλλα πράγματα ανά είδος:
+//   PLAN:      detail = στρατηγική, flags, amount = εντολές, candidates = δικά entities,
+//              score = επιθετικότητα, runner_up = δική δύναμη / δύναμη αντιπάλου, cost_us = σχεδιασμός
+//   SEND/UPGRADE/SPLASH/CAST: detail = προέλευση, actor/target = θέσεις στο EntityStore,
+//              amount = troops (spell για CAST), score = βαθμολογία της επιλογής, runner_up = του
+//              καλύτερου άλλου στόχου, candidates = στόχοι που εξετάστηκαν
+//   SNAPSHOT:  amount = entities, candidates = troops σε κίνηση, flags, cost_us = λήψη της εικόνας
+//   TICK:      amount = εντολές που εφαρμόστηκαν, flags, cost_us = δουλειά του AI στο tick
+struct AITraceRecord {
+    enum Type : unsigned char { PLAN, SEND, UPGRADE, SPLASH, CAST, SNAPSHOT, TICK };
+    enum Origin : unsigned char { RULE, POLICY, SEARCH, OPENING };
+    enum Flags : unsigned char {
+        DECIDE = 1,       // Πλήρης απόφαση (αλλιώς μόνο spells)
+        SEARCHED = 2,     // Με αναζήτηση
+        WITH_POLICY = 4,  // Με policy
+        SPILLED = 8       // Η δουλειά του tick συνέχισε στο επόμενο
+    };
+
+    unsigned int time_us = 0;  // Από την ενεργοποίηση του ίχνους (για τις εντολές: η αρχή του σχεδιασμού)
+    unsigned char type = PLAN;
+    unsigned char side = 0;
+    unsigned char detail = 0;
+    unsigned char flags = 0;
+    short actor = -1;
+    short target = -1;
+    int amount = 0;
+    float score = 0.0f;
+    float runner_up = 0.0f;
+    float cost_us = 0.0f;
+    unsigned short candidates = 0;
+    unsigned short plan = 0;   // Αύξων αριθμός σχεδιασμού της πλευράς (συνδέει εντολές και PLAN)
+};
+static_assert(sizeof(AITraceRecord) == 32, "AITraceRecord is written to files as is");
+
+// Ίχνος αποφάσεων του AI: κυκλικός buffer σταθερού μεγέθους με τις τελευταίες εγγραφές
+// Η εγγραφή είναι μια αντιγραφή 32 bytes χωρίς δέσμευση μνήμης ή locks, οπότε μπορεί να
+// μένει ενεργό και στο κανονικό παιχνίδι. Γράφεται μόνο από το main thread - ο worker του
+// AI στέλνει τις δικές του εγγραφές με ουρά (όπως τις εντολές) και το AISystem τις περνά εδώ
+// Με capacity 0 είναι ανενεργό. Το dump γράφει τις εγγραφές από την παλαιότερη στη νεότερη:
+// "JGAT", έκδοση (1 byte), μέγεθος εγγραφής (1), πλήθος (4), χαμένες (4) και οι εγγραφές
+class AITrace {
+public:
+    typedef std::chrono::steady_clock Clock;
+    static const unsigned int DEFAULT_CAPACITY;  // Εγγραφές (δύναμη του 2)
+
+private:
+    static const unsigned char VERSION;
+
+    std::vector<AITraceRecord> records;
+    unsigned int mask;
+    unsigned long long written;               // Εγγραφές από την αρχή (η επόμενη θέση είναι written & mask)
+    unsigned long long dropped;               // Εγγραφές του worker που δεν χώρεσαν στην ουρά
+    Clock::time_point start;
+
+public:
+    AITrace();
+
+    // Ενεργοποίηση με capacity εγγραφές (στρογγυλεύεται σε δύναμη του 2) - 0: απενεργοποίηση
+    void enable(unsigned int capacity = DEFAULT_CAPACITY);
+    bool isEnabled() const { return !records.empty(); }
+
+    void record(const AITraceRecord& entry) { records[written++ & mask] = entry; }
+    void addDropped(unsigned long long count) { dropped += count; }
+
+    // Μικροδευτερόλεπτα από την ενεργοποίηση (ασφαλές από κάθε thread)
+    unsigned int nowUs() const {
+        return (unsigned int)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+    }
+
+    // Χρόνος που πέρασε από το since (για τα cost_us)
+    static float elapsedUs(Clock::time_point since) {
+        return std::chrono::duration<float, std::micro>(Clock::now() - since).count();
+    }
+
+    void clear();
+    unsigned long long getCount() const;      // Εγγραφές μέσα στον buffer
+    unsigned long long getDropped() const { return dropped; }
+
+    bool dump(const std::string& path) const;
+
+    // Ανάγνωση αρχείου του dump (για εργαλεία) - false αν δεν είναι έγκυρο
+    static bool load(const std::string& path, std::vector<AITraceRecord>& out, unsigned long long& dropped_count);
+};
@@ -0,0 +1,192 @@
+﻿#include "ai_utility.h"
+#include "ai_planner.h"
+#include "simd.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+const int AIUtility::AMOUNT_OPTIONS;
+const float AIUtility::NO_SCORE = -FLT_MAX;
+const float AIUtility::AMOUNT_FRACTIONS[AMOUNT_OPTIONS] = { 0.35f, 0.7f, 1.0f };
+const int AIUtility::MIN_SEND = 5;
+const int AIUtility::MAX_SEND = 100;
+const int AIUtility::RESERVE = 10;
+const float AIUtility::TIME_DISCOUNT = 0.1f;
+const float AIUtility::NEUTRAL_PROGRESS_WEIGHT = 0.5f;
+const int AIUtility::CAPTURE_MARGIN = 2;
+
+// Constructor
+AIUtility::AIUtility() : source_count(0), target_count(0), opponent_count(0), stride(0) {}
+
+// Ποσότητες αποστολής μιας πηγής (αφήνοντας RESERVE ζωή, μέχρι MAX_SEND)
+void AIUtility::computeAmounts(int source) {
+    float available = std::min((float)MAX_SEND, source_health[source] - RESERVE);
+    for (int k = 0; k < AMOUNT_OPTIONS; k++) {
+        float amount = (float)(int)(available * AMOUNT_FRACTIONS[k]);
+        amounts[source * AMOUNT_OPTIONS + k] = amount >= MIN_SEND ? amount : 0.0f;
+    }
+}
+
+// Γέμισμα των πινάκων από την εικόνα
+void AIUtility::build(const AISnapshot& snapshot, const std::vector<float>& values) {
+    source_count = (int)snapshot.own.size();
+    opponent_count = (int)snapshot.opponents.size();
+    target_count = opponent_count + (int)snapshot.neutral.size();
+    stride = (target_count + 3) & ~3;
+
+    source_health.resize(source_count);
+    amounts.resize(source_count * AMOUNT_OPTIONS);
+    for (int i = 0; i < source_count; i++) {
+        source_health[i] = (float)snapshot.own[i].health;
+        computeAmounts(i);
+    }
+
+    // Οι θέσεις του padding μένουν κλειστές (target_open = 0) και δεν επιλέγονται ποτέ
+    target_health.assign(stride, 0.0f);
+    target_max_health.assign(stride, 0.0f);
+    target_healing.assign(stride, 0.0f);
+    target_defense.assign(stride, 0.0f);
+    target_value.assign(stride, 0.0f);
+    target_opponent.assign(stride, 0.0f);
+    target_open.assign(stride, 0.0f);
+    for (int j = 0; j < target_count; j++) {
+        bool opponent = j < opponent_count;
+        const AIEntityView& view = opponent ? snapshot.opponents[j] : snapshot.neutral[j - opponent_count];
+        target_health[j] = (float)view.projected_health;
+        target_max_health[j] = (float)view.max_health;
+        target_healing[j] = view.projected_side != Side::NEUTRAL ? view.healing_speed : 0.0f;  // Τα ουδέτερα δεν θεραπεύονται
+        target_defense[j] = view.defense;
+        target_value[j] = values[j];
+        target_opponent[j] = opponent ? 1.0f : 0.0f;
+        target_open[j] = view.projected_side != snapshot.side ? 1.0f : 0.0f;
+    }
+
+    travel.assign(source_count * stride, -1.0f);
+    loss.assign(source_count * stride, 0.0f);
+    for (int i = 0; i < source_count; i++) {
+        for (int j = 0; j < target_count; j++) {
+            const AIRoute& route = snapshot.routes[i * target_count + j];
+            travel[i * stride + j] = route.travel;
+            loss[i * stride + j] = route.loss;
+        }
+    }
+
+    scores.resize(source_count * AMOUNT_OPTIONS * stride);
+    evaluate();
+}
+
+// Μία γραμμή του πίνακα (4 στόχοι ανά εντολή SSE)
+void AIUtility::evaluateRow(int source, int option) {
+    float* out = &scores[(source * AMOUNT_OPTIONS + option) * stride];
+    float amount = amounts[source * AMOUNT_OPTIONS + option];
+    if (amount <= 0.0f) {
+        std::fill(out, out + stride, NO_SCORE);
+        return;
+    }
+
+    const float* route_travel = &travel[source * stride];
+    const float* route_loss = &loss[source * stride];
+    int j = 0;
+
+#ifdef USE_SSE
+    const __m128 amount4 = _mm_set1_ps(amount);
+    const __m128 zero4 = _mm_setzero_ps();
+    const __m128 one4 = _mm_set1_ps(1.0f);
+    const __m128 discount4 = _mm_set1_ps(TIME_DISCOUNT);
+    const __m128 progress4 = _mm_set1_ps(NEUTRAL_PROGRESS_WEIGHT);
+    const __m128 none4 = _mm_set1_ps(NO_SCORE);
+    for (; j < stride; j += 4) {
+        __m128 t = _mm_loadu_ps(route_travel + j);
+        __m128 health = _mm_loadu_ps(&target_health[j]);
+
+        // Ζωή του στόχου στην άφιξη (healing μέχρι το μέγιστο, χωρίς να μειωθεί αν είναι ήδη πάνω από αυτό)
+        __m128 healed = _mm_add_ps(health, _mm_mul_ps(_mm_loadu_ps(&target_healing[j]), t));
+        __m128 need = _mm_max_ps(health, _mm_min_ps(healed, _mm_loadu_ps(&target_max_health[j])));
+        need = _mm_max_ps(need, zero4);
+
+        // Ζημιά που φτάνει (μετά τις βολές πύργων και την άμυνα) - τουλάχιστον 1 αν φτάσει κάτι,
+        // όπως στην handleTroopArrivals
+        __m128 arrive = _mm_max_ps(_mm_sub_ps(amount4, _mm_loadu_ps(route_loss + j)), zero4);
+        __m128 damage = _mm_max_ps(_mm_sub_ps(arrive, _mm_loadu_ps(&target_defense[j])), one4);
+        damage = _mm_and_ps(_mm_cmpgt_ps(arrive, zero4), damage);
+        __m128 taken = _mm_min_ps(damage, need);
+
+        // Ζημιά σε στόχο του αντιπάλου μετράει πλήρως, σε ουδέτερο μόνο ως πρόοδος
+        __m128 opponent = _mm_loadu_ps(&target_opponent[j]);
+        __m128 weight = _mm_add_ps(opponent, _mm_mul_ps(_mm_sub_ps(one4, opponent), progress4));
+        __m128 u = _mm_sub_ps(_mm_mul_ps(taken, weight), amount4);
+
+        // Κατάληψη: αξία του στόχου και ό,τι περισσεύει
+        __m128 captured = _mm_cmpgt_ps(damage, need);
+        __m128 bonus = _mm_add_ps(_mm_loadu_ps(&target_value[j]), _mm_sub_ps(damage, need));
+        u = _mm_add_ps(u, _mm_and_ps(captured, bonus));
+
+        // Τα κέρδη μειώνονται με τον χρόνο διαδρομής (οι ζημιές όχι)
+        __m128 discounted = _mm_div_ps(u, _mm_add_ps(one4, _mm_mul_ps(t, discount4)));
+        __m128 positive = _mm_cmpgt_ps(u, zero4);
+        u = _mm_or_ps(_mm_and_ps(positive, discounted), _mm_andnot_ps(positive, u));
+
+        // Στόχοι χωρίς μονοπάτι ή κλειστοί
+        __m128 valid = _mm_and_ps(_mm_cmpge_ps(t, zero4), _mm_cmpgt_ps(_mm_loadu_ps(&target_open[j]), zero4));
+        _mm_storeu_ps(out + j, _mm_or_ps(_mm_and_ps(valid, u), _mm_andnot_ps(valid, none4)));
+    }
+#endif
+
+    // Υπόλοιπα (ή όλα, χωρίς SSE)
+    for (; j < stride; j++) {
+        float t = route_travel[j];
+        if (t < 0.0f || target_open[j] <= 0.0f) {
+            out[j] = NO_SCORE;
+            continue;
+        }
+
+        float health = target_health[j];
+        float need = std::max(0.0f, std::max(health, std::min(health + target_healing[j] * t, target_max_health[j])));
+        float arrive = std::max(0.0f, amount - route_loss[j]);
+        float damage = arrive > 0.0f ? std::max(1.0f, arrive - target_defense[j]) : 0.0f;
+        float taken = std::min(damage, need);
+
+        float weight = target_opponent[j] + (1.0f - target_opponent[j]) * NEUTRAL_PROGRESS_WEIGHT;
+        float u = taken * weight - amount;
+        if (damage > need) u += target_value[j] + (damage - need);
+        if (u > 0.0f) u /= 1.0f + t * TIME_DISCOUNT;
+        out[j] = u;
+    }
+}
+
+// Υπολογισμός ολόκληρου του πίνακα
+void AIUtility::evaluate() {
+    if (stride == 0) return;  // Κανένας στόχος
+    for (int i = 0; i < source_count; i++) {
+        for (int k = 0; k < AMOUNT_OPTIONS; k++) {
+            evaluateRow(i, k);
+        }
+    }
+}
+
+// Η κατάληψη απαιτεί damage > need (όπως στην evaluateRow) - με need κάτω από 1 αρκεί να
+// φτάσει ένα troop, αφού η ζημιά είναι τουλάχιστον 1
+int AIUtility::getCaptureAmount(int source, int target) const {
+    if (source < 0 || source >= source_count || target < 0 || target >= target_count) return 0;
+    float t = travel[source * stride + target];
+    if (t < 0.0f || target_open[target] <= 0.0f) return 0;
+
+    float health = target_health[target];
+    float need = std::max(0.0f, std::max(health, std::min(health + target_healing[target] * t, target_max_health[target])));
+    float required = need < 1.0f ? 0.0f : need + target_defense[target];
+    return (int)std::floor(required + loss[source * stride + target]) + 1 + CAPTURE_MARGIN;
+}
+
+// Δέσμευση αποστολής
+void AIUtility::commit(int source, int target, int amount) {
+    if (source < 0 || source >= source_count || target < 0 || target >= target_count) return;
+
+    source_health[source] -= amount;
+    computeAmounts(source);
+
+    float arrive = std::max(0.0f, amount - loss[source * stride + target]);
+    if (arrive > 0.0f) target_health[target] -= std::max(1.0f, arrive - target_defense[target]);
+    if (target_health[target] < 0.0f) target_open[target] = 0.0f;
+
+    evaluate();
+}
@@ -0,0 +1,74 @@
+﻿#pragma once
+#include <vector>
+
+struct AISnapshot;
+
+// Πίνακας χρησιμότητας (utility) για τις αποστολές troops του AI
+// Γραμμές: κάθε entity της πλευράς του AI με AMOUNT_OPTIONS ποσότητες αποστολής, στήλες: κάθε
+// στόχος (πρώτα του αντιπάλου και μετά τα ουδέτερα, με τη σειρά της εικόνας). Η αξία μιας αποστολής
+// είναι η αλλαγή υλικού σε μονάδες ζωής: ό,τι στέλνεται χάνεται από την πηγή, ό,τι φτάνει
+// (μετά τις απώλειες από πύργους και την άμυνα) αφαιρείται από τον στόχο, και η κατάληψη
+// προσθέτει την αξία του στόχου και ό,τι περισσεύει. Η ζωή του στόχου προβλέπεται για τη
+// στιγμή της άφιξης (healing στη διάρκεια της διαδρομής) και τα κέρδη μειώνονται με τον χρόνο
+// Η ζωή και η πλευρά των στόχων είναι αυτές μετά τα troops που ήδη ταξιδεύουν (TroopLedger):
+// στόχοι που θα καταληφθούν από αυτά δεν δέχονται νέες αποστολές
+// Οι στήλες είναι σε SoA πίνακες με padding σε πολλαπλάσιο του 4, ώστε κάθε γραμμή να
+// υπολογίζεται με SSE - ολόκληρος ο πίνακας είναι ένα πέρασμα ανά απόφαση
+class AIUtility {
+public:
+    static const int AMOUNT_OPTIONS = 3;
+    static const float NO_SCORE;             // Αξία για στόχους που δεν μπορούν να δεχτούν αποστολή
+
+private:
+    static const float AMOUNT_FRACTIONS[AMOUNT_OPTIONS]; // Ποσοστά της διαθέσιμης ζωής
+    static const int MIN_SEND;               // Ίδια όρια με το AISystem::sendTroops
+    static const int MAX_SEND;
+    static const int RESERVE;
+    static const float TIME_DISCOUNT;        // Μείωση των κερδών ανά δευτερόλεπτο διαδρομής
+    static const float NEUTRAL_PROGRESS_WEIGHT; // Αξία ζημιάς σε ουδέτερο που δεν καταλαμβάνεται
+    static const int CAPTURE_MARGIN;         // Περιθώριο της ακριβούς ποσότητας κατάληψης (στρογγυλέματα ζημιάς)
+
+    int source_count;
+    int target_count;
+    int opponent_count;                      // Οι πρώτοι opponent_count στόχοι είναι του αντιπάλου
+    int stride;                              // target_count στρογγυλεμένο στο 4
+
+    std::vector<float> source_health;
+    std::vector<float> amounts;              // [source * AMOUNT_OPTIONS + option] (0: καμία αποστολή)
+
+    // Στόχοι (SoA)
+    std::vector<float> target_health;
+    std::vector<float> target_max_health;
+    std::vector<float> target_healing;
+    std::vector<float> target_defense;
+    std::vector<float> target_value;
+    std::vector<float> target_opponent;      // 1 για στόχους του αντιπάλου
+    std::vector<float> target_open;          // 0 αν οι αποστολές που δεσμεύτηκαν αρκούν για κατάληψη
+
+    // Διαδρομές [source * stride + target] (travel < 0: δεν υπάρχει μονοπάτι)
+    std::vector<float> travel;
+    std::vector<float> loss;
+
+    std::vector<float> scores;               // [(source * AMOUNT_OPTIONS + option) * stride + target]
+
+    void computeAmounts(int source);
+    void evaluateRow(int source, int option);
+
+public:
+    AIUtility();
+
+    // Γέμισμα από εικόνα απόφασης - values: αξία κατάληψης κάθε στόχου (με τη σειρά των στηλών)
+    void build(const AISnapshot& snapshot, const std::vector<float>& values);
+    void evaluate();
+
+    // Δέσμευση αποστολής: η πηγή χάνει amount, ο στόχος τη ζημιά που θα δεχτεί (και ο πίνακας ξαναϋπολογίζεται)
+    void commit(int source, int target, int amount);
+
+    float getScore(int source, int option, int target) const { return scores[(source * AMOUNT_OPTIONS + option) * stride + target]; }
+    int getAmount(int source, int option) const { return (int)amounts[source * AMOUNT_OPTIONS + option]; }
+    // Ποσότητα που μόλις καταλαμβάνει τον στόχο στην άφιξη από την πηγή (0: χωρίς μονοπάτι ή κλειστός στόχος)
+    int getCaptureAmount(int source, int target) const;
+    int getSourceCount() const { return source_count; }
+    int getTargetCount() const { return target_count; }
+    int getOpponentCount() const { return opponent_count; }
+};
@@ -0,0 +1,23 @@
+﻿#pragma once
+#include <cstdio>
+#include <istream>
+#include <ostream>
+
+// Ακέραιοι little-endian στα δυαδικά αρχεία (ίδιο αρχείο σε κάθε πλατφόρμα)
+// Κοινά για το βιβλίο ανοιγμάτων και το ίχνος αποφάσεων του AI
+
+inline void writeValue(std::ostream& out, unsigned int value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out.put((char)((value >> (8 * i)) & 0xFF));
+    }
+}
+
+inline bool readValue(std::istream& in, unsigned int& value, int bytes) {
+    value = 0;
+    for (int i = 0; i < bytes; i++) {
+        int c = in.get();
+        if (c == EOF) return false;
+        value |= (unsigned int)(c & 0xFF) << (8 * i);
+    }
+    return true;
+}
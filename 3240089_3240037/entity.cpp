@@ -1,10 +1,12 @@
 #include "entity.h"
 #include "troop.h"
+#include "particle_system.h"
+#include "status_effects.h"
 #include "sgg/graphics.h"
 #include <string>
 #include <cmath>
 
-//A 
+//Aρχικοποίηση σταθερών
 
 // Baby
 const float Baby::BABY_SIZE = 0.4f;
@@ -27,6 +29,11 @@ const int Tower::TOWER_ATTACKING_SPEED = 30;
 const float Tower::TOWER_ATTACK_RADIUS = 2.0f;
 const int Tower::TOWER_DAMAGE = 2;
 const float Tower::TOWER_ATTACK_INTERVAL_BASE = 0.5f;
+const int Tower::SPLASH_UNLOCK_LEVEL = 3;
+const int Tower::SPLASH_COST = 15;
+const float Tower::SPLASH_RADIUS = 0.8f;
+const int Tower::SPLASH_DAMAGE = 2;
+const float Tower::SPLASH_INTERVAL_FACTOR = 1.5f;
 
 // Wizard
 const float Wizard::WIZARD_SIZE = 1.2f;
@@ -39,75 +46,62 @@ const int Wizard::FREEZE_COST = 25;
 const int Wizard::SICKNESS_COST = 30;
 const int Wizard::CONVERT_COST = 50;
 
-//  Entity
-//Constructor
-Entity::Entity(float x, float y, int health, Side side)
-    : Node(x, y), health(health), side(side), timer(1.0f),
-    size(0.0f), selected(false), max_health(0), level(0),
-    healing_speed(0.0f), defense(0.0f), attacking_speed(0),
-    is_sick(false), original_max_health(0) {
+// Υλοποίηση Entity
+//Constructor (δέσμευση νέας θέσης στο EntityStore)
+Entity::Entity(float x, float y, int health, Side side, EntityKind kind)
+    : Node(x, y),
+    slot(EntityStore::getInstance()->allocate(this, kind, side, x, y, health)),
+    block(EntityStore::getInstance()->blockOf(slot)), lane(EntityStore::laneOf(slot)),
+    side(block.side[lane]), kind(kind),
+    size(block.size[lane]), selected(false), max_health(block.max_health[lane]),
+    healing_speed(block.healing_speed[lane]), attacking_speed(0), defense(0.0f), level(block.level[lane]),
+    is_sick(block.sick[lane]), original_max_health(block.original_max_health[lane]) {
 }
 
-//        ( )
-bool Entity::contains(float mx, float my) const {
-    float dx = mx - x;
-    float dy = my - y;
-    return (dx * dx + dy * dy) <= (size * size);
+//Constructor μετατροπής (ίδια θέση, νέο είδος - η θέση και η πλευρά διατηρούνται)
+Entity::Entity(Entity& previous, int health, EntityKind kind)
+    : Node(previous.x, previous.y),
+    slot(previous.slot), block(previous.block), lane(previous.lane),
+    side(block.side[lane]), kind(kind),
+    size(block.size[lane]), selected(false), max_health(block.max_health[lane]),
+    healing_speed(block.healing_speed[lane]), attacking_speed(0), defense(0.0f), level(block.level[lane]),
+    is_sick(block.sick[lane]), original_max_health(block.original_max_health[lane]) {
+    previous.slot = -1;  // Η θέση δεν αποδεσμεύεται όταν καταστραφεί το παλιό entity
+    StatusEffects::getInstance()->removeAll(slot);  // Τα components ξαναρχίζουν από την αρχή
+    EntityStore::getInstance()->transform(slot, this, kind, health);
 }
 
-//  
-void Entity::update(float dt) {
-    float dt_seconds = dt / 1000.0f;
-
-    // Sickness effect -  hp   
-    if (is_sick && side != Side::NEUTRAL) {
-        timer += dt_seconds;
-        if (timer >= 1.0f) {
-            health--;
-            timer -= 1.0f;
-            if (health <= 0) {
-                health = 0;
-            }
-        }
-    }
-    //   (    NEUTRAL)
-    else if (side != Side::NEUTRAL) {
-        if (health < max_health && healing_speed > 0) {
-            timer += dt_seconds;
-            float hp_should_add = healing_speed * timer;
-            int hp_to_add = (int)hp_should_add;
-
-            if (hp_to_add > 0) {
-                health += hp_to_add;
-                float time_used = hp_to_add / healing_speed;
-                timer -= time_used;
-
-                if (health > max_health) {
-                    health = max_health;
-                    timer = 0.0f;
-                }
-            }
-        }
+//Destructor (αποδέσμευση θέσης)
+Entity::~Entity() {
+    if (slot >= 0) {
+        StatusEffects::getInstance()->removeAll(slot);
+        EntityStore::getInstance()->release(slot);
     }
+}
 
-    //            , 
-    if (health > max_health && !is_sick) {
-        timer += dt_seconds;
-        if (timer >= 1.0f) {
-            health--;
-            timer -= 1.0f;
-        }
-    }
+// Έλεγχος αν σημείο βρίσκεται μέσα στην οντότητα (κυκλική περιοχή)
+bool Entity::contains(float mx, float my) const {
+    float dx = mx - x;
+    float dy = my - y;
+    return (dx * dx + dy * dy) <= (size * size);
 }
 
+// Η ενημέρωση γίνεται από τα systems του EntityStore
+void Entity::update(float dt) {}
 
-//   (  sickness   NEUTRAL)
+// Αλλαγή πλευράς (θεραπεύει το sickness αν γίνει NEUTRAL)
 void Entity::setSide(Side s) {
-    side = s;
+    EntityStore::getInstance()->setSide(slot, s);
 
     if (is_sick && side == Side::NEUTRAL) {
-        is_sick = false;
-        max_health = original_max_health;
+        setSick(false);
+        setMaxHealth(original_max_health);
+        StatusEffects::getInstance()->remove(slot, StatusEffects::SICKNESS);
+    }
+
+    // Κατάκτηση ή μετατροπή κατά τη διάρκεια Freeze - η λήξη δεν επαναφέρει την παλιά πλευρά
+    if (side != Side::NEUTRAL) {
+        StatusEffects::getInstance()->remove(slot, StatusEffects::FREEZE);
     }
 }
 
@@ -116,17 +110,17 @@ void Entity::draw() {}
 // Baby
 //Constructor
 Baby::Baby(float x, float y, int health, Side side)
-    : Entity(x, y, health, side) {
+    : Entity(x, y, health, side, EntityKind::BABY) {
     size = BABY_SIZE;
-    max_health = BABY_MAX_HEALTH;
+    setMaxHealth(BABY_MAX_HEALTH);
     original_max_health = BABY_MAX_HEALTH;
-    healing_speed = BABY_HEALING_SPEED;
+    setHealingSpeed(BABY_HEALING_SPEED);
     attacking_speed = BABY_ATTACKING_SPEED;
-    level = 0;
+    setLevel(0);
     defense = 1.0f;
 }
 
-//  Baby (      )
+// Σχεδίαση Baby (μικρός δίσκος με χρώμα ανάλογα την πλευρά)
 void Baby::draw() {
     graphics::Brush br;
     if (side == Side::ENEMY) {
@@ -142,22 +136,32 @@ void Baby::draw() {
 
     graphics::Brush br_text;
     br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 1.0f; br_text.fill_color[2] = 1.0f;
-    graphics::drawText(x - size / 2, y + size / 2, size / 2, std::to_string(health), br_text);
+    graphics::drawText(x - size / 2, y + size / 2, size / 2, std::to_string(getHealth()), br_text);
 }
 
-//Constructor
+//Constructors
 Warrior::Warrior(float x, float y, int health, Side side)
-    : Entity(x, y, health, side) {
+    : Entity(x, y, health, side, EntityKind::WARRIOR) {
+    setupStats();
+}
+
+Warrior::Warrior(Entity& previous, int health)
+    : Entity(previous, health, EntityKind::WARRIOR) {
+    setupStats();
+}
+
+// Αρχικά stats Warrior
+void Warrior::setupStats() {
     size = WARRIOR_SIZE;
-    max_health = WARRIOR_MAX_HEALTH;
+    setMaxHealth(WARRIOR_MAX_HEALTH);
     original_max_health = WARRIOR_MAX_HEALTH;
-    healing_speed = WARRIOR_HEALING_SPEED;
+    setHealingSpeed(WARRIOR_HEALING_SPEED);
     attacking_speed = WARRIOR_ATTACKING_SPEED;
-    level = 1;
+    setLevel(1);
     defense = 1;
 }
 
-//  Warrior (   Baby)
+// Σχεδίαση Warrior (μεγαλύτερος δίσκος από Baby)
 void Warrior::draw() {
     graphics::Brush br;
     if (side == Side::ENEMY) {
@@ -171,26 +175,26 @@ void Warrior::draw() {
     }
     graphics::drawDisk(x, y, size, br);
 
-    //  
+    // Κείμενο ζωής
     graphics::Brush br_text;
     br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 1.0f; br_text.fill_color[2] = 1.0f;
-    graphics::drawText(x - size / 2, y + size / 2, size / 2, std::to_string(health), br_text);
+    graphics::drawText(x - size / 2, y + size / 2, size / 2, std::to_string(getHealth()), br_text);
 }
 
-//      ( level  health)
+// Έλεγχος αν μπορεί να αναβαθμιστεί (βάσει level και health)
 bool Warrior::canUpgrade() const {
     if (level >= 5) return false;
 
     switch (level) {
-    case 1: return health >= 5;
-    case 2: return health >= 10;
-    case 3: return health >= 20;
-    case 4: return health >= 30;
+    case 1: return getHealth() >= 5;
+    case 2: return getHealth() >= 10;
+    case 3: return getHealth() >= 20;
+    case 4: return getHealth() >= 30;
     default: return false;
     }
 }
 
-//      level
+// Κόστος αναβάθμισης ανάλογα με το level
 int Warrior::getUpgradeCost() const {
     if (level >= 5) return 0;
 
@@ -203,41 +207,41 @@ int Warrior::getUpgradeCost() const {
     }
 }
 
-// Warrior
+//Αναβάθμιση Warrior
 void Warrior::performUpgrade() {
     if (!canUpgrade()) return;
 
     switch (level) {
     case 1:
-        if (health >= 5) {
-            health -= 5;
-            max_health += 10;
-            healing_speed += 0.4;
-            level = 2;
+        if (getHealth() >= 5) {
+            setHealth(getHealth() - 5);
+            setMaxHealth(max_health + 10);
+            setHealingSpeed(healing_speed + 0.4f);
+            setLevel(2);
         }
         break;
     case 2:
-        if (health >= 10) {
-            health -= 10;
-            max_health += 10;
-            healing_speed += 0.4;
-            level = 3;
+        if (getHealth() >= 10) {
+            setHealth(getHealth() - 10);
+            setMaxHealth(max_health + 10);
+            setHealingSpeed(healing_speed + 0.4f);
+            setLevel(3);
         }
         break;
     case 3:
-        if (health >= 20) {
-            health -= 20;
-            max_health += 10;
-            healing_speed += 0.4;
-            level = 4;
+        if (getHealth() >= 20) {
+            setHealth(getHealth() - 20);
+            setMaxHealth(max_health + 10);
+            setHealingSpeed(healing_speed + 0.4f);
+            setLevel(4);
         }
         break;
     case 4:
-        if (health >= 30) {
-            health -= 30;
-            max_health += 10;
-            healing_speed += 0.4;
-            level = 5;
+        if (getHealth() >= 30) {
+            setHealth(getHealth() - 30);
+            setMaxHealth(max_health + 10);
+            setHealingSpeed(healing_speed + 0.4f);
+            setLevel(5);
         }
         break;
     default:
@@ -246,27 +250,33 @@ void Warrior::performUpgrade() {
 }
 
 // Tower
-//Constructor
+//Constructors
 Tower::Tower(float x, float y, int health, Side side)
-    : Entity(x, y, health, side), attack_timer(0.0f), attack_interval(TOWER_ATTACK_INTERVAL_BASE) {
+    : Entity(x, y, health, side, EntityKind::TOWER), attack_timer(block.attack_timer[lane]),
+    attack_interval(block.attack_interval[lane]), splash(false) {
+    setupStats();
+}
+
+Tower::Tower(Entity& previous, int health)
+    : Entity(previous, health, EntityKind::TOWER), attack_timer(block.attack_timer[lane]),
+    attack_interval(block.attack_interval[lane]), splash(false) {
+    setupStats();
+}
+
+// Αρχικά stats Tower
+void Tower::setupStats() {
+    attack_interval = TOWER_ATTACK_INTERVAL_BASE;
+    attack_timer = TimerWheel::getInstance()->schedule(attack_interval);  // Πρώτη βολή μετά από ένα διάστημα
     size = TOWER_SIZE;
-    max_health = TOWER_MAX_HEALTH;
+    setMaxHealth(TOWER_MAX_HEALTH);
     original_max_health = TOWER_MAX_HEALTH;
-    level = 1;
-    healing_speed = TOWER_HEALING_SPEED;
+    setLevel(1);
+    setHealingSpeed(TOWER_HEALING_SPEED);
     attacking_speed = TOWER_ATTACKING_SPEED;
     defense = TOWER_DEFENSE;
 }
 
-//  Tower (  )
-void Tower::update(float dt) {
-    Entity::update(dt);
-
-    float dt_seconds = dt / 1000.0f;
-    attack_timer += dt_seconds;
-}
-
-//  Tower (    )
+// Σχεδίαση Tower (τετράγωνο με κύκλο ακτίνας επίθεσης)
 void Tower::draw() {
     graphics::Brush br;
     if (side == Side::ENEMY) {
@@ -280,13 +290,13 @@ void Tower::draw() {
     }
 
 
-    //    ( )
+    //Σχεδίαση κύκλου ακτίνας επίθεσης (άσπρο περίγραμμα)
     graphics::Brush circle_br;
     circle_br.fill_color[0] = 1.0f;
     circle_br.fill_color[1] = 1.0f;
     circle_br.fill_color[2] = 1.0f;
-    circle_br.fill_opacity = 0.0f; // 
-    circle_br.outline_color[0] = 1.0f; //  
+    circle_br.fill_opacity = 0.0f; //Διαφανές εσωτερικό
+    circle_br.outline_color[0] = 1.0f; // Άσπρο περίγραμμα
     circle_br.outline_color[1] = 1.0f;
     circle_br.outline_color[2] = 1.0f;
     circle_br.outline_opacity = 1.0f;
@@ -294,70 +304,94 @@ void Tower::draw() {
 
     graphics::drawDisk(x, y, TOWER_ATTACK_RADIUS, circle_br);
 
-    //   tower
+    // Σχεδίαση του tower
     graphics::drawRect(x, y, size, size, br);
 
-    //  
+    // Splash πύργος: δακτύλιος στο κέντρο με την ακτίνα της ζημιάς περιοχής (σε κλίμακα)
+    if (splash) {
+        graphics::Brush splash_br;
+        splash_br.fill_opacity = 0.0f;
+        splash_br.outline_color[0] = 1.0f;
+        splash_br.outline_color[1] = 0.8f;
+        splash_br.outline_color[2] = 0.2f;
+        splash_br.outline_opacity = 1.0f;
+        splash_br.outline_width = 3.0f;
+        graphics::drawDisk(x, y, size * 0.35f, splash_br);
+    }
+
+    // Κείμενο ζωής
     graphics::Brush br_text;
     br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 1.0f; br_text.fill_color[2] = 1.0f;
-    graphics::drawText(x - size / 4, y + size / 4, size / 4, std::to_string(health), br_text);
+    graphics::drawText(x - size / 4, y + size / 4, size / 4, std::to_string(getHealth()), br_text);
 }
 
-//     troops
-void Tower::attackNearbyTroops(std::vector<Troop*>& troops, std::vector<AttackEffect>& effects) {
-    if (attack_timer < attack_interval) return;
+// Επίθεση σε κοντινά εχθρικά troops
+Troop* Tower::attackNearbyTroops(const std::vector<Troop*>& candidates, ParticleSystem& particles) {
+    if (!isAttackReady()) return nullptr;
 
-    attack_timer = 0.0f;
+    attack_timer = TimerWheel::getInstance()->schedule(attack_interval);
 
-    //    troop
+    // Εύρεση κοντινότερου εχθρικού troop ανάμεσα στους υποψήφιους (τετράγωνα αποστάσεων)
     Troop* closest_troop = nullptr;
-    float closest_dist = TOWER_ATTACK_RADIUS;
+    float closest_dist_sq = TOWER_ATTACK_RADIUS * TOWER_ATTACK_RADIUS;
 
-    for (auto* troop : troops) {
+    for (auto* troop : candidates) {
         if (troop->hasArrived() || troop->isDead()) continue;
 
-        //    troop  
-        if (troop->getSource()->getSide() == this->side) continue;
+        // Έλεγχος αν το troop είναι εχθρικό
+        if (troop->getSide() == this->side) continue;
 
         float dx = troop->getX() - x;
         float dy = troop->getY() - y;
-        float dist = std::sqrt(dx * dx + dy * dy);
+        float dist_sq = dx * dx + dy * dy;
 
-        if (dist <= TOWER_ATTACK_RADIUS && dist < closest_dist) {
-            closest_dist = dist;
+        if (dist_sq <= closest_dist_sq) {
+            closest_dist_sq = dist_sq;
             closest_troop = troop;
         }
     }
 
-    //    troop
+    // Επίθεση στο κοντινότερο troop
     if (closest_troop) {
-        closest_troop->reduceHealth(TOWER_DAMAGE);
-
-        //   effect
-        AttackEffect effect;
-        effect.start_x = x;
-        effect.start_y = y;
-        effect.end_x = closest_troop->getX();
-        effect.end_y = closest_troop->getY();
-        effect.duration = 0.3f;
-        effect.elapsed = 0.0f;
-
-        //    
+        if (!splash) closest_troop->reduceHealth(TOWER_DAMAGE);
+
+        // Χρώμα ανάλογα την πλευρά
+        float r, g, b;
         if (side == Side::PLAYER) {
-            effect.r = 0.1f; effect.g = 0.1f; effect.b = 1.0f;
+            r = 0.1f; g = 0.1f; b = 1.0f;
         }
         else if (side == Side::ENEMY) {
-            effect.r = 1.0f; effect.g = 0.1f; effect.b = 0.1f;
+            r = 1.0f; g = 0.1f; b = 0.1f;
         }
         else {
-            effect.r = 0.8f; effect.g = 0.8f; effect.b = 0.8f;
+            r = 0.8f; g = 0.8f; b = 0.8f;
         }
 
-        effects.push_back(effect);
+        // Δημιουργία οπτικού effect (βολή από τον πύργο προς το troop)
+        particles.spawn(x, y, closest_troop->getX(), closest_troop->getY(),
+            0.15f, 0.15f, 0.3f, r, g, b, ParticleSystem::DISK);
     }
+
+    return closest_troop;
+}
+
+// Ο κλάδος splash ανοίγει από το SPLASH_UNLOCK_LEVEL και κοστίζει SPLASH_COST hp
+bool Tower::canConvertToSplash() const {
+    return !splash && level >= SPLASH_UNLOCK_LEVEL && getHealth() >= SPLASH_COST;
+}
+
+// Μετατροπή σε splash πύργο: ζημιά σε όλα τα εχθρικά troops γύρω από τον στόχο,
+// με πιο αργό ρυθμό βολής
+void Tower::convertToSplash() {
+    if (!canConvertToSplash()) return;
+
+    setHealth(getHealth() - SPLASH_COST);
+    splash = true;
+    attack_interval *= SPLASH_INTERVAL_FACTOR;
+    EntityStore::getInstance()->markChanged(slot);  // Άλλαξαν ζημιά και διάστημα βολών
 }
 
-//   Tower
+// Κόστος αναβάθμισης Tower
 int Tower::getUpgradeCost() const {
     if (level >= 5) return 0;
 
@@ -370,62 +404,62 @@ int Tower::getUpgradeCost() const {
     }
 }
 
-//   Tower   
+// Έλεγχος αν Tower μπορεί να αναβαθμιστεί
 bool Tower::canUpgrade() const {
     if (level >= 5) return false;
 
     switch (level) {
-    case 1: return health >= 10;
-    case 2: return health >= 15;
-    case 3: return health >= 20;
-    case 4: return health >= 25;
+    case 1: return getHealth() >= 10;
+    case 2: return getHealth() >= 15;
+    case 3: return getHealth() >= 20;
+    case 4: return getHealth() >= 25;
     default: return false;
     }
 }
 
-//   Tower
+// Εκτέλεση αναβάθμισης Tower
 void Tower::performUpgrade() {
     if (!canUpgrade()) return;
 
     switch (level) {
     case 1:
-        if (health >= 10) {
-            health -= 10;
-            max_health += 20;
+        if (getHealth() >= 10) {
+            setHealth(getHealth() - 10);
+            setMaxHealth(max_health + 20);
             original_max_health = max_health;
             defense += 0.5f;
-            attack_interval -= 0.08f; //  
-            level = 2;
+            attack_interval -= 0.08f; // Ταχύτερη επίθεση
+            setLevel(2);
         }
         break;
     case 2:
-        if (health >= 15) {
-            health -= 15;
-            max_health += 20;
+        if (getHealth() >= 15) {
+            setHealth(getHealth() - 15);
+            setMaxHealth(max_health + 20);
             original_max_health = max_health;
             defense += 0.5f;
             attack_interval -= 0.08f; 
-            level = 3;
+            setLevel(3);
         }
         break;
     case 3:
-        if (health >= 20) {
-            health -= 20;
-            max_health += 20;
+        if (getHealth() >= 20) {
+            setHealth(getHealth() - 20);
+            setMaxHealth(max_health + 20);
             original_max_health = max_health;
             defense += 0.5f;
             attack_interval -= 0.08f; 
-            level = 4;
+            setLevel(4);
         }
         break;
     case 4:
-        if (health >= 25) {
-            health -= 25;
-            max_health += 20;
+        if (getHealth() >= 25) {
+            setHealth(getHealth() - 25);
+            setMaxHealth(max_health + 20);
             original_max_health = max_health;
             defense += 0.5f;
             attack_interval -= 0.08f;
-            level = 5;
+            setLevel(5);
         }
         break;
     default:
@@ -434,40 +468,31 @@ void Tower::performUpgrade() {
 }
 
 // Wizard
-//Constructor
-Wizard::Wizard(float x, float y, int health, Side side) : Entity(x, y, health, side) {
+//Constructors
+Wizard::Wizard(float x, float y, int health, Side side)
+    : Entity(x, y, health, side, EntityKind::WIZARD), spell_timers(block.spell_timers[lane]) {
+    setupStats();
+}
+
+Wizard::Wizard(Entity& previous, int health)
+    : Entity(previous, health, EntityKind::WIZARD), spell_timers(block.spell_timers[lane]) {
+    setupStats();
+}
+
+// Αρχικά stats Wizard
+void Wizard::setupStats() {
     size = WIZARD_SIZE;
-    max_health = WIZARD_MAX_HEALTH;
+    setMaxHealth(WIZARD_MAX_HEALTH);
     original_max_health = WIZARD_MAX_HEALTH;
-    level = 1;
-    healing_speed = WIZARD_HEALING_SPEED;
+    setLevel(1);
+    setHealingSpeed(WIZARD_HEALING_SPEED);
     defense = WIZARD_DEFENSE;
     attacking_speed = WIZARD_ATTACKING_SPEED;
 
-    //   spells
-    spell_cooldowns[0] = 0.0f; // Freeze
-    spell_cooldowns[1] = 0.0f; // Sickness
-    spell_cooldowns[2] = 0.0f; // Convert
+    // Χρονόμετρα spells: κανένα cooldown στην αρχή (τα handles τα μηδενίζει το EntityStore)
 }
 
-//  Wizard (  spells)
-void Wizard::update(float dt) {
-    Entity::update(dt);
-
-    float dt_seconds = dt / 1000.0f;
-
-    //   spells
-    for (int i = 0; i < 3; i++) {
-        if (spell_cooldowns[i] > 0.0f) {
-            spell_cooldowns[i] -= dt_seconds;
-            if (spell_cooldowns[i] < 0.0f) {
-                spell_cooldowns[i] = 0.0f;
-            }
-        }
-    }
-}
-
-//  Wizard ( )
+// Σχεδίαση Wizard (τρίγωνο σχήμα)
 void Wizard::draw() {
     graphics::Brush br;
     if (side == Side::ENEMY) {
@@ -480,9 +505,9 @@ void Wizard::draw() {
         br.fill_color[0] = 0.8f; br.fill_color[1] = 0.8f; br.fill_color[2] = 0.8f;
     }
 
-    //   ( )
+    // Σχεδίαση τριγώνου (μέρος κύκλου)
     graphics::drawSector(x, y - 0.15f, 0, size, 240, 300, br);
-    //        
+    // Κάλυψη κάτω μέρους για να φαίνεται σαν τρίγωνο
     graphics::Brush br_cover;
     br_cover.fill_color[0] = 0.3f; 
     br_cover.fill_color[1] = 0.6f; 
@@ -491,19 +516,19 @@ void Wizard::draw() {
     br_cover.outline_color[1] = 0.6f;
     br_cover.outline_color[2] = 1.0f;
     graphics::drawRect(x, y + 1.0f, size, 0.2f, br_cover);
-    //  
+    // Κείμενο ζωής
     graphics::Brush br_text;
     br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 1.0f; br_text.fill_color[2] = 1.0f;
-    graphics::drawText(x - size / 2 + 0.5f, y + size / 2 + 0.1f, 0.2f, std::to_string(health), br_text);
+    graphics::drawText(x - size / 2 + 0.5f, y + size / 2 + 0.1f, 0.2f, std::to_string(getHealth()), br_text);
 }
 
-//       spell
+// Έλεγχος αν μπορεί να ρίξει συγκεκριμένο spell
 bool Wizard::canCastSpell(int spell_id) const {
     if (spell_id < 0 || spell_id > 2) return false;
-    if (spell_cooldowns[spell_id] > 0.0f) return false;
-    if (health < getSpellCost(spell_id)) return false;
+    if (TimerWheel::getInstance()->isPending(spell_timers[spell_id])) return false;
+    if (getHealth() < getSpellCost(spell_id)) return false;
 
-    //  level   spell
+    // Απαιτήσεις level για κάθε spell
     if (spell_id == 0 && level < 1) return false; // Freeze at level 1
     if (spell_id == 1 && level < 2) return false; // Sickness at level 2
     if (spell_id == 2 && level < 3) return false; // Convert at level 3
@@ -511,7 +536,7 @@ bool Wizard::canCastSpell(int spell_id) const {
     return true;
 }
 
-//  hp   spell
+// Κόστος hp για κάθε spell
 int Wizard::getSpellCost(int spell_id) const {
     switch (spell_id) {
     case 0: return FREEZE_COST;
@@ -521,37 +546,34 @@ int Wizard::getSpellCost(int spell_id) const {
     }
 }
 
-//  spell  
+// Ρίψη spell σε στόχο
 void Wizard::castSpell(int spell_id, Entity* target) {
     if (!canCastSpell(spell_id) || !target) return;
     if (target->getSide() == side) return; // Can't target own side
 
-    //   hp
-    health -= getSpellCost(spell_id);
+    // Πληρωμή κόστους hp
+    setHealth(getHealth() - getSpellCost(spell_id));
 
-    //  
-    spell_cooldowns[spell_id] = SPELL_COOLDOWN;
+    // Εκκίνηση χρονόμετρου
+    spell_timers[spell_id] = TimerWheel::getInstance()->schedule(SPELL_COOLDOWN);
 
-    //  spell effect 
+    // Εφαρμογή spell effect 
     switch (spell_id) {
-    case 0: // Freeze -  neutral
-        target->setSide(Side::NEUTRAL);
+    case 0: // Freeze - προσωρινά neutral
+        StatusEffects::getInstance()->apply(target, StatusEffects::FREEZE);
         break;
 
-    case 1: // Sickness - max_health = 0
-        if (!target->isSick()) {
-            target->setSick(true);
-            target->setMaxHealth(0);
-        }
+    case 1: // Sickness - max_health = 0 για όσο διαρκεί
+        StatusEffects::getInstance()->apply(target, StatusEffects::SICKNESS);
         break;
 
-    case 2: // Convert -   player
-        target->setSide(Side::PLAYER);
+    case 2: // Convert - μετατροπή στην πλευρά του Wizard
+        target->setSide(side);
         break;
     }
 }
 
-//   Wizard
+// Κόστος αναβάθμισης Wizard
 int Wizard::getUpgradeCost() const {
     if (level >= 3) return 0;
 
@@ -562,38 +584,38 @@ int Wizard::getUpgradeCost() const {
     }
 }
 
-//   Wizard   
+// Έλεγχος αν Wizard μπορεί να αναβαθμιστεί
 bool Wizard::canUpgrade() const {
     if (level >= 3) return false;
 
     switch (level) {
-    case 1: return health >= 15;
-    case 2: return health >= 20;
+    case 1: return getHealth() >= 15;
+    case 2: return getHealth() >= 20;
     default: return false;
     }
 }
 
-//   Wizard
+// Εκτέλεση αναβάθμισης Wizard
 void Wizard::performUpgrade() {
     if (!canUpgrade()) return;
 
     switch (level) {
     case 1:
-        if (health >= 15) {
-            health -= 15;
-            max_health += 50;
+        if (getHealth() >= 15) {
+            setHealth(getHealth() - 15);
+            setMaxHealth(max_health + 50);
             original_max_health = max_health;
             attacking_speed += 35;
-            level = 2;
+            setLevel(2);
         }
         break;
     case 2:
-        if (health >= 20) {
-            health -= 20;
-            max_health += 50;
+        if (getHealth() >= 20) {
+            setHealth(getHealth() - 20);
+            setMaxHealth(max_health + 50);
             original_max_health = max_health;
             attacking_speed += 40;
-            level = 3;
+            setLevel(3);
         }
         break;
     default:
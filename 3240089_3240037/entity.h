@@ -1,48 +1,76 @@
 #pragma once
 #include "node.h"
+#include "entity_store.h"
 #include <string>
 #include <vector>
 
-///  
+//Πλευρές/ομάδες στο παιχνίδι
 enum class Side { PLAYER, ENEMY, NEUTRAL };
 
-//      entities  
-//   Node     , , level .
+//Είδη entities (σταθερό tag που ορίζεται στη δημιουργία, αντί για σύγκριση strings)
+enum class EntityKind : unsigned char { BABY, WARRIOR, TOWER, WIZARD };
+constexpr int ENTITY_KIND_COUNT = 4;
+
+//Θέση του είδους σε πίνακες ανά είδος
+constexpr int kindIndex(EntityKind kind) { return static_cast<int>(kind); }
+
+// Βασική κλάση για όλα τα entities του παιχνιδιού
+// Κληρονομεί από Node και προσθέτει χαρακτηριστικά όπως ζωή, πλευρά, level κλπ.
+// Τα δεδομένα της προσομοίωσης ζουν στο EntityStore. Τα μέλη παρακάτω που είναι αναφορές
+// δείχνουν στη θέση (slot) του entity εκεί, και τα ενημερώνουν τα systems του store
+// Η ζωή υπολογίζεται από το store όταν διαβάζεται (getHealth), και ό,τι επηρεάζει τον ρυθμό
+// της (πλευρά, μέγιστο, healing, sickness) αλλάζει μόνο μέσω των setters
 class Entity : public Node {
 protected:
-    int health; //
-    Side side; ///
-	float timer; //   
-	float size; //
-	bool selected; //  
-	int max_health; //  
-	float healing_speed; // healing  
-	int attacking_speed; //  (    troops)
-	float defense; // (    )
-	int level; //Level  entity (  stats)
-
-    //  spell sickness
-    bool is_sick;
-    int original_max_health;
+    int slot; //Θέση στο EntityStore (-1 αν τη πήρε άλλο entity με μετατροπή)
+    EntityStore::Block& block; //Block της θέσης
+    int lane; //Θέση μέσα στο block
+
+    const Side& side; //Πλευρά/ομάδα
+    const EntityKind kind; //Είδος (η μετατροπή δημιουργεί νέο αντικείμενο στην ίδια θέση)
+	float& size; //Μέγεθος
+	bool selected; //Επιλεγμένο ή όχι
+	const int& max_health; //Μέγιστη δυνατή ζωή
+	const float& healing_speed; //Ταχύτητα healing ανά δευτερόλεπτο
+	int attacking_speed; //Ταχύτητα επίθεσης (επηρεάζει την ταχύτητα των troops)
+	float defense; //Άμυνα (μειώνει τη ζημιά που δέχεται)
+	const int& level; //Level του entity (επηρεαζει κάποια stats - στο EntityStore για τα αθροίσματα ανά level)
+
+    //Για το spell sickness
+    const bool& is_sick;
+    int& original_max_health;
+
+    //Constructor μετατροπής: το νέο entity παίρνει τη θέση του previous στο EntityStore
+    Entity(Entity& previous, int health, EntityKind kind);
+
+    void setHealingSpeed(float hs) { EntityStore::getInstance()->setHealingSpeed(slot, hs); }
+    void setLevel(int l) { EntityStore::getInstance()->setLevel(slot, l); }
 
 public:
-    Entity(float x, float y, int health, Side side);
+    Entity(float x, float y, int health, Side side, EntityKind kind);
+    ~Entity() override;
+
+    Entity(const Entity&) = delete;
+    Entity& operator=(const Entity&) = delete;
 
-    //   Node
+    //Βασικές στναρτήσεις από Node
+    //Η update δεν κάνει τίποτα: healing, sickness και χρονόμετρα τα ενημερώνει το EntityStore
     void update(float dt) override;
     void draw() override;
     bool contains(float mx, float my) const override;
 
-    //    
+    //Εικονικές συναρτησεις για πολυμορφισμό 
     virtual void onClick() {}
     virtual bool canUpgrade() const { return false; }
     virtual void performUpgrade() {}
     virtual int getUpgradeCost() const { return 0; }
-    virtual std::string getType() const = 0;  // Pure virtual
 
     // Getters
-    int getHealth() const { return health; }
+    int getHealth() const { return EntityStore::getInstance()->getHealth(slot); }
     Side getSide() const { return side; }
+    int getSlot() const { return slot; }
+    EntityHandle getHandle() const { return EntityStore::getInstance()->handleOf(slot); }
+    EntityKind getKind() const { return kind; }
     float getSize() const { return size; }
     int getLevel() const { return level; }
     int getMaxHealth() const { return max_health; }
@@ -54,24 +82,22 @@ public:
     int getOriginalMaxHealth() const { return original_max_health; }
 
     // Setters
-    void setHealth(int h) { health = h; }
+    void setHealth(int h) { EntityStore::getInstance()->setHealth(slot, h); }
     void setSide(Side s);
     void setSelected(bool s) { selected = s; }
-    void setSick(bool sick) { is_sick = sick; }
-    void setMaxHealth(int mh) { max_health = mh; }
-
-    virtual ~Entity() = default;
+    void setSick(bool sick) { EntityStore::getInstance()->setSick(slot, sick); }
+    void setMaxHealth(int mh) { EntityStore::getInstance()->setMaxHealth(slot, mh); }
 };
 
 
-//  Entity
+//ΥΠΟΚΛΑΣΕΙΣ της Entity
 //Baby
 //Warrior
 //Tower
 //Wizard
 
 
-//Entity      Warrior/Tower/Wizard
+//Entity που μπορεί να αναβαθμιστεί σε Warrior/Tower/Wizard
 class Baby : public Entity {
 private:
     static const float BABY_SIZE;
@@ -82,10 +108,9 @@ private:
 public:
     Baby(float x, float y, int health, Side side);
     void draw() override;
-    std::string getType() const override { return "Baby"; }
 };
 
-// entity   heal   troops
+//Μαχητικο entity που κάνει heal και στέλνει troops
 class Warrior : public Entity {
 private:
     static const float WARRIOR_SIZE;
@@ -93,10 +118,12 @@ private:
     static const float WARRIOR_HEALING_SPEED;
     static const int WARRIOR_ATTACKING_SPEED;
 
+    void setupStats(); //Αρχικά stats (κοινά για τους δύο constructors)
+
 public:
     Warrior(float x, float y, int health, Side side);
+    Warrior(Entity& previous, int health); //Μετατροπή στην ίδια θέση του EntityStore
     void draw() override;
-    std::string getType() const override { return "Warrior"; }
 
     // Override virtual functions
     bool canUpgrade() const override;
@@ -104,10 +131,11 @@ public:
     int getUpgradeCost() const override;
 };
 
-// Forward declaration    Troop (  Tower)
+// Forward declarations για τις κλάσεις Troop και ParticleSystem (χρειάζονται στο Tower)
 class Troop;
+class ParticleSystem;
 
-// entity      troops
+//Αμυντικό entity που επιτίθεται σε κοντινά εχθρικά troops
 class Tower : public Entity {
 private:
     static const float TOWER_SIZE;
@@ -119,38 +147,55 @@ private:
     static const int TOWER_DAMAGE;
     static const float TOWER_ATTACK_INTERVAL_BASE;
 
-    // 
-    float attack_timer;
-	float attack_interval; //   
+    // Κλάδος splash (ζημιά περιοχής γύρω από το σημείο πρόσκρουσης)
+    static const int SPLASH_UNLOCK_LEVEL;
+    static const int SPLASH_COST;
+    static const float SPLASH_RADIUS;
+    static const int SPLASH_DAMAGE;
+    static const float SPLASH_INTERVAL_FACTOR;
+
+    //Χρονομετρα επίθεσης (στο EntityStore - το attack_timer είναι pending μέχρι την επόμενη βολή)
+    TimerHandle& attack_timer;
+	float& attack_interval; //Αλλάζει με τις αναβαθμίσεις
+    bool splash;           //Αν ο πύργος έχει πάρει τον κλάδο splash
+
+    void setupStats(); //Αρχικά stats (κοινά για τους δύο constructors)
 
 public:
     Tower(float x, float y, int health, Side side);
+    Tower(Entity& previous, int health); //Μετατροπή στην ίδια θέση του EntityStore
     void draw() override;
-    void update(float dt) override;
-    std::string getType() const override { return "Tower"; }
 
-	//Override  
+	//Override συναρτήσεων αναβάθμισης
     bool canUpgrade() const override;
     void performUpgrade() override;
     int getUpgradeCost() const override;
 
-	//    
-    struct AttackEffect {
-        float start_x, start_y;
-        float end_x, end_y;
-        float duration;
-        float elapsed;
-        float r, g, b;
-    };
-
-	//   troops
-    void attackNearbyTroops(std::vector<Troop*>& troops, std::vector<AttackEffect>& effects);
-
-    // Getter    ( )
+	//Κλάδος splash (διαθέσιμος από το SPLASH_UNLOCK_LEVEL και μετά)
+    bool canConvertToSplash() const;
+    void convertToSplash();
+    int getSplashCost() const { return SPLASH_COST; }
+    int getSplashUnlockLevel() const { return SPLASH_UNLOCK_LEVEL; }
+    bool isSplash() const { return splash; }
+    float getSplashRadius() const { return SPLASH_RADIUS; }
+    int getSplashDamage() const { return SPLASH_DAMAGE; }
+
+	//Συνάρτηση επίθεσης κοντινών troops
+	//Τα candidates είναι τα troops που ήδη βρέθηκαν μέσα στα διαστήματα έκθεσης του πύργου
+	//Επιστρέφει το troop που χτυπήθηκε (nullptr αν δεν έγινε βολή). Ο splash πύργος
+	//δεν κάνει ζημιά εδώ: η ζημιά περιοχής εφαρμόζεται από τον καλούντα γύρω από το troop
+    Troop* attackNearbyTroops(const std::vector<Troop*>& candidates, ParticleSystem& particles);
+
+    // Αν έχει περάσει το διάστημα επίθεσης (αλλιώς δεν χρειάζεται αναζήτηση στόχων)
+    bool isAttackReady() const { return !TimerWheel::getInstance()->isPending(attack_timer); }
+
+    // Getter για ακτίνα επίθεσης (για σχεδίαση)
     float getAttackRadius() const { return TOWER_ATTACK_RADIUS; }
+    int getDamage() const { return TOWER_DAMAGE; }
+    float getAttackInterval() const { return attack_interval; }
 };
 
-//Entity ,   troops,     spells
+//Entity που, εκτός από troops, μπορεί να ρίξει και spells
 class Wizard : public Entity {
 private:
     static const float WIZARD_SIZE;
@@ -163,22 +208,23 @@ private:
     static const int SICKNESS_COST;
     static const int CONVERT_COST;
 
-    float spell_cooldowns[3]; // 0=Freeze, 1=Sickness, 2=Convert
+    TimerHandle (&spell_timers)[3]; // 0=Freeze, 1=Sickness, 2=Convert (στο EntityStore, pending όσο διαρκεί το cooldown)
+
+    void setupStats(); //Αρχικά stats (κοινά για τους δύο constructors)
 
 public:
     Wizard(float x, float y, int health, Side side);
+    Wizard(Entity& previous, int health); //Μετατροπή στην ίδια θέση του EntityStore
     void draw() override;
-    void update(float dt) override;
-    std::string getType() const override { return "Wizard"; }
 
-    //Override  
+    //Override συναρτήσεων αναβάθμισης
     bool canUpgrade() const override;
     void performUpgrade() override;
     int getUpgradeCost() const override;
 
-    // spells
+    //Σύστημα spells
     bool canCastSpell(int spell_id) const;
     void castSpell(int spell_id, Entity* target);
-    float getSpellCooldown(int spell_id) const { return spell_cooldowns[spell_id]; }
+    float getSpellCooldown(int spell_id) const { return TimerWheel::getInstance()->remaining(spell_timers[spell_id]); }
     int getSpellCost(int spell_id) const;
 };
\ No newline at end of file
@@ -0,0 +1,465 @@
+﻿#include "entity_store.h"
+#include "entity.h"
+#include <algorithm>
+#include <cmath>
+
+const int EntityStore::BLOCK_SIZE;
+const int EntityStore::SIDE_COUNT;
+const int EntityStore::KIND_COUNT;
+const int EntityStore::LEVEL_COUNT;
+EntityStore* EntityStore::instance = nullptr;
+
+static_assert(EntityStore::KIND_COUNT == ENTITY_KIND_COUNT, "KIND_COUNT must match EntityKind");
+static_assert(EntityStore::SIDE_COUNT == static_cast<int>(Side::NEUTRAL) + 1, "SIDE_COUNT must match Side");
+
+// Constructor
+EntityStore::EntityStore() : slot_count(0), live_count(0), epoch_counter(0) {
+    for (int k = 0; k < KIND_COUNT; k++) kind_epochs[k] = 0;
+}
+
+// Νέο epoch για την κατάσταση μιας θέσης και για το είδος της
+void EntityStore::touchState(int slot) {
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+    b.state_epoch[lane] = ++epoch_counter;
+    kind_epochs[kindIndex(b.kind[lane])] = epoch_counter;
+}
+
+unsigned int EntityStore::getKindEpoch(EntityKind kind) const {
+    return kind_epochs[kindIndex(kind)];
+}
+
+// Λήψη του μοναδικού instance
+EntityStore* EntityStore::getInstance() {
+    if (!instance) {
+        instance = new EntityStore();
+    }
+    return instance;
+}
+
+// Αρχικές τιμές των components μιας θέσης (ίδιες με τον constructor της Entity)
+void EntityStore::resetComponents(Block& b, int lane, Entity* owner, EntityKind kind, int health) {
+    b.owner[lane] = owner;
+    b.alive[lane] = true;
+    b.kind[lane] = kind;
+    b.level[lane] = 0;
+    b.size[lane] = 0.0f;
+    b.health[lane] = health;
+    b.vital_time[lane] = TimerWheel::getInstance()->now();
+    b.max_health[lane] = 0;
+    b.original_max_health[lane] = 0;
+    b.healing_speed[lane] = 0.0f;
+    b.timer[lane] = 1.0f;
+    b.sick[lane] = false;
+    b.attack_interval[lane] = 0.0f;
+    cancelTimers(b, lane);
+}
+
+// Ακύρωση των χρονομέτρων μιας θέσης (νέα χρήση ή αποδέσμευση)
+void EntityStore::cancelTimers(Block& b, int lane) {
+    TimerWheel* wheel = TimerWheel::getInstance();
+    wheel->cancel(b.vital_timer[lane]);
+    wheel->cancel(b.attack_timer[lane]);
+    for (int s = 0; s < 3; s++) {
+        wheel->cancel(b.spell_timers[lane][s]);
+    }
+}
+
+// Δέσμευση θέσης (πρώτα από τις ελεύθερες, αλλιώς στο τέλος με νέο block αν χρειάζεται)
+int EntityStore::allocate(Entity* owner, EntityKind kind, Side side, float x, float y, int health) {
+    int slot;
+    if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    }
+    else {
+        slot = slot_count++;
+        if (slot / BLOCK_SIZE >= (int)blocks.size()) {
+            blocks.push_back(std::unique_ptr<Block>(new Block()));
+        }
+    }
+
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+    resetComponents(b, lane, owner, kind, health);
+    b.side[lane] = side;
+    b.x[lane] = x;
+    b.y[lane] = y;
+
+    addMember(slot);
+    addToTotals(slot);
+    touchState(slot);
+    live_count++;
+    return slot;
+}
+
+// Handle για μια θέση σε χρήση
+EntityHandle EntityStore::handleOf(int slot) const {
+    EntityHandle handle;
+    if (slot < 0 || slot >= slot_count) return handle;
+
+    const Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+    if (!b.alive[lane]) return handle;
+
+    handle.slot = slot;
+    handle.generation = b.generation[lane];
+    return handle;
+}
+
+// Μετατροπή στην ίδια θέση
+void EntityStore::transform(int slot, Entity* owner, EntityKind kind, int health) {
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+
+    removeFromTotals(slot);
+    removeMember(slot);
+    touchState(slot);  // Το παλιό είδος χάνει ένα μέλος
+    resetComponents(b, lane, owner, kind, health);
+    addMember(slot);
+    addToTotals(slot);
+    touchState(slot);
+}
+
+// Αποδέσμευση θέσης
+void EntityStore::release(int slot) {
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+    if (!b.alive[lane]) return;
+
+    removeFromTotals(slot);
+    removeMember(slot);
+    touchState(slot);
+    b.alive[lane] = false;
+    b.owner[lane] = nullptr;
+    cancelTimers(b, lane);
+    b.generation[lane]++;  // Τα υπάρχοντα handles της θέσης παύουν να ισχύουν
+    free_slots.push_back(slot);
+    live_count--;
+
+    // Άδεια αποθήκη (π.χ. αλλαγή level): οι νέες θέσεις ξαναρχίζουν από την αρχή,
+    // ώστε η σειρά των θέσεων να ακολουθεί τη σειρά δημιουργίας
+    if (live_count == 0) {
+        free_slots.clear();
+        slot_count = 0;
+
+        // Μηδενισμός και των αθροισμάτων (χωρίς σφάλματα στρογγυλοποίησης από προηγούμενα levels)
+        for (int s = 0; s < SIDE_COUNT; s++) {
+            for (int k = 0; k < KIND_COUNT; k++) {
+                for (int l = 0; l < LEVEL_COUNT; l++) {
+                    totals[s][k][l] = Total();
+                }
+            }
+        }
+    }
+}
+
+// Προσθήκη στις λίστες της πλευράς και του είδους (στο τέλος, O(1))
+void EntityStore::addMember(int slot) {
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+
+    std::vector<Entity*>& by_side = side_members[static_cast<int>(b.side[lane])];
+    b.side_pos[lane] = (int)by_side.size();
+    by_side.push_back(b.owner[lane]);
+
+    std::vector<Entity*>& by_kind = kind_members[kindIndex(b.kind[lane])];
+    b.kind_pos[lane] = (int)by_kind.size();
+    by_kind.push_back(b.owner[lane]);
+}
+
+// Αφαίρεση από τις λίστες: το τελευταίο μέλος κάθε λίστας μεταφέρεται στη θέση του αφαιρεμένου
+void EntityStore::removeMember(int slot) {
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+
+    std::vector<Entity*>& by_side = side_members[static_cast<int>(b.side[lane])];
+    int pos = b.side_pos[lane];
+    Entity* last = by_side.back();
+    by_side[pos] = last;
+    by_side.pop_back();
+    if (pos < (int)by_side.size()) {
+        int moved = last->getSlot();
+        blockOf(moved).side_pos[laneOf(moved)] = pos;
+    }
+
+    std::vector<Entity*>& by_kind = kind_members[kindIndex(b.kind[lane])];
+    pos = b.kind_pos[lane];
+    last = by_kind.back();
+    by_kind[pos] = last;
+    by_kind.pop_back();
+    if (pos < (int)by_kind.size()) {
+        int moved = last->getSlot();
+        blockOf(moved).kind_pos[laneOf(moved)] = pos;
+    }
+}
+
+// Άθροισμα στο οποίο ανήκει η θέση
+EntityStore::Total& EntityStore::totalOf(const Block& b, int lane) {
+    int level = std::max(0, std::min(b.level[lane], LEVEL_COUNT - 1));
+    return totals[static_cast<int>(b.side[lane])][kindIndex(b.kind[lane])][level];
+}
+
+
+// Κανόνας που ορίζει τη μεταβολή της ζωής μιας θέσης
+enum class VitalMode { STEADY, HEAL, SICK, DECAY };
+
+static VitalMode vitalMode(const EntityStore::Block& b, int lane) {
+    int health = b.health[lane];
+    bool active = b.side[lane] != Side::NEUTRAL;
+
+    // Sickness - χάνει 1 hp το δευτερόλεπτο μέχρι το 0 (μόνο αν δεν είναι NEUTRAL)
+    if (b.sick[lane]) {
+        return (active && health > 0) ? VitalMode::SICK : VitalMode::STEADY;
+    }
+    // Κανονική θεραπεία μέχρι το μέγιστο (μόνο αν δεν είναι NEUTRAL)
+    if (active && health < b.max_health[lane] && b.healing_speed[lane] > 0) {
+        return VitalMode::HEAL;
+    }
+    // Πάνω από το μέγιστο - χάνει 1 hp το δευτερόλεπτο μέχρι το μέγιστο
+    if (health > b.max_health[lane]) {
+        return VitalMode::DECAY;
+    }
+    return VitalMode::STEADY;
+}
+
+// Ζωή τη στιγμή now() του TimerWheel: health + βήματα από το σημείο αναφοράς, με όριο το max_health (ή το 0)
+// remainder = χρόνος από το τελευταίο βήμα (0 αν η ζωή έφτασε το όριο)
+int EntityStore::evaluateHealth(const Block& b, int lane, float& remainder) const {
+    int health = b.health[lane];
+    remainder = b.timer[lane];
+    double now = TimerWheel::getInstance()->now();
+    if (now <= b.vital_time[lane]) return health;  // Δεν έχει περάσει χρόνος (π.χ. αρχικά stats)
+
+    float t = b.timer[lane] + (float)(now - b.vital_time[lane]);
+
+    switch (vitalMode(b, lane)) {
+    case VitalMode::HEAL: {
+        float healing_speed = b.healing_speed[lane];
+        float steps = std::floor(healing_speed * t);
+        if (steps >= b.max_health[lane] - health) {
+            remainder = 0.0f;
+            return b.max_health[lane];
+        }
+        remainder = t - steps / healing_speed;
+        return health + (int)steps;
+    }
+    case VitalMode::SICK:
+    case VitalMode::DECAY: {
+        int floor_value = b.sick[lane] ? 0 : b.max_health[lane];
+        float steps = std::floor(t);
+        if (steps >= health - floor_value) {
+            remainder = 0.0f;
+            return floor_value;
+        }
+        remainder = t - steps;
+        return health - (int)steps;
+    }
+    default:
+        return health;
+    }
+}
+
+// Στιγμή που η ζωή φτάνει το όριο (-1 αν η ζωή δεν μεταβάλλεται)
+double EntityStore::crossingTime(const Block& b, int lane) const {
+    int health = b.health[lane];
+
+    switch (vitalMode(b, lane)) {
+    case VitalMode::HEAL:
+        return b.vital_time[lane] + (b.max_health[lane] - health) / b.healing_speed[lane] - b.timer[lane];
+    case VitalMode::SICK:
+        return b.vital_time[lane] + health - b.timer[lane];
+    case VitalMode::DECAY:
+        return b.vital_time[lane] + (health - b.max_health[lane]) - b.timer[lane];
+    default:
+        return -1.0;
+    }
+}
+
+// Νέο σημείο αναφοράς στην τρέχουσα στιγμή (πριν από κάθε αλλαγή που επηρεάζει τη ζωή)
+void EntityStore::settle(int slot) {
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+
+    float remainder;
+    b.health[lane] = evaluateHealth(b, lane, remainder);
+    b.timer[lane] = remainder;
+    b.vital_time[lane] = TimerWheel::getInstance()->now();
+    TimerWheel::getInstance()->cancel(b.vital_timer[lane]);  // Το όριο θα υπολογιστεί ξανά
+}
+
+// Χρονόμετρο για το επόμενο όριο της ζωής (αν η ζωή μεταβάλλεται)
+void EntityStore::scheduleCrossing(int slot) {
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+
+    double time = crossingTime(b, lane);
+    if (time < 0.0) return;
+
+    TimerWheel* wheel = TimerWheel::getInstance();
+    float delay = (float)(time - wheel->now());
+    b.vital_timer[lane] = wheel->schedule(delay, [this, slot]() { onVitalCrossing(slot); });
+}
+
+// Λήξη του χρονομέτρου: η ζωή τίθεται ακριβώς στο όριο και η θέση σταθεροποιείται
+void EntityStore::onVitalCrossing(int slot) {
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+
+    VitalMode mode = vitalMode(b, lane);
+    if (mode == VitalMode::STEADY) return;
+    int limit = (mode == VitalMode::SICK) ? 0 : b.max_health[lane];
+
+    beginChange(slot);
+    b.health[lane] = limit;  // Χωρίς σφάλμα στρογγυλοποίησης στο όριο
+    b.timer[lane] = 0.0f;
+    endChange(slot);
+}
+
+// Συνεισφορά της θέσης στο άθροισμα: η ζωή από το σημείο αναφοράς ως γραμμική
+// συνάρτηση του χρόνου (με ρυθμό healing_speed, -1 για sickness/μείωση ή 0)
+// Ο χρόνος που έχει ήδη περάσει από το τελευταίο βήμα (timer) μετράει κι αυτός,
+// ώστε η εκτίμηση να απέχει λιγότερο από ένα βήμα από την getHealth
+void EntityStore::addToTotals(int slot) {
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+
+    float rate = 0.0f;
+    switch (vitalMode(b, lane)) {
+    case VitalMode::HEAL:
+        rate = b.healing_speed[lane];
+        break;
+    case VitalMode::SICK:
+    case VitalMode::DECAY:
+        rate = -1.0f;
+        break;
+    default:
+        break;
+    }
+
+    b.total_rate[lane] = rate;
+    b.total_base[lane] = b.health[lane] + rate * (b.timer[lane] - b.vital_time[lane]);
+
+    Total& total = totalOf(b, lane);
+    total.base += b.total_base[lane];
+    total.rate += rate;
+}
+
+// Αφαίρεση ακριβώς της συνεισφοράς που προστέθηκε
+void EntityStore::removeFromTotals(int slot) {
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+
+    Total& total = totalOf(b, lane);
+    total.base -= b.total_base[lane];
+    total.rate -= b.total_rate[lane];
+}
+
+void EntityStore::beginChange(int slot) {
+    removeFromTotals(slot);
+    settle(slot);
+}
+
+void EntityStore::endChange(int slot) {
+    addToTotals(slot);
+    scheduleCrossing(slot);
+}
+
+// Τρέχουσα ζωή
+int EntityStore::getHealth(int slot) const {
+    float remainder;
+    return evaluateHealth(blockOf(slot), laneOf(slot), remainder);
+}
+
+void EntityStore::setHealth(int slot, int health) {
+    beginChange(slot);
+    blockOf(slot).health[laneOf(slot)] = health;
+    endChange(slot);
+}
+
+void EntityStore::setMaxHealth(int slot, int max_health) {
+    beginChange(slot);
+    blockOf(slot).max_health[laneOf(slot)] = max_health;
+    endChange(slot);
+    touchState(slot);
+}
+
+void EntityStore::setHealingSpeed(int slot, float healing_speed) {
+    beginChange(slot);
+    blockOf(slot).healing_speed[laneOf(slot)] = healing_speed;
+    endChange(slot);
+    touchState(slot);
+}
+
+// Αλλαγή πλευράς: μεταφορά και στη λίστα της νέας πλευράς
+void EntityStore::setSide(int slot, Side side) {
+    Block& b = blockOf(slot);
+    int lane = laneOf(slot);
+    if (b.side[lane] == side) return;
+
+    beginChange(slot);
+    removeMember(slot);
+    b.side[lane] = side;
+    addMember(slot);
+    endChange(slot);
+    touchState(slot);
+}
+
+void EntityStore::setSick(int slot, bool sick) {
+    beginChange(slot);
+    blockOf(slot).sick[laneOf(slot)] = sick;
+    endChange(slot);
+    touchState(slot);
+}
+
+void EntityStore::setLevel(int slot, int level) {
+    beginChange(slot);
+    blockOf(slot).level[laneOf(slot)] = level;
+    endChange(slot);
+    touchState(slot);
+}
+
+const std::vector<Entity*>& EntityStore::getMembers(Side side) const {
+    return side_members[static_cast<int>(side)];
+}
+
+const std::vector<Entity*>& EntityStore::getMembers(EntityKind kind) const {
+    return kind_members[kindIndex(kind)];
+}
+
+// Άθροισμα ζωής μιας πλευράς (σταθερό πλήθος αθροισμάτων, ανεξάρτητο από τα entities)
+double EntityStore::getTotalHealth(Side side) const {
+    double now = TimerWheel::getInstance()->now();
+    double sum = 0.0;
+    for (int k = 0; k < KIND_COUNT; k++) {
+        for (int l = 0; l < LEVEL_COUNT; l++) {
+            const Total& total = totals[static_cast<int>(side)][k][l];
+            sum += total.base + total.rate * now;
+        }
+    }
+    return sum;
+}
+
+double EntityStore::getTotalHealth(Side side, EntityKind kind, int level) const {
+    const Total& total = totals[static_cast<int>(side)][kindIndex(kind)][level];
+    return total.base + total.rate * TimerWheel::getInstance()->now();
+}
+
+// Εύρεση entity σε σημείο (κυκλική περιοχή, όπως η Entity::contains)
+Entity* EntityStore::pick(float mx, float my) const {
+    for (size_t bi = 0; bi < blocks.size(); bi++) {
+        int count = std::min(BLOCK_SIZE, slot_count - (int)bi * BLOCK_SIZE);
+        if (count <= 0) break;
+
+        const Block& b = *blocks[bi];
+        for (int i = 0; i < count; i++) {
+            if (!b.alive[i]) continue;
+            float dx = mx - b.x[i];
+            float dy = my - b.y[i];
+            if (dx * dx + dy * dy <= b.size[i] * b.size[i]) {
+                return b.owner[i];
+            }
+        }
+    }
+    return nullptr;
+}
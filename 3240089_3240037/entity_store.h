@@ -0,0 +1,205 @@
+﻿#pragma once
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include "timer_wheel.h"
+
+// Δηλώσεις μπροστά (ορίζονται στο entity.h)
+enum class Side;
+enum class EntityKind : unsigned char;
+class Entity;
+
+// Handle σε entity: θέση στο EntityStore και generation της θέσης
+// Η generation αυξάνεται κάθε φορά που η θέση αποδεσμεύεται, οπότε ένα handle σε
+// entity που δεν υπάρχει πια δεν επιλύεται ποτέ σε άλλο entity που πήρε την ίδια θέση
+// Η μετατροπή Baby κρατάει τη θέση και τη generation: το handle δείχνει στο νέο entity
+struct EntityHandle {
+    int slot = -1;
+    unsigned int generation = 0;
+
+    bool isNull() const { return slot < 0; }
+    bool operator==(const EntityHandle& other) const { return slot == other.slot && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+    bool operator<(const EntityHandle& other) const {
+        if (slot != other.slot) return slot < other.slot;
+        return generation < other.generation;
+    }
+};
+
+// Hash για χρήση σε unordered_map
+struct EntityHandleHash {
+    size_t operator()(const EntityHandle& h) const {
+        return static_cast<size_t>(h.slot) * 2654435761u ^ h.generation;
+    }
+};
+
+// Αποθήκη components όλων των entities
+// Κάθε entity έχει μια θέση (slot) και τα δεδομένα της προσομοίωσης (θέση, ζωή, πλευρά,
+// healing, χρονόμετρα πύργων, cooldowns wizard) ζουν σε συνεχείς πίνακες ανά component
+// Οι πίνακες χωρίζονται σε blocks των BLOCK_SIZE θέσεων που δεν μετακινούνται ποτέ,
+// ώστε οι αναφορές των entities στα components τους να μένουν έγκυρες καθώς η αποθήκη μεγαλώνει
+// Τίποτα δεν ενημερώνεται ανά frame: η ζωή κρατιέται σε ένα σημείο αναφοράς (vital_time)
+// και η τρέχουσα υπολογίζεται σε κλειστή μορφή όταν διαβάζεται (healing, sickness, μείωση
+// πάνω από το μέγιστο). Το όριο της ζωής, οι επιθέσεις πύργων και τα cooldowns των spells
+// είναι χρονόμετρα στο TimerWheel, οπότε τα αδρανή entities δεν κοστίζουν τίποτα ανά frame
+// Το store κρατά επίσης λίστες μελών ανά πλευρά και ανά είδος και αθροίσματα ζωής ανά
+// (πλευρά, είδος, level), που ενημερώνονται σε κάθε αλλαγή αντί να ξαναμετριούνται
+// Κάθε θέση έχει epoch αλλαγών της κατάστασης (πλευρά, είδος, level, sickness, stats), ώστε
+// όσοι κρατούν αποτελέσματα υπολογισμών (π.χ. το AI) να ξέρουν αν ισχύουν ακόμα. Τα epochs
+// έρχονται από έναν μετρητή για όλο το store, οπότε ένα epoch δεν επαναλαμβάνεται ποτέ
+class EntityStore {
+public:
+    static const int BLOCK_SIZE = 256;
+
+    // Πλήθος τιμών των Side, EntityKind και level (ελέγχονται με static_assert στο .cpp)
+    static const int SIDE_COUNT = 3;
+    static const int KIND_COUNT = 4;
+    static const int LEVEL_COUNT = 6;
+
+    // Block θέσεων σε μορφή SoA
+    struct Block {
+        Entity* owner[BLOCK_SIZE];          // Αντικείμενο συμπεριφοράς (draw, upgrades) της θέσης
+        bool alive[BLOCK_SIZE];             // Αν η θέση χρησιμοποιείται
+        unsigned int generation[BLOCK_SIZE]; // Αυξάνεται σε κάθε αποδέσμευση (έλεγχος handles)
+        EntityKind kind[BLOCK_SIZE];
+        Side side[BLOCK_SIZE];
+        int level[BLOCK_SIZE];
+        int side_pos[BLOCK_SIZE];           // Θέση στη λίστα της πλευράς
+        unsigned int state_epoch[BLOCK_SIZE];  // Τελευταία αλλαγή πλευράς, είδους, level, sickness ή stats
+        int kind_pos[BLOCK_SIZE];           // Θέση στη λίστα του είδους
+
+        // Θέση και μέγεθος
+        float x[BLOCK_SIZE], y[BLOCK_SIZE];
+        float size[BLOCK_SIZE];
+
+        // Ζωή και healing
+        int health[BLOCK_SIZE];             // Ζωή τη στιγμή vital_time (η τρέχουσα από την getHealth)
+        double vital_time[BLOCK_SIZE];      // Σημείο αναφοράς του υπολογισμού της ζωής
+        TimerHandle vital_timer[BLOCK_SIZE]; // Λήξη όταν η ζωή φτάνει το όριό της
+        int max_health[BLOCK_SIZE];
+        int original_max_health[BLOCK_SIZE];
+        float healing_speed[BLOCK_SIZE];
+        float timer[BLOCK_SIZE];            // Χρόνος από το τελευταίο βήμα healing/sickness (τη στιγμή vital_time)
+        bool sick[BLOCK_SIZE];
+
+        // Συνεισφορά στο άθροισμα ζωής: ζωή(t) ~ total_base + total_rate * t
+        double total_base[BLOCK_SIZE];
+        float total_rate[BLOCK_SIZE];
+
+        // Tower
+        TimerHandle attack_timer[BLOCK_SIZE]; // Pending όσο διαρκεί το διάστημα μεταξύ βολών
+        float attack_interval[BLOCK_SIZE];
+
+        // Wizard (0=Freeze, 1=Sickness, 2=Convert)
+        TimerHandle spell_timers[BLOCK_SIZE][3]; // Pending όσο διαρκεί το cooldown
+    };
+
+private:
+    static EntityStore* instance;  // Μοναδικό instance (Singleton pattern, όπως το GlobalState)
+
+    std::vector<std::unique_ptr<Block>> blocks;
+    std::vector<int> free_slots;   // Ελεύθερες θέσεις για επαναχρησιμοποίηση
+    int slot_count;                // Πλήθος θέσεων που έχουν δοθεί ποτέ (τα systems σταματούν εδώ)
+    int live_count;                // Θέσεις σε χρήση
+    unsigned int epoch_counter;    // Τελευταίο epoch που δόθηκε (0: καμία αλλαγή)
+
+    void resetComponents(Block& b, int lane, Entity* owner, EntityKind kind, int health);
+
+    // Ζωή σε κλειστή μορφή
+    int evaluateHealth(const Block& b, int lane, float& remainder) const;
+    double crossingTime(const Block& b, int lane) const;
+    void settle(int slot);            // Η τρέχουσα ζωή γίνεται νέο σημείο αναφοράς
+    void scheduleCrossing(int slot);  // Χρονόμετρο για το επόμενο όριο της ζωής
+    void onVitalCrossing(int slot);   // Η ζωή έφτασε το όριο
+    void cancelTimers(Block& b, int lane);
+
+    // Λίστες μελών (η αφαίρεση μεταφέρει το τελευταίο μέλος στη θέση του αφαιρεμένου)
+    std::vector<Entity*> side_members[SIDE_COUNT];
+    std::vector<Entity*> kind_members[KIND_COUNT];
+
+    // Αθροίσματα ζωής ανά (πλευρά, είδος, level) σε γραμμική μορφή ως προς τον χρόνο.
+    // Το άθροισμα τη στιγμή t είναι base + rate * t: οι θέσεις που θεραπεύονται ή χάνουν
+    // ζωή συνεισφέρουν συνεχώς (χωρίς το στρογγύλεμα ανά βήμα, σφάλμα < 1 hp η καθεμία)
+    // και τα όρια διορθώνονται από τα χρονόμετρα του TimerWheel
+    struct Total {
+        double base = 0.0;
+        double rate = 0.0;
+    };
+    Total totals[SIDE_COUNT][KIND_COUNT][LEVEL_COUNT];
+    unsigned int kind_epochs[KIND_COUNT];  // Τελευταία αλλαγή κατάστασης (ή είσοδος/έξοδος) μέλους κάθε είδους
+
+    void touchState(int slot);
+
+    void addMember(int slot);
+    void removeMember(int slot);
+    Total& totalOf(const Block& b, int lane);
+    void addToTotals(int slot);       // Συνεισφορά με βάση το τρέχον σημείο αναφοράς
+    void removeFromTotals(int slot);
+
+    // Κάθε αλλαγή σε ζωή, πλευρά, level κλπ. περικλείεται από αυτά τα δύο
+    void beginChange(int slot);       // Αφαίρεση από τα αθροίσματα και νέο σημείο αναφοράς
+    void endChange(int slot);         // Επιστροφή στα αθροίσματα και χρονόμετρο ορίου
+
+public:
+    EntityStore();
+
+    static EntityStore* getInstance();
+
+    EntityStore(const EntityStore&) = delete;
+    EntityStore& operator=(const EntityStore&) = delete;
+
+    // Δέσμευση θέσης για νέο entity
+    int allocate(Entity* owner, EntityKind kind, Side side, float x, float y, int health);
+
+    // Αλλαγή είδους στην ίδια θέση (μετατροπή Baby): θέση και πλευρά μένουν,
+    // τα υπόλοιπα components επανέρχονται στις αρχικές τιμές του νέου είδους
+    void transform(int slot, Entity* owner, EntityKind kind, int health);
+
+    // Αποδέσμευση θέσης
+    void release(int slot);
+
+    Block& blockOf(int slot) { return *blocks[slot / BLOCK_SIZE]; }
+    const Block& blockOf(int slot) const { return *blocks[slot / BLOCK_SIZE]; }
+    static int laneOf(int slot) { return slot % BLOCK_SIZE; }
+
+    // Handle για τη θέση slot (null handle αν η θέση δεν χρησιμοποιείται)
+    EntityHandle handleOf(int slot) const;
+
+    // Επίλυση handle σε O(1): nullptr αν το entity δεν υπάρχει πια
+    Entity* resolve(EntityHandle handle) const {
+        if (handle.slot < 0 || handle.slot >= slot_count) return nullptr;
+        const Block& b = blockOf(handle.slot);
+        int lane = laneOf(handle.slot);
+        if (!b.alive[lane] || b.generation[lane] != handle.generation) return nullptr;
+        return b.owner[lane];
+    }
+
+    // Ζωή και ό,τι επηρεάζει τον ρυθμό της (κάθε αλλαγή ξεκινά νέο σημείο αναφοράς)
+    int getHealth(int slot) const;
+    void setHealth(int slot, int health);
+    void setMaxHealth(int slot, int max_health);
+    void setHealingSpeed(int slot, float healing_speed);
+    void setSide(int slot, Side side);
+    void setSick(int slot, bool sick);
+    void setLevel(int slot, int level);
+
+    // Αλλαγή που δεν περνά από τους setters (π.χ. stats των υποκλάσεων όπως ο κλάδος splash)
+    void markChanged(int slot) { touchState(slot); }
+
+    // Epochs αλλαγών (ίδιο epoch: καμία αλλαγή από τότε)
+    unsigned int getStateEpoch(int slot) const { return blockOf(slot).state_epoch[laneOf(slot)]; }
+    unsigned int getKindEpoch(EntityKind kind) const;
+
+    // Μέλη ανά πλευρά ή είδος (χωρίς αντιγραφή - η σειρά αλλάζει όταν φεύγει κάποιο μέλος)
+    const std::vector<Entity*>& getMembers(Side side) const;
+    const std::vector<Entity*>& getMembers(EntityKind kind) const;
+
+    // Συνολική ζωή σε O(1) ως προς το πλήθος των entities
+    double getTotalHealth(Side side) const;
+    double getTotalHealth(Side side, EntityKind kind, int level) const;
+
+    // Entity στο σημείο (mx, my) - το πρώτο στη σειρά των θέσεων
+    Entity* pick(float mx, float my) const;
+
+    int getLiveCount() const { return live_count; }
+};
@@ -1,16 +1,39 @@
 ﻿#include "global_state.h"
 #include "ai_system.h"
+#include "status_effects.h"
 #include "sgg/graphics.h"
 #include <algorithm>
 #include <cmath>
+#include <functional>
 
 // Αρχικοποίηση static μεταβλητής για Singleton pattern
 GlobalState * GlobalState::instance = nullptr;
 
+// Απόσταση επαφής troops (κάθε troop έχει ακτίνα 0.2)
+const float GlobalState::TROOP_CONTACT_DISTANCE = 0.4f;
+
+// Προετοιμασία spells
+const float GlobalState::SPELL_PREP_TIME = 2.0f;
+
+// Συνεχής αποστολή troops
+const float GlobalState::STREAM_HOLD_DELAY = 0.25f;
+const float GlobalState::STREAM_INTERVAL = 0.05f;  // 20 troops ανά δευτερόλεπτο
+const int GlobalState::STREAM_TROOP_SIZE = 1;
+
+// Χρόνος αναζήτησης του AI ανά απόφαση για κάθε level, όταν είναι ενεργή η δυσκολία με
+// αναζήτηση (η δυσκολία ανεβαίνει με το level)
+const float GlobalState::AI_SEARCH_BUDGET_PER_LEVEL = 10.0f;
+
+// Αυτόματο παιχνίδι: ένας αγώνας χωρίς νικητή σταματά στα 3 λεπτά (όπως ο SelfPlayMatch)
+const float GlobalState::AUTOPLAY_MAX_SECONDS = 180.0f;
+
+// Ίχνος αποφάσεων: αιχμή είναι ένα tick του AI πάνω από 4 ms (ένα τέταρτο του frame στα 60 FPS)
+const float GlobalState::AI_TRACE_SPIKE_US = 4000.0f;
+const float GlobalState::AI_TRACE_SPIKE_COOLDOWN_MS = 5000.0f;
+
 // Κατασκευαστής - αρχικοποίηση όλων των μελών
-GlobalState::GlobalState() : selected_entity(nullptr),
-target_selection_wizard(nullptr), target_selection_spell_id(-1),
-ai_system(nullptr) {
+GlobalState::GlobalState() : target_selection_spell_id(-1),
+ai_system(nullptr), autoplayer(nullptr), autoplay(false), autoplay_match_start(0.0), custom_ai_params(false), ai_search(false), ai_trace_cooldown(0.0f), ai_trace_key(false), stream_hold_time(0.0f), stream_timer(0.0f), stream_active(false) {
     // Ο constructor του pause_menu και level_manager καλούνται αυτόματα
 }
 
@@ -24,6 +47,7 @@ GlobalState* GlobalState::getInstance() {
 
 // Αρχικοποίηση παιχνιδιού - ξεκινάει από level 1
 void GlobalState::init() {
+    opening_book.load(OpeningBook::DEFAULT_FILE);  // Χωρίς αρχείο το AI αποφασίζει από την αρχή
     initLevel(1); // Εκκίνηση από το πρώτο level
 }
 
@@ -31,13 +55,17 @@ void GlobalState::init() {
 void GlobalState::initLevel(int level) {
     // ΚΑΘΑΡΙΣΜΟΣ ΟΛΩΝ ΤΩΝ ΔΕΔΟΜΕΝΩΝ
     entities.clear();           // Καθαρισμός όλων των οντοτήτων
-    troops.clear();             // Καθαρισμός όλων των troops
-    attack_effects.clear();     // Καθαρισμός οπτικών effects
+    releaseAllTroops();         // Καθαρισμός όλων των troops
+    pending_spawns.clear();     // Καθαρισμός αιτημάτων αποστολής
+    stream_source = EntityHandle();  // Τέλος συνεχούς αποστολής
+    stream_target = EntityHandle();
+    stream_active = false;
+    particles.clear();          // Καθαρισμός οπτικών effects
     entity_graph.clear();       // Καθαρισμός γράφου συνδέσεων
-    selected_entity = nullptr;  // Μηδενισμός επιλεγμένης οντότητας
+    selected_entity = EntityHandle();  // Μηδενισμός επιλεγμένης οντότητας
     hover_menu.hide();          // Απόκρυψη hover menu
     ready_spells.clear();       // Καθαρισμός ready spells
-    target_selection_wizard = nullptr;   // Μηδενισμός επιλεγμένου wizard
+    target_selection_wizard = EntityHandle();  // Μηδενισμός επιλεγμένου wizard
     target_selection_spell_id = -1;      // Επαναφορά spell ID
     pause_menu.reset();         // Επαναφορά pause menu
 
@@ -46,16 +74,37 @@ void GlobalState::initLevel(int level) {
         delete ai_system;
         ai_system = nullptr;
     }
+    if (autoplayer) {
+        delete autoplayer;
+        autoplayer = nullptr;
+    }
 
     // ΑΡΧΙΚΟΠΟΙΗΣΗ LEVEL
     level_manager.initLevel(level, entities, entity_graph);  // Δημιουργία οντοτήτων και γράφου
 
     // ΔΗΜΙΟΥΡΓΙΑ AI SYSTEM
+    // Budget 0: αποστολές από τους κανόνες/policy του AI (η αναζήτηση είναι προαιρετική δυσκολία)
+    float search_budget = ai_search ? AI_SEARCH_BUDGET_PER_LEVEL * level : 0.0f;
     ai_system = new AISystem(this, &entity_graph);
     if (ai_system) {
+        // Οι παράμετροι ρυθμίζουν μόνο τους κανόνες και την policy, που δεν τρέχουν με αναζήτηση
+        ai_system->setSearchBudget(custom_ai_params ? 0.0f : search_budget);
+        if (custom_ai_params) ai_system->setParams(ai_params);
+        ai_system->setTrace(&ai_trace);
+        setAIOpening(ai_system, level);
         ai_system->init();  // Αρχικοποίηση AI
     }
 
+    // Σε αυτόματο παιχνίδι και η πλευρά του παίκτη ελέγχεται από AI
+    if (autoplay) {
+        autoplay_match_start = TimerWheel::getInstance()->now();
+        autoplayer = new AISystem(this, &entity_graph, Side::PLAYER, Side::ENEMY);
+        autoplayer->setSearchBudget(search_budget);
+        autoplayer->setTrace(&ai_trace);
+        setAIOpening(autoplayer, level);
+        autoplayer->init();
+    }
+
     // Ενημέρωση pause menu για τη διαθεσιμότητα επόμενου level
     pause_menu.setNextLevelAvailable(level_manager.hasNextLevel());
 
@@ -73,6 +122,9 @@ void GlobalState::update(float dt) {
 
     pause_menu.update(canvas_x, canvas_y, mouse.button_left_pressed);  // Ενημέρωση pause menu
 
+    // Dump του ίχνους των AI (και στην παύση, π.χ. αμέσως μετά από μια περίεργη απόφαση)
+    if (ai_trace.isEnabled()) updateAITrace(dt);
+
     // Αν το παιχνίδι είναι paused, διαχείριση μόνο του μενού
     if (pause_menu.isGamePaused()) {
         if (pause_menu.isResumeClicked()) {
@@ -100,10 +152,9 @@ void GlobalState::update(float dt) {
 
     // ΚΑΝΟΝΙΚΗ ΕΝΗΜΕΡΩΣΗ ΠΑΙΧΝΙΔΙΟΥ
 
-    // Ενημέρωση όλων των οντοτήτων
-    for (auto& entity : entities) {
-        entity->update(dt);
-    }
+    // Προώθηση του χρόνου: λήγουν μόνο τα χρονόμετρα που έφτασαν (όρια ζωής, βολές πύργων,
+    // cooldowns, αποφάσεις AI, προετοιμασία spells) - τα υπόλοιπα δεν κοστίζουν τίποτα
+    TimerWheel::getInstance()->advance(dt);
 
     // Ενημέρωση όλων των troops
     for (auto& troop : troops) {
@@ -111,19 +162,102 @@ void GlobalState::update(float dt) {
     }
 
     // Επεξεργασία διαφόρων συστημάτων
+    handleTroopCombat();       // Μάχη troops στη διαδρομή
     handleTowerAttacks();      // Επιθέσεις πύργων
     handleTroopArrivals();     // Άφιξη troops στους στόχους
-    updateAttackEffects(dt);   // Ενημέρωση οπτικών effects
-    updateReadySpells(dt);     // Ενημέρωση spells
+    particles.update(dt);      // Ενημέρωση οπτικών effects
+    updateReadySpells();       // Ενημέρωση spells
 
     // Ενημέρωση AI system αν υπάρχει
     if (ai_system) {
         ai_system->update(dt);
     }
+    if (autoplayer) {
+        autoplayer->update(dt);
+    }
+    if (ai_trace.isEnabled()) checkAITraceSpike();
+
+    // Επεξεργασία UI (όχι σε αυτόματο παιχνίδι - ο παίκτης είναι το autoplayer)
+    if (!autoplay) {
+        handleHoverMenu(canvas_x, canvas_y);                // Hover menu
+        handleMouseInput(canvas_x, canvas_y, mouse.button_left_pressed);  // Κλικ ποντικιού
+        updateTroopStream(dt, mouse.button_left_down);                    // Συνεχής αποστολή troops
+    }
+
+    // Δημιουργία όλων των troops που ζητήθηκαν σε αυτό το frame (παίκτης και AI)
+    flushTroopSpawns();
+
+    if (autoplay) {
+        checkAutoplayMatch();
+    }
+}
+
+// Άνοιγμα του βιβλίου για το level, αν η διάταξη είναι αυτή για την οποία υπολογίστηκε
+// (οι κινήσεις αναφέρονται στα entities με τη σειρά δημιουργίας τους)
+// Τα ανοίγματα ελέγχθηκαν μόνο απέναντι στους κανόνες, οπότε με αναζήτηση δεν χρησιμοποιούνται
+void GlobalState::setAIOpening(AISystem* ai, int level) {
+    if (opening_book.getLines().empty() || ai_search) return;
+
+    const OpeningLine* line = opening_book.find(level, ai->getSide(), OpeningBook::hashLayout(entities));
+    if (!line) return;
+
+    std::vector<EntityHandle> layout;
+    layout.reserve(entities.size());
+    for (const std::unique_ptr<Entity>& entity : entities) {
+        layout.push_back(entity->getHandle());
+    }
+    ai->setOpening(*line, layout);
+}
+
+void GlobalState::updateAITrace(float dt) {
+    bool key = graphics::getKeyState(graphics::SCANCODE_F9);
+    if (key && !ai_trace_key) dumpAITrace("ai_trace.bin");
+    ai_trace_key = key;
+
+    ai_trace_cooldown = std::max(0.0f, ai_trace_cooldown - dt);
+}
+
+// Αιχμή μετριέται στη δουλειά των AI στο tick (όπως το cost_us του TICK), όχι στο dt του frame,
+// που περιλαμβάνει και τη σχεδίαση - οπότε η εγγραφή TICK της αιχμής είναι ήδη στο ίχνος
+void GlobalState::checkAITraceSpike() {
+    if (ai_trace_cooldown > 0.0f) return;
+
+    float tick_us = ai_system ? ai_system->getLastTickUs() : 0.0f;
+    if (autoplayer) tick_us = std::max(tick_us, autoplayer->getLastTickUs());
+    if (tick_us > AI_TRACE_SPIKE_US) {
+        dumpAITrace("ai_trace_spike.bin");
+        ai_trace_cooldown = AI_TRACE_SPIKE_COOLDOWN_MS;
+    }
+}
+
+// Πρώτα οι εγγραφές που ο worker κάθε AI δεν έχει παραδώσει ακόμα
+bool GlobalState::dumpAITrace(const std::string& path) {
+    if (ai_system) ai_system->flushTrace();
+    if (autoplayer) autoplayer->flushTrace();
+    return ai_trace.dump(path);
+}
+
+// Τέλος αγώνα σε αυτόματο παιχνίδι: όταν μια πλευρά δεν έχει πια ούτε entities ούτε troops
+// σε κίνηση (όπως στον SelfPlayMatch) ή μετά από AUTOPLAY_MAX_SECONDS ξεκινά το επόμενο level
+// (μετά το τελευταίο ξανά το πρώτο), ώστε οι αγώνες να συνεχίζονται χωρίς επίβλεψη
+void GlobalState::checkAutoplayMatch() {
+    bool timeout = TimerWheel::getInstance()->now() - autoplay_match_start >= AUTOPLAY_MAX_SECONDS;
+    if (!timeout) {
+        EntityStore* store = EntityStore::getInstance();
+        bool player_alive = !store->getMembers(Side::PLAYER).empty();
+        bool enemy_alive = !store->getMembers(Side::ENEMY).empty();
+        for (Troop* troop : troops) {
+            if (player_alive && enemy_alive) break;
+            Side side = troop->getSide();
+            if (side == Side::PLAYER) player_alive = true;
+            else if (side == Side::ENEMY) enemy_alive = true;
+        }
+        if (player_alive && enemy_alive) return;
+    }
 
-    // Επεξεργασία UI
-    handleHoverMenu(canvas_x, canvas_y);                // Hover menu
-    handleMouseInput(canvas_x, canvas_y, mouse.button_left_pressed);  // Κλικ ποντικιού
+    int next_level = level_manager.getCurrentLevel() + 1;
+    if (next_level > level_manager.getMaxLevels()) next_level = 1;
+    initLevel(next_level);
 }
 
 // Σχεδίαση όλων των στοιχείων του παιχνιδιού
@@ -149,17 +283,17 @@ void GlobalState::draw() {
     }
 
     // Σχεδίαση οπτικών effects
-    drawAttackEffects();
+    particles.draw();
 
     // Σχεδίαση highlight για επιλεγμένη οντότητα
-    if (selected_entity) {
+    if (Entity* selected = resolve(selected_entity)) {
         graphics::Brush hl;
         hl.fill_color[0] = hl.fill_color[1] = 1.0f; hl.fill_color[2] = 0.0f;  // Κίτρινο περίγραμμα
         hl.fill_opacity = 0.0f;    // Διαφανές εσωτερικό
         hl.outline_opacity = 1.0f; // Ορατό περίγραμμα
         hl.outline_width = 3.0f;   // Πάχος περιγράμματος
-        graphics::drawDisk(selected_entity->getX(), selected_entity->getY(),
-            selected_entity->getSize() + 0.1f, hl);
+        graphics::drawDisk(selected->getX(), selected->getY(),
+            selected->getSize() + 0.1f, hl);
     }
 
     // Σχεδίαση hover menu
@@ -188,42 +322,76 @@ GlobalState::~GlobalState() {
         delete ai_system;
         ai_system = nullptr;
     }
+    if (autoplayer) {
+        delete autoplayer;
+        autoplayer = nullptr;
+    }
+    releaseAllTroops();
 }
 
-// Ενημέρωση προετοιμασίας spells
-void GlobalState::updateReadySpells(float dt) {
-    float dt_seconds = dt / 1000.0f;
+// Επίλυση handle σε Wizard
+Wizard* GlobalState::resolveWizard(EntityHandle handle) const {
+    Entity* entity = resolve(handle);
+    if (!entity || entity->getKind() != EntityKind::WIZARD) return nullptr;
+    return static_cast<Wizard*>(entity);
+}
 
-    // Ενημέρωση χρόνου προετοιμασίας για spells που προετοιμάζονται
+// Ολοκλήρωση προετοιμασίας spell (καλείται από το TimerWheel μετά από SPELL_PREP_TIME)
+void GlobalState::markSpellReady(EntityHandle wizard, int spell_id) {
     for (auto& spell : ready_spells) {
-        if (!spell.is_ready) {
-            spell.prep_time += dt_seconds;
-
-            // Έλεγχος ολοκλήρωσης προετοιμασίας (2 δευτερόλεπτα)
-            if (spell.prep_time >= 2.0f) {
-                spell.is_ready = true;
-                spell.prep_time = 2.0f;  // Περικοπή στο μέγιστο
-            }
+        if (!spell.is_ready && spell.wizard == wizard && spell.spell_id == spell_id) {
+            spell.is_ready = true;
+            return;
         }
     }
+}
 
+// Έλεγχος των spells που προετοιμάζονται ή είναι έτοιμα
+void GlobalState::updateReadySpells() {
     // Αφαίρεση μη έγκυρων ready spells (wizard πέθανε ή μετατράπηκε)
     ready_spells.erase(
         std::remove_if(ready_spells.begin(), ready_spells.end(),
-            [](const ReadySpell& s) {
-                return !s.wizard || s.wizard->getSide() != Side::PLAYER;
+            [this](const ReadySpell& s) {
+                const Wizard* wizard = resolveWizard(s.wizard);
+                return !wizard || wizard->getSide() != Side::PLAYER;
             }),
         ready_spells.end()
     );
 }
 
+// Χρώμα effects ανά πλευρά (ίδιο με τα χρώματα των entities)
+static const float* sideColor(Side side) {
+    static const float player[3] = { 0.1f, 0.1f, 1.0f };
+    static const float enemy[3] = { 1.0f, 0.1f, 0.1f };
+    static const float neutral[3] = { 0.8f, 0.8f, 0.8f };
+
+    if (side == Side::PLAYER) return player;
+    if (side == Side::ENEMY) return enemy;
+    return neutral;
+}
+
 // Επεξεργασία troops που έφτασαν στους στόχους τους
 void GlobalState::handleTroopArrivals() {
-    for (auto it = troops.begin(); it != troops.end(); ) {
-        if ((*it)->hasArrived()) {
-            Entity* target = (*it)->getTarget();
-            Entity* source = (*it)->getSource();
-            int amount = (*it)->getHealthAmount();
+    size_t kept = 0;
+
+    for (size_t i = 0; i < troops.size(); i++) {
+        Troop* troop = troops[i];
+        Entity* target = troop->getTarget();
+        Entity* source = troop->getSource();
+
+        if (!target || !source) {
+            // Η πηγή ή ο στόχος δεν υπάρχουν πια (stale handle) - αφαίρεση
+            troop_ledger.remove(troop);
+            troop_pool.release(troop);
+        }
+        else if (troop->hasArrived()) {
+            int amount = troop->getHealthAmount();
+
+            // Σύντομος δακτύλιος άφιξης στο χρώμα της πηγής
+            const float* color = sideColor(source->getSide());
+            particles.spawn(target->getX(), target->getY(), target->getX(), target->getY(),
+                target->getSize() * 0.5f, target->getSize() * 0.8f, 0.25f,
+                color[0], color[1], color[2], ParticleSystem::RING);
 
             if (target->getSide() == source->getSide()) {
                 // ΙΔΙΑ ΠΛΕΥΡΑ: Προσθήκη HP
@@ -237,106 +405,414 @@ void GlobalState::handleTroopArrivals() {
                     // Μετατροπή οντότητας αν η ζωή γίνει αρνητική
                     target->setSide(source->getSide());
                     target->setHealth(std::abs(target->getHealth()));
+                    spawnCaptureEffect(target);
                 }
             }
 
-            it = troops.erase(it);  // Αφαίρεση του troop
+            troop_ledger.remove(troop);
+            troop_pool.release(troop);  // Αφαίρεση του troop
         }
-        else if ((*it)->isDead()) {
+        else if (troop->isDead()) {
             // Αφαίρεση νεκρών troops
-            it = troops.erase(it);
+            troop_ledger.remove(troop);
+            troop_pool.release(troop);
         }
         else {
-            ++it;
+            troops[kept++] = troop;  // Το troop συνεχίζει
+        }
+    }
+
+    troops.resize(kept);
+}
+
+// Effect μετατροπής: δακτύλιος που ανοίγει γύρω από την οντότητα στο χρώμα της νέας πλευράς
+void GlobalState::spawnCaptureEffect(const Entity* target) {
+    const float* color = sideColor(target->getSide());
+    particles.spawn(target->getX(), target->getY(), target->getX(), target->getY(),
+        target->getSize() * 0.5f, target->getSize() * 1.5f, 0.6f,
+        color[0], color[1], color[2], ParticleSystem::RING);
+}
+
+// Effect ρίψης spell: βολή από τον wizard και δακτύλιος στον στόχο
+void GlobalState::spawnSpellEffect(const Entity* caster, const Entity* target, int spell_id) {
+    if (!caster || !target) return;
+
+    // Ίδια χρώματα με τους δείκτες των ready spells
+    float r = 1.0f, g = 0.3f, b = 0.3f;        // Convert - Κόκκινο
+    if (spell_id == 0) { r = 0.3f; g = 0.3f; b = 1.0f; }       // Freeze - Μπλε
+    else if (spell_id == 1) { r = 0.3f; g = 1.0f; b = 0.3f; }  // Sickness - Πράσινο
+
+    particles.spawn(caster->getX(), caster->getY(), target->getX(), target->getY(),
+        0.2f, 0.2f, 0.4f, r, g, b, ParticleSystem::DISK);
+    particles.spawn(target->getX(), target->getY(), target->getX(), target->getY(),
+        target->getSize() * 0.3f, target->getSize() * 1.2f, 0.8f, r, g, b, ParticleSystem::RING);
+}
+
+// Επιστροφή όλων των troops στο pool
+void GlobalState::releaseAllTroops() {
+    troop_ledger.clear();
+    for (Troop* troop : troops) {
+        troop_pool.release(troop);
+    }
+    troops.clear();
+}
+
+// Αίτημα αποστολής troop
+bool GlobalState::spawnTroop(Entity* from, Entity* to, int amount) {
+    if (!from || !to || amount <= 0) return false;
+
+    std::shared_ptr<const PathData> path = entity_graph.getSharedPath(from, to);
+    if (!path || path->waypoints.empty()) return false;
+
+    TroopSpawn spawn;
+    spawn.source = from->getHandle();
+    spawn.target = to->getHandle();
+    spawn.amount = amount;
+    spawn.path = std::move(path);
+    pending_spawns.push_back(std::move(spawn));
+
+    from->setHealth(from->getHealth() - amount);
+    return true;
+}
+
+// Ομαδική δημιουργία troops - μία δέσμευση θέσεων για όλο το frame
+void GlobalState::flushTroopSpawns() {
+    if (pending_spawns.empty()) return;
+
+    troop_pool.reserve(pending_spawns.size());
+    troops.reserve(troops.size() + pending_spawns.size());
+
+    for (auto& spawn : pending_spawns) {
+        // Η πηγή ή ο στόχος μπορεί να μην υπάρχουν πια (τα handles το ελέγχουν)
+        Entity* source = resolve(spawn.source);
+        Entity* target = resolve(spawn.target);
+        if (!source || !target) continue;
+
+        Troop* troop = troop_pool.acquire(source, target, spawn.amount, std::move(spawn.path));
+        troops.push_back(troop);
+        troop_ledger.add(troop);
+    }
+    pending_spawns.clear();
+}
+
+// Συνεχής αποστολή troops όσο είναι πατημένο το κουμπί
+void GlobalState::updateTroopStream(float dt, bool mouse_down) {
+    if (stream_source.isNull()) return;
+
+    // Η πηγή δεν ανήκει πια στον παίκτη ή κάποιο άκρο δεν υπάρχει - ακύρωση αποστολής
+    Entity* source = resolve(stream_source);
+    Entity* target = resolve(stream_target);
+    if (!source || !target || source->getSide() != Side::PLAYER) {
+        stream_source = EntityHandle();
+        stream_target = EntityHandle();
+        stream_active = false;
+        return;
+    }
+
+    float dt_seconds = dt / 1000.0f;
+
+    if (!mouse_down) {
+        // Σύντομο κλικ: ένα troop με το 50% της ζωής (όπως πάντα)
+        if (!stream_active) {
+            int amount = source->getHealth() / 2;
+            if (amount > 0) {
+                spawnTroop(source, target, amount);
+            }
+        }
+        stream_source = EntityHandle();
+        stream_target = EntityHandle();
+        stream_active = false;
+        return;
+    }
+
+    stream_hold_time += dt_seconds;
+    if (!stream_active) {
+        if (stream_hold_time < STREAM_HOLD_DELAY) return;
+        stream_active = true;           // Το κουμπί κρατήθηκε αρκετά - έναρξη ροής
+        stream_timer = STREAM_INTERVAL; // Το πρώτο troop φεύγει αμέσως
+    }
+
+    // Σταθερός ρυθμός ανεξάρτητα από τα FPS (σε αργά frames φεύγουν περισσότερα troops μαζί)
+    stream_timer += dt_seconds;
+    while (stream_timer >= STREAM_INTERVAL) {
+        stream_timer -= STREAM_INTERVAL;
+        if (source->getHealth() <= STREAM_TROOP_SIZE) {
+            stream_timer = 0.0f;  // Η πηγή άδειασε - αναμονή για healing
+            break;
+        }
+        spawnTroop(source, target, STREAM_TROOP_SIZE);
+    }
+}
+
+// Σύγκρουση δύο αντίπαλων troops - και τα δύο χάνουν όσο hp έχει το μικρότερο
+static void resolveTroopClash(Troop* a, Troop* b) {
+    if (a->isDead() || b->isDead()) return;
+    if (a->getSide() == b->getSide()) return;
+
+    int clash = std::min(a->getHealthAmount(), b->getHealthAmount());
+    a->reduceHealth(clash);
+    b->reduceHealth(clash);
+}
+
+// Μάχη αντίπαλων troops στη μέση της διαδρομής
+// Αντί για έλεγχο όλων των ζευγών (O(n^2)) χρησιμοποιείται sweep-and-prune:
+// 1. Troops της ίδιας ακμής ταξινομούνται βάσει προόδου στην ακμή
+// 2. Όλα τα troops ταξινομούνται στον άξονα x
+// Τα μονοπάτια των δύο κατευθύνσεων μιας ακμής υπολογίζονται χωριστά (με αποφυγή εμποδίων),
+// οπότε η πρόοδος στην ακμή μόνο περιορίζει τα ζεύγη της φάσης 1 - η σύγκρουση κρίνεται
+// πάντα με την πραγματική απόσταση. Ζεύγη της ίδιας ακμής που η πρόοδος δεν έφερε κοντά
+// ελέγχονται στη φάση 2 (όσα συγκρούστηκαν στη φάση 1 έχουν ήδη νεκρό troop)
+void GlobalState::handleTroopCombat() {
+    combat_entries.clear();
+    combat_sweep.clear();
+
+    for (Troop* troop : troops) {
+        if (troop->hasArrived() || troop->isDead()) continue;
+
+        // Η ακμή αναπαρίσταται με σταθερή σειρά άκρων ώστε troops
+        // με αντίθετη κατεύθυνση να καταλήγουν στην ίδια ομάδα
+        EntityHandle src = troop->getSourceHandle();
+        EntityHandle tgt = troop->getTargetHandle();
+        bool forward = src < tgt;
+        float along = troop->getEdgeParam() * troop->getPathLength();
+
+        CombatEntry entry;
+        entry.edge_a = forward ? src : tgt;
+        entry.edge_b = forward ? tgt : src;
+        entry.s = forward ? along : troop->getPathLength() - along;
+        entry.troop = troop;
+        combat_entries.push_back(entry);
+        combat_sweep.push_back(troop);
+    }
+
+    if (combat_entries.size() < 2) return;
+
+    // ΦΑΣΗ 1: Ίδια ακμή - ταξινόμηση ανά (ακμή, θέση στην ακμή)
+    std::sort(combat_entries.begin(), combat_entries.end(),
+        [](const CombatEntry& l, const CombatEntry& r) {
+            if (l.edge_a != r.edge_a) return l.edge_a < r.edge_a;
+            if (l.edge_b != r.edge_b) return l.edge_b < r.edge_b;
+            return l.s < r.s;
+        });
+
+    const float contact_sq = TROOP_CONTACT_DISTANCE * TROOP_CONTACT_DISTANCE;
+    for (size_t i = 0; i < combat_entries.size(); i++) {
+        const CombatEntry& a = combat_entries[i];
+        for (size_t j = i + 1; j < combat_entries.size(); j++) {
+            const CombatEntry& b = combat_entries[j];
+            // Τέλος ομάδας ή εκτός παραθύρου επαφής - κανένα επόμενο δεν μπορεί να συγκρουστεί
+            if (b.edge_a != a.edge_a || b.edge_b != a.edge_b) break;
+            if (b.s - a.s > TROOP_CONTACT_DISTANCE) break;
+
+            float dx = b.troop->getX() - a.troop->getX();
+            float dy = b.troop->getY() - a.troop->getY();
+            if (dx * dx + dy * dy <= contact_sq) resolveTroopClash(a.troop, b.troop);
+        }
+    }
+
+    // ΦΑΣΗ 2: Όλα τα ζεύγη που είναι πραγματικά κοντά - sweep-and-prune στον άξονα x
+    std::sort(combat_sweep.begin(), combat_sweep.end(),
+        [](const Troop* l, const Troop* r) { return l->getX() < r->getX(); });
+
+    for (size_t i = 0; i < combat_sweep.size(); i++) {
+        Troop* a = combat_sweep[i];
+        if (a->isDead()) continue;
+
+        for (size_t j = i + 1; j < combat_sweep.size(); j++) {
+            Troop* b = combat_sweep[j];
+            float dx = b->getX() - a->getX();
+            if (dx > TROOP_CONTACT_DISTANCE) break;
+            if (b->isDead()) continue;  // Π.χ. ζεύγος της ίδιας ακμής που συγκρούστηκε στη φάση 1
+
+            float dy = b->getY() - a->getY();
+            if (dx * dx + dy * dy <= contact_sq) {
+                resolveTroopClash(a, b);
+                if (a->isDead()) break;
+            }
         }
     }
 }
 
 // Επεξεργασία επιθέσεων πύργων σε κοντινά troops
 void GlobalState::handleTowerAttacks() {
-    // Μετατροπή vector smart pointers σε raw pointers για τη συνάρτηση επίθεσης
-    std::vector<Troop*> troop_ptrs;
-    for (auto& troop : troops) {
-        troop_ptrs.push_back(troop.get());
+    // Οι πίνακες έκθεσης ξαναχτίζονται μόνο όταν αλλάξουν μονοπάτια ή πύργοι
+    if (entity_graph.isExposureDirty()) {
+        entity_graph.buildExposure(entities);
     }
 
+    buildEdgeTroopIndex();
+    bool hash_built = false;
+
     // Για κάθε πύργο, επίθεση σε κοντινά troops
     for (auto& entity : entities) {
-        if (entity->getType() == "Tower") {
-            Tower* tower = static_cast<Tower*>(entity.get());
-            tower->attackNearbyTroops(troop_ptrs, attack_effects);
+        if (entity->getKind() != EntityKind::TOWER) continue;
+        Tower* tower = static_cast<Tower*>(entity.get());
+        if (!tower->isAttackReady()) continue;
+
+        tower_candidates.clear();
+
+        const TowerExposure* table = entity_graph.getTowerExposure(tower);
+        if (table && table->level != tower->getLevel()) {
+            // Ο πύργος αναβαθμίστηκε από τότε που χτίστηκαν οι πίνακες
+            entity_graph.invalidateExposure();
+            entity_graph.buildExposure(entities);
+            table = entity_graph.getTowerExposure(tower);
         }
-    }
-}
 
-// Ενημέρωση οπτικών effects επιθέσεων
-void GlobalState::updateAttackEffects(float dt) {
-    float dt_seconds = dt / 1000.0f;
+        if (table) {
+            gatherExposedTroops(*table);
 
-    for (auto it = attack_effects.begin(); it != attack_effects.end(); ) {
-        it->elapsed += dt_seconds;
-        if (it->elapsed >= it->duration) {
-            it = attack_effects.erase(it);  // Αφαίρεση ολοκληρωμένων effects
+            // Οι πίνακες ισχύουν μόνο για τα τρέχοντα μονοπάτια - τα troops σε παλαιότερα από το hash τους
+            if (!stale_troops.empty()) {
+                stale_troop_hash.forEachEnemyInRadius(tower->getX(), tower->getY(), tower->getAttackRadius(),
+                    tower->getSide(), [this](Troop* troop) { tower_candidates.push_back(troop); });
+            }
         }
         else {
-            ++it;
+            // Πύργος χωρίς πίνακα (δεν θα έπρεπε να συμβαίνει) - ερώτηση στο χωρικό hash
+            if (!hash_built) {
+                troop_hash.build(troops);
+                hash_built = true;
+            }
+            troop_hash.forEachEnemyInRadius(tower->getX(), tower->getY(), tower->getAttackRadius(),
+                tower->getSide(), [this](Troop* troop) { tower_candidates.push_back(troop); });
+        }
+
+        Troop* hit = tower->attackNearbyTroops(tower_candidates, particles);
+        if (hit && tower->isSplash()) {
+            splash_impacts.push_back({ hit->getX(), hit->getY(), tower->getSplashRadius(),
+                tower->getSplashDamage(), tower->getSide() });
         }
     }
+
+    resolveSplashImpacts(hash_built);
 }
 
-// Σχεδίαση οπτικών effects επιθέσεων
-void GlobalState::drawAttackEffects() {
-    for (const auto& effect : attack_effects) {
-        float progress = effect.elapsed / effect.duration;
-        float alpha = 1.0f - progress;  // Απόσβεση με το χρόνο
+// Εφαρμογή όλων των βολών splash του tick
+// Το χωρικό hash χτίζεται μία φορά για όλες τις βολές, οπότε κάθε βολή εξετάζει μόνο
+// τα λίγα κελιά γύρω από το σημείο πρόσκρουσης όσα troops κι αν έχουν μαζευτεί
+void GlobalState::resolveSplashImpacts(bool hash_built) {
+    if (splash_impacts.empty()) return;
 
-        graphics::Brush br;
-        br.fill_color[0] = effect.r;
-        br.fill_color[1] = effect.g;
-        br.fill_color[2] = effect.b;
-        br.fill_opacity = alpha;
-        br.outline_opacity = alpha;
-        br.outline_width = 3.0f;
+    // Τα troops δεν κινούνται μέσα στο tick, οπότε ένα ήδη χτισμένο hash είναι ακόμα έγκυρο
+    if (!hash_built) {
+        troop_hash.build(troops);
+    }
 
-        // Υπολογισμός τρέχουσας θέσης (γραμμική παρεμβολή)
-        float current_x = effect.start_x + (effect.end_x - effect.start_x) * progress;
-        float current_y = effect.start_y + (effect.end_y - effect.start_y) * progress;
+    for (const SplashImpact& impact : splash_impacts) {
+        int damage = impact.damage;
+        troop_hash.forEachEnemyInRadius(impact.x, impact.y, impact.radius, impact.side,
+            [damage](Troop* troop) { troop->reduceHealth(damage); });
 
-        // Σχεδίαση προβολής (δίσκος)
-        graphics::drawDisk(current_x, current_y, 0.15f, br);
+        const float* color = sideColor(impact.side);
+        particles.spawn(impact.x, impact.y, impact.x, impact.y, 0.1f, impact.radius, 0.35f,
+            color[0], color[1], color[2], ParticleSystem::RING);
     }
+
+    splash_impacts.clear();
 }
 
-// Διαχείριση hover menu (εμφάνιση όταν γίνεται hover σε οντότητα)
-void GlobalState::handleHoverMenu(float canvas_x, float canvas_y) {
-    for (auto& entity : entities) {
-        if (entity->contains(canvas_x, canvas_y)) {
-            if (entity->getSide() == Side::PLAYER) {
-                if (entity->getType() == "Baby") {
-                    hover_menu.show(entity->getX(), entity->getY() + 1.0f,
-                        entity.get(), true, 0);  // Menu για Baby
-                }
-                else {
-                    hover_menu.show(entity->getX(), entity->getY() + 1.3f,
-                        entity.get(), false, entity->getUpgradeCost());  // Menu για άλλες οντότητες
+// Σειρά ταξινόμησης του ευρετηρίου troops: (πηγή, στόχος, πρόοδος)
+template <typename T>
+static bool edgeTroopLess(const T& l, const T& r) {
+    if (l.from != r.from) return l.from < r.from;
+    if (l.to != r.to) return l.to < r.to;
+    return l.progress < r.progress;
+}
+
+// Ταξινόμηση των ζωντανών troops ανά (ακμή, πρόοδος)
+// Η calculatePaths αφήνει τα troops σε κίνηση στο μονοπάτι με το οποίο ξεκίνησαν, ενώ οι
+// πίνακες έκθεσης χτίζονται από τα τρέχοντα μονοπάτια του γράφου. Η πρόοδος ενός troop σε
+// άλλο μονοπάτι δεν αντιστοιχεί στα διαστήματα των πινάκων, οπότε αυτά τα troops μπαίνουν
+// στο stale_troop_hash αντί για το ευρετήριο
+void GlobalState::buildEdgeTroopIndex() {
+    edge_troops.clear();
+    stale_troops.clear();
+
+    for (Troop* troop : troops) {
+        if (troop->hasArrived() || troop->isDead()) continue;
+        if (troop->getPath() != entity_graph.getPath(troop->getSourceHandle(), troop->getTargetHandle())) {
+            stale_troops.push_back(troop);
+            continue;
+        }
+        edge_troops.push_back({ troop->getSourceHandle(), troop->getTargetHandle(), troop->getProgress(), troop });
+    }
+
+    std::sort(edge_troops.begin(), edge_troops.end(), edgeTroopLess<EdgeTroop>);
+    if (!stale_troops.empty()) stale_troop_hash.build(stale_troops);
+}
+
+// Συλλογή troops που βρίσκονται μέσα σε κάποιο διάστημα έκθεσης του πύργου
+// (δυαδική αναζήτηση στην ακμή και σειριακή ανάγνωση μέχρι το τέλος του διαστήματος)
+void GlobalState::gatherExposedTroops(const TowerExposure& table) {
+    for (const EdgeExposure& edge : table.edges) {
+        EdgeTroop key = { edge.from, edge.to, edge.enter, nullptr };
+        auto it = std::lower_bound(edge_troops.begin(), edge_troops.end(), key, edgeTroopLess<EdgeTroop>);
+
+        for (; it != edge_troops.end(); ++it) {
+            if (it->from != edge.from || it->to != edge.to || it->progress > edge.exit) break;
+            tower_candidates.push_back(it->troop);
+        }
+    }
+}
+
+// Μετατροπή Baby σε Warrior/Tower/Wizard με κόστος cost hp
+// Το νέο entity παίρνει τη θέση του Baby στο EntityStore (αλλάζουν μόνο τα components)
+void GlobalState::transformBaby(Entity* target, EntityKind kind, int cost) {
+    int hp = target->getHealth() - cost;
+
+    for (size_t i = 0; i < entities.size(); i++) {
+        if (entities[i].get() == target) {
+            // Αντικατάσταση του Baby στην ίδια θέση
+            switch (kind) {
+            case EntityKind::WARRIOR:
+                entities[i] = std::make_unique<Warrior>(*target, hp);
+                break;
+            case EntityKind::TOWER:
+                entities[i] = std::make_unique<Tower>(*target, hp);
+                break;
+            case EntityKind::WIZARD:
+                entities[i] = std::make_unique<Wizard>(*target, hp);
+                break;
+            default:
+                return;
+            }
+            Entity* new_entity = entities[i].get();
+
+            // Οι παλιές συνδέσεις ισχύουν ήδη: το νέο entity κρατά το handle του Baby
+
+            // Σύνδεση με όλες τις άλλες οντότητες
+            for (size_t j = 0; j < entities.size(); j++) {
+                if (j != i && entities[j].get() != new_entity) {
+                    entity_graph.addEdge(new_entity, entities[j].get());
                 }
             }
+
+            hover_menu.hide();
             break;
         }
     }
+}
+
+// Διαχείριση hover menu (εμφάνιση όταν γίνεται hover σε οντότητα)
+void GlobalState::handleHoverMenu(float canvas_x, float canvas_y) {
+    Entity* entity = EntityStore::getInstance()->pick(canvas_x, canvas_y);
+    if (entity && entity->getSide() == Side::PLAYER) {
+        if (entity->getKind() == EntityKind::BABY) {
+            hover_menu.show(entity->getX(), entity->getY() + 1.0f,
+                entity, true, 0);  // Menu για Baby
+        }
+        else {
+            hover_menu.show(entity->getX(), entity->getY() + 1.3f,
+                entity, false, entity->getUpgradeCost());  // Menu για άλλες οντότητες
+        }
+    }
 
     // Απόκρυψη menu αν ο χρήστης κλικάρει έξω από αυτό
     if (hover_menu.isVisible()) {
         int hovered = hover_menu.checkClick(canvas_x, canvas_y);
-        if (hovered == -1) {
-            bool over_entity = false;
-            for (auto& entity : entities) {
-                if (entity->contains(canvas_x, canvas_y)) {
-                    over_entity = true;
-                    break;
-                }
-            }
-            if (!over_entity) hover_menu.hide();
+        if (hovered == -1 && !entity) {
+            hover_menu.hide();
         }
     }
 }
@@ -344,11 +820,12 @@ void GlobalState::handleHoverMenu(float canvas_x, float canvas_y) {
 // Επεξεργασία κλικ σε menu (αναβάθμιση, μετατροπή, spells)
 void GlobalState::handleMenuClick(float canvas_x, float canvas_y, int clicked_option) {
     Entity* target = hover_menu.getTarget();
+    if (!target) { hover_menu.hide(); return; }  // Ο στόχος καταστράφηκε ενώ το μενού ήταν ανοιχτό
     bool is_baby = hover_menu.getIsBaby();
 
     // Wizard spell buttons (IDs 10, 11, 12)
     if (clicked_option >= 10 && clicked_option <= 12) {
-        if (target->getType() == "Wizard") {
+        if (target->getKind() == EntityKind::WIZARD) {
             Wizard* wizard = static_cast<Wizard*>(target);
             int spell_id = clicked_option - 10; // 10->0, 11->1, 12->2
 
@@ -356,7 +833,7 @@ void GlobalState::handleMenuClick(float canvas_x, float canvas_y, int clicked_op
                 // Έλεγχος αν αυτό το spell είναι ήδη ready
                 bool already_ready = false;
                 for (auto& spell : ready_spells) {
-                    if (spell.wizard == wizard && spell.spell_id == spell_id) {
+                    if (spell.wizard == wizard->getHandle() && spell.spell_id == spell_id) {
                         already_ready = true;
                         break;
                     }
@@ -365,10 +842,12 @@ void GlobalState::handleMenuClick(float canvas_x, float canvas_y, int clicked_op
                 if (!already_ready) {
                     // Έναρξη προετοιμασίας spell - ΑΛΛΑΓΗ: ΔΕΝ ΠΛΗΡΩΝΟΥΜΕ HP ΕΔΩ
                     ReadySpell new_spell;
-                    new_spell.wizard = wizard;
+                    new_spell.wizard = wizard->getHandle();
                     new_spell.spell_id = spell_id;
                     new_spell.is_ready = false;
-                    new_spell.prep_time = 0.0f; // Αρχή από 0
+                    EntityHandle handle = wizard->getHandle();
+                    new_spell.prep_timer = TimerWheel::getInstance()->schedule(SPELL_PREP_TIME,
+                        [this, handle, spell_id]() { markSpellReady(handle, spell_id); });
                     ready_spells.push_back(new_spell);
 
                     // ΑΦΑΙΡΕΙΣΗ: ΔΕΝ ΑΦΑΙΡΟΥΜΕ HP ΕΔΩ
@@ -390,105 +869,26 @@ void GlobalState::handleMenuClick(float canvas_x, float canvas_y, int clicked_op
     if (is_baby) {
         if (clicked_option == 0 && target->getHealth() >= 5) {
             // ΜΕΤΑΤΡΟΠΗ ΣΕ WARRIOR (5 HP)
-            int hp = target->getHealth() - 5;
-            float px = target->getX(), py = target->getY();
-            Side side = target->getSide();
-
-            for (size_t i = 0; i < entities.size(); i++) {
-                if (entities[i].get() == target) {
-                    // Αποθήκευση παλιών συνδέσεων
-                    std::vector<Entity*> old_connections;
-                    for (auto& conn : entity_graph.getConnections(target)) {
-                        old_connections.push_back(conn);
-                    }
-
-                    // Αντικατάσταση Baby με Warrior
-                    entities[i] = std::make_unique<Warrior>(px, py, hp, side);
-                    Entity* new_entity = entities[i].get();
-
-                    // Επανασύνδεση με παλιούς γείτονες
-                    for (Entity* connected_entity : old_connections) {
-                        entity_graph.addEdge(new_entity, connected_entity);
-                    }
-
-                    // Σύνδεση με όλες τις άλλες οντότητες
-                    for (size_t j = 0; j < entities.size(); j++) {
-                        if (j != i && entities[j].get() != new_entity) {
-                            entity_graph.addEdge(new_entity, entities[j].get());
-                        }
-                    }
-
-                    hover_menu.hide();
-                    break;
-                }
-            }
+            transformBaby(target, EntityKind::WARRIOR, 5);
         }
         else if (clicked_option == 1 && target->getHealth() >= 10) {
             // ΜΕΤΑΤΡΟΠΗ ΣΕ TOWER (10 HP)
-            int hp = target->getHealth() - 10;
-            float px = target->getX(), py = target->getY();
-            Side side = target->getSide();
-
-            for (size_t i = 0; i < entities.size(); i++) {
-                if (entities[i].get() == target) {
-                    std::vector<Entity*> old_connections;
-                    for (auto& conn : entity_graph.getConnections(target)) {
-                        old_connections.push_back(conn);
-                    }
-
-                    entities[i] = std::make_unique<Tower>(px, py, hp, side);
-                    Entity* new_entity = entities[i].get();
-
-                    for (Entity* connected_entity : old_connections) {
-                        entity_graph.addEdge(new_entity, connected_entity);
-                    }
-
-                    for (size_t j = 0; j < entities.size(); j++) {
-                        if (j != i && entities[j].get() != new_entity) {
-                            entity_graph.addEdge(new_entity, entities[j].get());
-                        }
-                    }
-
-                    hover_menu.hide();
-                    break;
-                }
-            }
+            transformBaby(target, EntityKind::TOWER, 10);
         }
         else if (clicked_option == 2 && target->getHealth() >= 10) {
             // ΜΕΤΑΤΡΟΠΗ ΣΕ WIZARD (10 HP)
-            int hp = target->getHealth() - 10;
-            float px = target->getX(), py = target->getY();
-            Side side = target->getSide();
-
-            for (size_t i = 0; i < entities.size(); i++) {
-                if (entities[i].get() == target) {
-                    std::vector<Entity*> old_connections;
-                    for (auto& conn : entity_graph.getConnections(target)) {
-                        old_connections.push_back(conn);
-                    }
-
-                    entities[i] = std::make_unique<Wizard>(px, py, hp, side);
-                    Entity* new_entity = entities[i].get();
-
-                    for (Entity* connected_entity : old_connections) {
-                        entity_graph.addEdge(new_entity, connected_entity);
-                    }
-
-                    for (size_t j = 0; j < entities.size(); j++) {
-                        if (j != i && entities[j].get() != new_entity) {
-                            entity_graph.addEdge(new_entity, entities[j].get());
-                        }
-                    }
-
-                    hover_menu.hide();
-                    break;
-                }
-            }
+            transformBaby(target, EntityKind::WIZARD, 10);
         }
     }
     else {
+        // ΚΛΑΔΟΣ SPLASH ΓΙΑ TOWER (κουμπί 1)
+        if (clicked_option == 1 && target->getKind() == EntityKind::TOWER) {
+            Tower* tower = static_cast<Tower*>(target);
+            tower->convertToSplash();
+            hover_menu.hide();
+        }
         // ΑΝΑΒΑΘΜΙΣΗ ΟΝΤΟΤΗΤΩΝ (Warrior, Tower, Wizard)
-        if (target->canUpgrade()) {
+        else if (target->canUpgrade()) {
             target->performUpgrade();  // Εκτέλεση αναβάθμισης
             hover_menu.hide();
         }
@@ -503,60 +903,65 @@ void GlobalState::handleMenuClick(float canvas_x, float canvas_y, int clicked_op
 
 // Επεξεργασία ρίψης spell (όταν επιλέγεται στόχος)
 void GlobalState::handleWizardSpellCast(float canvas_x, float canvas_y) {
-    if (!target_selection_wizard || target_selection_spell_id < 0) return;
+    if (target_selection_wizard.isNull() || target_selection_spell_id < 0) return;
+
+    // Ο wizard μπορεί να μην υπάρχει πια - ακύρωση επιλογής
+    Wizard* caster = resolveWizard(target_selection_wizard);
+    if (!caster) {
+        target_selection_wizard = EntityHandle();
+        target_selection_spell_id = -1;
+        return;
+    }
 
     // Εύρεση οντότητας που κλικάρθηκε
     for (auto& entity : entities) {
         if (entity->contains(canvas_x, canvas_y)) {
             // Έλεγχος αν ο στόχος είναι ο ίδιος με τον wizard
-            if (entity.get() == target_selection_wizard) {
+            if (entity.get() == caster) {
                 // Δεν επιτρέπεται να ρίξεις spell στον εαυτό σου
                 // Το spell επιστρέφει στη ready λίστα
                 ReadySpell spell;
                 spell.wizard = target_selection_wizard;
                 spell.spell_id = target_selection_spell_id;
-                spell.is_ready = true;
-                spell.prep_time = 2.0f;  // Ολοκληρωμένη προετοιμασία
+                spell.is_ready = true;  // Ολοκληρωμένη προετοιμασία
                 ready_spells.push_back(spell);
 
-                target_selection_wizard = nullptr;
+                target_selection_wizard = EntityHandle();
                 target_selection_spell_id = -1;
                 return;
             }
 
             // ΠΛΗΡΩΜΑ HP ΟΤΑΝ ΧΡΗΣΙΜΟΠΟΙΕΙΣ ΤΟ SPELL (όχι όταν ξεκινά)
             // Έλεγχος αν ο wizard έχει αρκετά HP για το spell
-            int spell_cost = target_selection_wizard->getSpellCost(target_selection_spell_id);
-            if (target_selection_wizard->getHealth() < spell_cost) {
+            int spell_cost = caster->getSpellCost(target_selection_spell_id);
+            if (caster->getHealth() < spell_cost) {
                 // Δεν έχει αρκετά HP, επιστροφή spell
                 ReadySpell spell;
                 spell.wizard = target_selection_wizard;
                 spell.spell_id = target_selection_spell_id;
                 spell.is_ready = true;
-                spell.prep_time = 2.0f;
                 ready_spells.push_back(spell);
 
-                target_selection_wizard = nullptr;
+                target_selection_wizard = EntityHandle();
                 target_selection_spell_id = -1;
                 return;
             }
 
             // ΠΛΗΡΩΝΕΙ ΤΟ HP ΤΩΡΑ
-            target_selection_wizard->setHealth(target_selection_wizard->getHealth() - spell_cost);
+            caster->setHealth(caster->getHealth() - spell_cost);
 
             // Ρίψη spell σε αυτή την οντότητα
             Entity* target = entity.get();
 
+            spawnSpellEffect(caster, target, target_selection_spell_id);
+
             // Εφαρμογή effect spell ανάλογα με το spell_id
             switch (target_selection_spell_id) {
-            case 0: // Freeze - μόνιμα NEUTRAL
-                target->setSide(Side::NEUTRAL);
+            case 0: // Freeze - προσωρινά NEUTRAL
+                StatusEffects::getInstance()->apply(target, StatusEffects::FREEZE);
                 break;
-            case 1: // Sickness - max_health = 0
-                if (!target->isSick()) {
-                    target->setSick(true);
-                    target->setMaxHealth(0);
-                }
+            case 1: // Sickness - max_health = 0 για όσο διαρκεί
+                StatusEffects::getInstance()->apply(target, StatusEffects::SICKNESS);
                 break;
             case 2: // Convert - μόνιμα PLAYER
                 target->setSide(Side::PLAYER);
@@ -564,7 +969,7 @@ void GlobalState::handleWizardSpellCast(float canvas_x, float canvas_y) {
             }
 
             // Επαναφορά επιλογής - το spell χρησιμοποιήθηκε
-            target_selection_wizard = nullptr;
+            target_selection_wizard = EntityHandle();
             target_selection_spell_id = -1;
             return;
         }
@@ -575,11 +980,10 @@ void GlobalState::handleWizardSpellCast(float canvas_x, float canvas_y) {
     ReadySpell spell;
     spell.wizard = target_selection_wizard;
     spell.spell_id = target_selection_spell_id;
-    spell.is_ready = true;
-    spell.prep_time = 2.0f;  // Ολοκληρωμένη προετοιμασία
+    spell.is_ready = true;  // Ολοκληρωμένη προετοιμασία
     ready_spells.push_back(spell);
 
-    target_selection_wizard = nullptr;
+    target_selection_wizard = EntityHandle();
     target_selection_spell_id = -1;
 }
 
@@ -589,11 +993,12 @@ void GlobalState::drawReadySpells() {
     total_time += 0.016f;  // Προσεγγιστικός χρόνος frame για animation
 
     for (const auto& spell : ready_spells) {
-        if (!spell.wizard) continue;
+        const Wizard* wizard = resolveWizard(spell.wizard);
+        if (!wizard) continue;
 
-        float wizard_x = spell.wizard->getX();
-        float wizard_y = spell.wizard->getY();
-        float wizard_size = spell.wizard->getSize();
+        float wizard_x = wizard->getX();
+        float wizard_y = wizard->getY();
+        float wizard_size = wizard->getSize();
 
         // Θέση δείκτη ΚΑΤΩ από τον wizard
         float indicator_y = wizard_y + wizard_size + 0.5f;
@@ -638,7 +1043,7 @@ void GlobalState::drawReadySpells() {
             graphics::drawRect(indicator_x, indicator_y, bar_width, bar_height, br_bg);
 
             // Progress fill
-            float progress = spell.prep_time / 2.0f;  // 2 δευτερόλεπτα συνολικά
+            float progress = 1.0f - TimerWheel::getInstance()->remaining(spell.prep_timer) / SPELL_PREP_TIME;
             float progress_width = bar_width * progress;
             float progress_x = indicator_x - bar_width / 2 + progress_width / 2;
 
@@ -698,7 +1103,7 @@ void GlobalState::drawReadySpells() {
     }
 
     // Σχεδίαση δείκτη επιλογής στόχου αν είναι ενεργός
-    if (target_selection_wizard) {
+    if (const Wizard* caster = resolveWizard(target_selection_wizard)) {
         graphics::Brush br_selection;
         br_selection.fill_color[0] = 1.0f;
         br_selection.fill_color[1] = 1.0f;
@@ -707,8 +1112,8 @@ void GlobalState::drawReadySpells() {
         br_selection.outline_opacity = 1.0f;
         br_selection.outline_width = 4.0f;
 
-        graphics::drawDisk(target_selection_wizard->getX(), target_selection_wizard->getY(),
-            target_selection_wizard->getSize() + 0.25f, br_selection);
+        graphics::drawDisk(caster->getX(), caster->getY(),
+            caster->getSize() + 0.25f, br_selection);
 
         // Κείμενο "SELECT TARGET" κάτω από τον wizard
         graphics::Brush br_text;
@@ -716,9 +1121,9 @@ void GlobalState::drawReadySpells() {
         br_text.fill_color[1] = 1.0f;
         br_text.fill_color[2] = 0.0f;
 
-        float wizard_x = target_selection_wizard->getX();
-        float wizard_y = target_selection_wizard->getY();
-        float wizard_size = target_selection_wizard->getSize();
+        float wizard_x = caster->getX();
+        float wizard_y = caster->getY();
+        float wizard_size = caster->getSize();
 
         std::string spell_name;
         if (target_selection_spell_id == 0) spell_name = "FREEZE";
@@ -732,59 +1137,44 @@ void GlobalState::drawReadySpells() {
 
 // Επεξεργασία κλικ σε οντότητα (για αποστολή troops)
 void GlobalState::handleEntityClick(float canvas_x, float canvas_y) {
-    bool clicked_entity = false;
+    Entity* entity = EntityStore::getInstance()->pick(canvas_x, canvas_y);
 
-    for (auto& entity : entities) {
-        if (entity->contains(canvas_x, canvas_y)) {
-            clicked_entity = true;
-
-            if (selected_entity && selected_entity != entity.get()) {
-                // Αποστολή troops από επιλεγμένη οντότητα σε αυτή που κλικάρθηκε
-                if (selected_entity->getSide() == Side::PLAYER) {
-                    int amount = selected_entity->getHealth() / 2;  // 50% της ζωής
-                    if (amount > 0) {
-                        const PathData* path = entity_graph.getPath(selected_entity, entity.get());
-                        if (path && !path->waypoints.empty()) {
-                            troops.push_back(std::make_unique<Troop>(
-                                selected_entity, entity.get(), amount, path->waypoints
-                            ));
-                            selected_entity->setHealth(selected_entity->getHealth() - amount);
-                        }
-                    }
-                }
-                selected_entity = nullptr;
-            }
-            else {
-                // Επιλογή ή αποεπιλογή οντότητας
-                if (entity->getSide() == Side::PLAYER) {
-                    selected_entity = entity.get();
-                }
-                else {
-                    selected_entity = nullptr;
-                }
-            }
-            break;
-        }
+    if (!entity) {
+        selected_entity = EntityHandle();  // Αποεπιλογή αν κλικάρεται άδειος χώρος
+        return;
     }
 
-    if (!clicked_entity) {
-        selected_entity = nullptr;  // Αποεπιλογή αν κλικάρεται άδειος χώρος
+    Entity* selected = resolve(selected_entity);
+    if (selected && selected != entity) {
+        // Αποστολή troops από επιλεγμένη οντότητα σε αυτή που κλικάρθηκε
+        // Σύντομο κλικ στέλνει το 50% της ζωής, κράτημα στέλνει συνεχή ροή
+        // (η απόφαση παίρνεται στην updateTroopStream)
+        if (selected->getSide() == Side::PLAYER) {
+            stream_source = selected_entity;
+            stream_target = entity->getHandle();
+            stream_hold_time = 0.0f;
+            stream_timer = 0.0f;
+            stream_active = false;
+        }
+        selected_entity = EntityHandle();
     }
-}
-
-// Υπολογισμός συνολικής ζωής παίκτη και εχθρού
-std::pair<int, int> GlobalState::calculateTotalHealth() const {
-    int player_total_health = 0;
-    int enemy_total_health = 0;
-
-    for (const auto& entity : entities) {
+    else {
+        // Επιλογή ή αποεπιλογή οντότητας
         if (entity->getSide() == Side::PLAYER) {
-            player_total_health += entity->getHealth();
+            selected_entity = entity->getHandle();
         }
-        else if (entity->getSide() == Side::ENEMY) {
-            enemy_total_health += entity->getHealth();
+        else {
+            selected_entity = EntityHandle();
         }
     }
+}
+
+// Υπολογισμός συνολικής ζωής παίκτη και εχθρού
+// (αθροίσματα του EntityStore που ενημερώνονται σε κάθε αλλαγή, χωρίς πέρασμα από τα entities)
+std::pair<int, int> GlobalState::calculateTotalHealth() const {
+    EntityStore* store = EntityStore::getInstance();
+    int player_total_health = static_cast<int>(std::lround(store->getTotalHealth(Side::PLAYER)));
+    int enemy_total_health = static_cast<int>(std::lround(store->getTotalHealth(Side::ENEMY)));
 
     return std::make_pair(player_total_health, enemy_total_health);
 }
@@ -874,15 +1264,16 @@ void GlobalState::drawHealthBars() {
 void GlobalState::handleMouseInput(float canvas_x, float canvas_y, bool mouse_pressed) {
     if (mouse_pressed) {
         // Έλεγχος αν είμαστε σε λειτουργία επιλογής στόχου για spell
-        if (target_selection_wizard && target_selection_spell_id >= 0) {
+        if (!target_selection_wizard.isNull() && target_selection_spell_id >= 0) {
             handleWizardSpellCast(canvas_x, canvas_y);
             return;
         }
 
         // Έλεγχος αν κλικάρεται wizard με έτοιμο spell
         for (auto& spell : ready_spells) {
-            if (spell.is_ready && spell.wizard) {
-                if (spell.wizard->contains(canvas_x, canvas_y)) {
+            const Wizard* wizard = resolveWizard(spell.wizard);
+            if (spell.is_ready && wizard) {
+                if (wizard->contains(canvas_x, canvas_y)) {
                     // Είσοδος σε λειτουργία επιλογής στόχου για αυτό το ready spell
                     target_selection_wizard = spell.wizard;
                     target_selection_spell_id = spell.spell_id;
@@ -891,7 +1282,7 @@ void GlobalState::handleMouseInput(float canvas_x, float canvas_y, bool mouse_pr
                     ready_spells.erase(
                         std::remove_if(ready_spells.begin(), ready_spells.end(),
                             [&](const ReadySpell& s) {
-                                return s.wizard == spell.wizard && s.spell_id == spell.spell_id;
+                                return s.wizard == target_selection_wizard && s.spell_id == target_selection_spell_id;
                             }),
                         ready_spells.end()
                     );
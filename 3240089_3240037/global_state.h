@@ -3,9 +3,16 @@
 #include "entity.h"
 #include "hover_menu.h"
 #include "troop.h"
+#include "troop_pool.h"
+#include "troop_ledger.h"
+#include "spatial_hash.h"
+#include "particle_system.h"
 #include "graph.h"
 #include "pause_menu.h"     
 #include "level_manager.h"   
+#include "ai_params.h"
+#include "opening_book.h"
+#include "ai_trace.h"
 #include <vector>
 #include <memory>
 
@@ -20,40 +27,129 @@ private:
 
 	// Δεδομένα παιχνιδιού
     std::vector<std::unique_ptr<Entity>> entities;  // Όλα τα entities
-    std::vector<std::unique_ptr<Troop>> troops;     // Όλα τα troops
-    std::vector<Tower::AttackEffect> attack_effects; // Οπτικά effects επιθέσεων πύργων
+    TroopPool troop_pool;                           // Μνήμη για τα troops (pool σταθερών blocks)
+    std::vector<Troop*> troops;                     // Όλα τα ενεργά troops (ζουν μέσα στο troop_pool)
+    TroopSpatialHash troop_hash;                    // Χωρικό hash των troops (για πύργους χωρίς πίνακα έκθεσης)
+    TroopLedger troop_ledger;                       // Troops που ταξιδεύουν προς κάθε entity (με χρόνο άφιξης)
+
+    // Ευρετήριο troops ανά κατευθυνόμενη ακμή, ταξινομημένο βάσει προόδου
+    struct EdgeTroop {
+        EntityHandle from;
+        EntityHandle to;
+        float progress;
+        Troop* troop;
+    };
+    std::vector<EdgeTroop> edge_troops;             // Ξαναχτίζεται κάθε tick
+    std::vector<Troop*> stale_troops;               // Troops σε μονοπάτι παλαιότερο από του γράφου (εκτός ευρετηρίου)
+    TroopSpatialHash stale_troop_hash;              // Χωρικό hash των stale_troops (για όλους τους πύργους)
+    std::vector<Troop*> tower_candidates;           // Υποψήφιοι στόχοι του τρέχοντος πύργου (buffer)
+
+    // Βολή splash πύργου που περιμένει να εφαρμοστεί (όλες μαζί σε ένα πέρασμα του hash)
+    struct SplashImpact {
+        float x, y;               // Σημείο πρόσκρουσης
+        float radius;             // Ακτίνα ζημιάς περιοχής
+        int damage;
+        Side side;                // Πλευρά του πύργου (τα troops της δεν χτυπιούνται)
+    };
+    std::vector<SplashImpact> splash_impacts;
+    ParticleSystem particles;                       // Οπτικά effects (βολές, μετατροπές, αφίξεις, spells)
 
 
     EntityGraph entity_graph;     // Γράφος συνδέσεων μεταξύ οντοτήτων
-    Entity* selected_entity;      // Τρέχουσα επιλεγμένη οντότητα (για αποστολή troops)
+    EntityHandle selected_entity; // Τρέχουσα επιλεγμένη οντότητα (για αποστολή troops)
     HoverMenu hover_menu;         // Menu που εμφανίζεται όταν γίνεται hover σε οντότητα
     AISystem* ai_system;          // Σύστημα τεχνητής νοημοσύνης για τον εχθρό
+    AISystem* autoplayer;         // AI για την πλευρά του παίκτη (μόνο σε αυτόματο παιχνίδι)
+    bool autoplay;                // Αγώνας AI εναντίον AI χωρίς είσοδο από το ποντίκι
+    double autoplay_match_start;  // Χρόνος του TimerWheel στην αρχή του αγώνα (για το όριο διάρκειας)
+    AIParams ai_params;           // Παράμετροι του AI του εχθρού (π.χ. από τον tuner)
+    bool custom_ai_params;        // Αν δόθηκαν παράμετροι (αλλιώς οι προεπιλογές του AISystem)
+    bool ai_search;               // Δυσκολία με αναζήτηση: οι αποστολές των AI επιλέγονται με search
+    OpeningBook opening_book;     // Ανοίγματα του AI ανά level (φορτώνεται μία φορά στην init)
+    AITrace ai_trace;             // Ίχνος αποφάσεων όλων των AI (ανενεργό μέχρι την enableAITrace)
+    float ai_trace_cooldown;      // ms μέχρι να επιτραπεί νέο dump λόγω αιχμής
+    bool ai_trace_key;            // Αν το πλήκτρο του dump ήταν πατημένο στο προηγούμενο frame
     PauseMenu pause_menu;         // Μενού παύσης του παιχνιδιού
     LevelManager level_manager;   // Διαχειριστής επιπέδων
 
     // Spells
     struct ReadySpell {
-        Wizard* wizard;           // Wizard που ετοιμάζει το spell
+        EntityHandle wizard;      // Wizard που ετοιμάζει το spell
         int spell_id;             // ID του spell (0=Freeze, 1=Sickness, 2=Convert)
         bool is_ready;            // Αν το spell είναι έτοιμο για χρήση
-        float prep_time;          // Χρόνος προετοιμασίας (0-2 δευτερόλεπτα)
+        TimerHandle prep_timer;   // Χρονόμετρο προετοιμασίας (pending για SPELL_PREP_TIME δευτερόλεπτα)
+    };
+
+    // Εγγραφή troop για το broadphase της μάχης troop-με-troop
+    struct CombatEntry {
+        EntityHandle edge_a;      // Άκρα της ακμής σε σταθερή σειρά (ίδια και για τις δύο κατευθύνσεις)
+        EntityHandle edge_b;
+        float s;                  // Απόσταση κατά μήκος της ακμής μετρημένη από το edge_a
+        Troop* troop;             // Το troop της εγγραφής
+    };
+
+    static const float TROOP_CONTACT_DISTANCE;  // Απόσταση επαφής δύο troops (2 x ακτίνα)
+    static const float SPELL_PREP_TIME;         // Χρόνος προετοιμασίας spell του παίκτη
+
+    std::vector<CombatEntry> combat_entries;    // Buffer για ταξινόμηση ανά ακμή (επαναχρησιμοποιείται)
+    std::vector<Troop*> combat_sweep;           // Buffer για sweep-and-prune στον άξονα x
+
+    // Αίτημα δημιουργίας troop (όλα τα αιτήματα ενός frame δημιουργούνται μαζί)
+    struct TroopSpawn {
+        EntityHandle source;                   // Οντότητα πηγής
+        EntityHandle target;                   // Οντότητα στόχος
+        int amount;                            // HP που μεταφέρει το troop
+        std::shared_ptr<const PathData> path;  // Μονοπάτι από τον γράφο
     };
+    std::vector<TroopSpawn> pending_spawns;    // Αιτήματα που περιμένουν το flush του frame
+
+    // Συνεχής αποστολή troops (hold-to-stream)
+    static const float STREAM_HOLD_DELAY;      // Χρόνος κρατήματος πριν ξεκινήσει η ροή
+    static const float STREAM_INTERVAL;        // Χρόνος μεταξύ δύο troops της ροής
+    static const int STREAM_TROOP_SIZE;        // HP κάθε troop της ροής
+
+    static const float AI_SEARCH_BUDGET_PER_LEVEL;  // ms αναζήτησης του AI ανά απόφαση, ανά level
+    static const float AUTOPLAY_MAX_SECONDS;        // Μέγιστη διάρκεια αγώνα σε αυτόματο παιχνίδι (ισοπαλία)
+    static const float AI_TRACE_SPIKE_US;           // Δουλειά του AI σε ένα tick που θεωρείται αιχμή (dump του ίχνους)
+    static const float AI_TRACE_SPIKE_COOLDOWN_MS;  // Ελάχιστο διάστημα ανάμεσα σε dumps λόγω αιχμής
+
+    EntityHandle stream_source;   // Πηγή της τρέχουσας αποστολής (null handle αν δεν υπάρχει)
+    EntityHandle stream_target;   // Στόχος της τρέχουσας αποστολής
+    float stream_hold_time;       // Πόσο καιρό είναι πατημένο το κουμπί
+    float stream_timer;           // Συσσωρευμένος χρόνος για το επόμενο troop της ροής
+    bool stream_active;           // Αν η ροή έχει ξεκινήσει (αλλιώς είναι απλό κλικ)
 
     std::vector<ReadySpell> ready_spells;  // Λίστα spells που προετοιμάζονται ή είναι έτοιμα
-    Wizard* target_selection_wizard;       // Wizard που έχει επιλέξει spell και περιμένει στόχο
+    EntityHandle target_selection_wizard;  // Wizard που έχει επιλέξει spell και περιμένει στόχο
     int target_selection_spell_id;         // ID του spell που έχει επιλεγεί για ρίψη
 
+    // Επίλυση handles (nullptr αν το entity δεν υπάρχει πια ή δεν είναι Wizard)
+    Entity* resolve(EntityHandle handle) const { return EntityStore::getInstance()->resolve(handle); }
+    Wizard* resolveWizard(EntityHandle handle) const;
+
     void handleTroopArrivals();                       // Επεξεργασία troops που έφτασαν στον στόχο
+    void handleTroopCombat();                         // Μάχη αντίπαλων troops στη διαδρομή
+    void updateTroopStream(float dt, bool mouse_down);  // Ενημέρωση συνεχούς αποστολής troops
+    void flushTroopSpawns();                          // Δημιουργία όλων των troops του frame μαζί
+    void releaseAllTroops();                          // Επιστροφή όλων των troops στο pool
     void handleMouseInput(float canvas_x, float canvas_y, bool mouse_pressed);  // Επεξεργασία κλικ ποντικιού
     void handleHoverMenu(float canvas_x, float canvas_y);  // Διαχείριση hover menu
     void handleEntityClick(float canvas_x, float canvas_y); // Επεξεργασία κλικ σε οντότητα
     void handleMenuClick(float canvas_x, float canvas_y, int clicked_option);  // Επεξεργασία κλικ σε menu
+    void transformBaby(Entity* target, EntityKind kind, int cost);  // Μετατροπή Baby στην ίδια θέση
     void handleTowerAttacks();                       // Επεξεργασία επιθέσεων πύργων
-    void updateAttackEffects(float dt);               // Ενημέρωση οπτικών effects
-    void drawAttackEffects();                         // Σχεδίαση οπτικών effects
+    void buildEdgeTroopIndex();                      // Ταξινόμηση troops ανά ακμή και πρόοδο (και stale_troops)
+    void gatherExposedTroops(const TowerExposure& table);  // Troops μέσα στα διαστήματα έκθεσης ενός πύργου
+    void resolveSplashImpacts(bool hash_built);      // Ζημιά περιοχής για όλες τις βολές splash του tick
+    void spawnCaptureEffect(const Entity* target);    // Effect μετατροπής οντότητας
     void handleWizardSpellCast(float canvas_x, float canvas_y);  // Επεξεργασία ρίψης spell
     void drawReadySpells();                           // Σχεδίαση spells που είναι έτοιμα
-    void updateReadySpells(float dt);                 // Ενημέρωση προετοιμασίας spells
+    void updateReadySpells();                         // Αφαίρεση spells χωρίς έγκυρο wizard
+    void markSpellReady(EntityHandle wizard, int spell_id);  // Λήξη προετοιμασίας (από το TimerWheel)
+    void checkAutoplayMatch();                        // Επόμενο level όταν μια πλευρά χάσει ή λήξει ο χρόνος
+    void setAIOpening(AISystem* ai, int level);       // Άνοιγμα από το βιβλίο για την πλευρά του AI
+    void updateAITrace(float dt);                     // Dump του ίχνους με το F9
+    void checkAITraceSpike();                         // Dump του ίχνους σε αιχμή της δουλειάς των AI
 
 public:
     GlobalState();  // Constructor
@@ -73,9 +169,10 @@ public:
 
     // Getters
     std::vector<std::unique_ptr<Entity>>& getEntities() { return entities; }
-    std::vector<std::unique_ptr<Troop>>& getTroops() { return troops; }
+    const std::vector<Troop*>& getTroops() const { return troops; }
+    const TroopLedger& getTroopLedger() const { return troop_ledger; }
     EntityGraph& getGraph() { return entity_graph; }
-    Entity* getSelectedEntity() const { return selected_entity; }
+    Entity* getSelectedEntity() const { return resolve(selected_entity); }
     HoverMenu& getHoverMenu() { return hover_menu; }
     PauseMenu& getPauseMenu() { return pause_menu; }
     LevelManager& getLevelManager() { return level_manager; }
@@ -85,7 +182,34 @@ public:
     void drawHealthBars();                             // Σχεδίαση health bars
 
     // Setters
-    void setSelectedEntity(Entity* entity) { selected_entity = entity; }
+    void setSelectedEntity(Entity* entity) { selected_entity = entity ? entity->getHandle() : EntityHandle(); }
+
+    // Αυτόματο παιχνίδι: δεύτερο AI παίζει για τον παίκτη και τα levels εναλλάσσονται μόνα τους
+    // (για benchmarks και soak tests). Ισχύει από το επόμενο initLevel
+    void setAutoplay(bool enabled) { autoplay = enabled; }
+    bool isAutoplay() const { return autoplay; }
+
+    // Παράμετροι για το AI του εχθρού από το επόμενο initLevel (το autoplayer κρατά τις
+    // προεπιλογές, οπότε το αυτόματο παιχνίδι συγκρίνει ρυθμισμένες και αρχικές τιμές)
+    // Το AI με παραμέτρους δεν χρησιμοποιεί αναζήτηση, ακόμα και με setAISearch
+    void setAIParams(const AIParams& params) { ai_params = params; custom_ai_params = true; }
+
+    // Δυσκολία με αναζήτηση (AI_SEARCH_BUDGET_PER_LEVEL ms ανά level), από το επόμενο initLevel
+    // Χωρίς αυτή (προεπιλογή) τα AI στέλνουν με τον utility πίνακα, την policy και το route cache
+    void setAISearch(bool enabled) { ai_search = enabled; }
+
+    // Ίχνος αποφάσεων των AI (capacity εγγραφές των 32 bytes - 0: απενεργοποίηση), από το
+    // επόμενο initLevel. Γράφεται σε αρχείο με το F9 (ai_trace.bin) ή μόνο του όταν η δουλειά
+    // ενός AI σε ένα tick ξεπεράσει το AI_TRACE_SPIKE_US (ai_trace_spike.bin)
+    void enableAITrace(unsigned int capacity = AITrace::DEFAULT_CAPACITY) { ai_trace.enable(capacity); }
+    bool dumpAITrace(const std::string& path);
+
+    // Αποστολή troop από μία οντότητα σε άλλη (αφαιρεί το hp από την πηγή αμέσως,
+    // το troop δημιουργείται στο τέλος του frame). Επιστρέφει false αν δεν υπάρχει μονοπάτι
+    bool spawnTroop(Entity* from, Entity* to, int amount);
+
+    // Οπτικό effect ρίψης spell από τον caster στον στόχο (για παίκτη και AI)
+    void spawnSpellEffect(const Entity* caster, const Entity* target, int spell_id);
 
     // Destructor
     ~GlobalState();
@@ -6,17 +6,32 @@
 //Προσθήκη αμφίδρομης σύνδεσης
 void EntityGraph::addEdge(Entity* from, Entity* to) {
     if (!from || !to || from == to) return;
-    connections[from].push_back(to);
-    connections[to].push_back(from);
+
+    EntityHandle a = from->getHandle();
+    EntityHandle b = to->getHandle();
+    std::vector<EntityHandle>& from_list = connections[a];
+    if (std::find(from_list.begin(), from_list.end(), b) != from_list.end()) return;
+
+    from_list.push_back(b);
+    connections[b].push_back(a);
 }
 
 //Υπολογισμός μονοπατιών για όλες τις συνδέσεις
 void EntityGraph::calculatePaths(const std::vector<std::unique_ptr<Entity>>& entities) {
     paths.clear();
+    exposure_dirty = true; //Νέα μονοπάτια - οι πίνακες έκθεσης δεν ισχύουν πια
+    path_version++; //Και οι χρόνοι διαδρομής που κρατούν άλλοι (π.χ. το AI)
+
+    EntityStore* store = EntityStore::getInstance();
 
     for (const auto& pair : connections) {
-        Entity* from = pair.first;
-        for (Entity* to : pair.second) {
+        Entity* from = store->resolve(pair.first);
+        if (!from) continue; //Το entity δεν υπάρχει πια
+
+        for (EntityHandle to_handle : pair.second) {
+            Entity* to = store->resolve(to_handle);
+            if (!to) continue;
+
             PathData path_forward;
 
             //Αρχικό σημείο
@@ -80,16 +95,102 @@ void EntityGraph::calculatePaths(const std::vector<std::unique_ptr<Entity>>& ent
                 }
             }
 
-			//Αποθήκευση μονοπατιού
-            paths[{from, to}] = path_forward;
+            //Υπολογισμός μήκους μονοπατιού
+            for (size_t i = 1; i < path_forward.waypoints.size(); i++) {
+                float lx = path_forward.waypoints[i].first - path_forward.waypoints[i - 1].first;
+                float ly = path_forward.waypoints[i].second - path_forward.waypoints[i - 1].second;
+                path_forward.length += std::sqrt(lx * lx + ly * ly);
+            }
+
+			//Αποθήκευση μονοπατιού (τα troops που ήδη ταξιδεύουν κρατούν το παλιό)
+            paths[{pair.first, to_handle}] = std::make_shared<const PathData>(std::move(path_forward));
         }
     }
 }
 
 //Getter που επιστρεφει το μονοπατι μεταξύ 2 entities
 const PathData* EntityGraph::getPath(Entity* from, Entity* to) const {
+    if (!from || !to) return nullptr;
+    return getPath(from->getHandle(), to->getHandle());
+}
+
+const PathData* EntityGraph::getPath(EntityHandle from, EntityHandle to) const {
     auto it = paths.find({ from, to });
-    return (it != paths.end()) ? &it->second : nullptr;
+    return (it != paths.end()) ? it->second.get() : nullptr;
+}
+
+//Getter για τον πίνακα έκθεσης ενός πύργου
+const TowerExposure* EntityGraph::getTowerExposure(const Entity* tower) const {
+    auto it = exposure.find(tower->getHandle());
+    return (it != exposure.end()) ? &it->second : nullptr;
+}
+
+//Υπολογισμός πινάκων έκθεσης
+//Για κάθε πύργο και κάθε μονοπάτι δειγματοληπτείται η διαδρομή και κρατιούνται τα
+//διαστήματα προόδου που βρίσκονται μέσα στην ακτίνα. Στο παιχνίδι αρκεί μετά να
+//βρεθούν τα troops της ακμής με πρόοδο μέσα στο διάστημα (χωρίς γεωμετρική αναζήτηση)
+void EntityGraph::buildExposure(const std::vector<std::unique_ptr<Entity>>& entities) {
+    exposure.clear();
+
+    const int SUBSTEPS = 4; //Δείγματα ανά τμήμα μονοπατιού
+    const float PAD = 0.5f / SUBSTEPS; //Περιθώριο ασφαλείας (μισό δείγμα σε κάθε άκρο)
+
+    for (const auto& entity : entities) {
+        if (entity->getKind() != EntityKind::TOWER) continue;
+        const Tower* tower = static_cast<const Tower*>(entity.get());
+
+        TowerExposure& table = exposure[tower->getHandle()];
+        table.level = tower->getLevel();
+        table.radius = tower->getAttackRadius();
+        //Λίγο μεγαλύτερη ακτίνα ώστε η καμπύλη Catmull-Rom να μη βγαίνει εκτός πίνακα
+        const float r = table.radius + 0.1f;
+        const float r_sq = r * r;
+
+        for (const auto& entry : paths) {
+            const auto& waypoints = entry.second->waypoints;
+            if (waypoints.empty()) continue;
+
+            bool inside = false;
+            float enter = 0.0f;
+            const int samples = (int)(waypoints.size() - 1) * SUBSTEPS;
+
+            for (int k = 0; k <= samples; k++) {
+                int segment = std::min(k / SUBSTEPS, (int)waypoints.size() - 1);
+                int next = std::min(segment + 1, (int)waypoints.size() - 1);
+                float local_t = (k - segment * SUBSTEPS) / (float)SUBSTEPS;
+
+                float px = waypoints[segment].first + (waypoints[next].first - waypoints[segment].first) * local_t;
+                float py = waypoints[segment].second + (waypoints[next].second - waypoints[segment].second) * local_t;
+                float dx = px - tower->getX();
+                float dy = py - tower->getY();
+                bool now_inside = dx * dx + dy * dy <= r_sq;
+
+                float t = k / (float)SUBSTEPS;
+                if (now_inside && !inside) {
+                    enter = std::max(0.0f, t - PAD);
+                }
+                else if (!now_inside && inside) {
+                    table.edges.push_back({ entry.first.first, entry.first.second, enter, t + PAD });
+                }
+                inside = now_inside;
+            }
+
+            //Το μονοπάτι τελειώνει μέσα στην ακτίνα
+            if (inside) {
+                table.edges.push_back({ entry.first.first, entry.first.second, enter, (float)(waypoints.size() - 1) });
+            }
+        }
+    }
+
+    exposure_dirty = false;
+    exposure_version++;
+}
+
+//Getter που επιστρέφει κοινόχρηστο δείκτη στο μονοπάτι
+std::shared_ptr<const PathData> EntityGraph::getSharedPath(Entity* from, Entity* to) const {
+    if (!from || !to) return nullptr;
+    auto it = paths.find({ from->getHandle(), to->getHandle() });
+    return (it != paths.end()) ? it->second : nullptr;
 }
 
 void EntityGraph::draw() const {
@@ -100,4 +201,6 @@ void EntityGraph::draw() const {
 void EntityGraph::clear() {
     connections.clear();
     paths.clear();
+    exposure.clear();
+    exposure_dirty = true;
 }
\ No newline at end of file
@@ -2,30 +2,64 @@
 #include "entity.h"
 #include <vector>
 #include <map>
+#include <unordered_map>
 #include <memory>
 
-//    (waypoints)
+//Δομή για αποθήκευση μονοπατιών (waypoints)
 struct PathData {
     std::vector<std::pair<float, float>> waypoints;
+    float length = 0.0f; //Συνολικό μήκος μονοπατιού (σε μονάδες καμβά)
 };
 
-//      
-//      troops
+//Διάστημα προόδου σε μια ακμή όπου ένα troop βρίσκεται μέσα στην ακτίνα ενός πύργου
+//(η πρόοδος μετριέται όπως στο Troop, σε μονάδες waypoints)
+struct EdgeExposure {
+    EntityHandle from;
+    EntityHandle to;
+    float enter; //Πρόοδος εισόδου στην ακτίνα
+    float exit;  //Πρόοδος εξόδου από την ακτίνα
+};
+
+//Πίνακας έκθεσης ενός πύργου: όλα τα διαστήματα όλων των ακμών που περνούν από την ακτίνα του
+struct TowerExposure {
+    int level;     //Level του πύργου όταν χτίστηκε ο πίνακας
+    float radius;  //Ακτίνα που χρησιμοποιήθηκε
+    std::vector<EdgeExposure> edges;
+};
+
+//Κλαση για διαχείριση γράφου συνδέσεων μεταξύ οντοτήτων
+//Δημιουργεί και αποθηκεύει μονοπάτια για μετακίνηση troops
 class EntityGraph {
 private:
-	std::map<Entity*, std::vector<Entity*>> connections; //  entities
-	std::map<std::pair<Entity*, Entity*>, PathData> paths; //     entities
+	//Τα entities αναφέρονται με handles: οι χάρτες μένουν έγκυροι όταν ένα entity μετατραπεί
+	//ή καταστραφεί (οι συνδέσεις με entities που δεν υπάρχουν πια αγνοούνται)
+	std::map<EntityHandle, std::vector<EntityHandle>> connections; //Χάρτης συνδέσεων entities
+	std::map<std::pair<EntityHandle, EntityHandle>, std::shared_ptr<const PathData>> paths; //Χάρτης μονοπατιών μεταξύ των συνδεδεμένων entities
+	std::unordered_map<EntityHandle, TowerExposure, EntityHandleHash> exposure; //Πίνακες έκθεσης ανά πύργο
+	bool exposure_dirty = true; //Αν οι πίνακες έκθεσης πρέπει να ξαναχτιστούν
+	unsigned int exposure_version = 0; //Αυξάνεται σε κάθε χτίσιμο των πινάκων έκθεσης
+	unsigned int path_version = 0; //Αυξάνεται σε κάθε calculatePaths (τα μονοπάτια παρακάμπτουν τα entities ανάλογα με το μέγεθός τους)
 public:
-    void addEdge(Entity* from, Entity* to); //    2 entities
-	void calculatePaths(const std::vector<std::unique_ptr<Entity>>& entities); //  
-    const PathData* getPath(Entity* from, Entity* to) const; //Getter    
-	void clear(); // 
+    void addEdge(Entity* from, Entity* to); //Προσθηκη αμφίδρομης σύνδεσης μεταξύ 2 entities (αν δεν υπάρχει ήδη)
+	void calculatePaths(const std::vector<std::unique_ptr<Entity>>& entities); //Υπολογισμός μονοπατιών 
+    const PathData* getPath(Entity* from, Entity* to) const; //Getter για επιστροφή μονοπατιου 
+    const PathData* getPath(EntityHandle from, EntityHandle to) const; //Τρέχον μονοπάτι μιας ακμής (nullptr αν δεν υπάρχει)
+    std::shared_ptr<const PathData> getSharedPath(Entity* from, Entity* to) const; //Κοινόχρηστο μονοπάτι (τα troops δεν αντιγράφουν τα waypoints)
+	void clear(); //Καθαρισμός γράφου
 	void draw() const;
 
-	//Getter     entity
-    const std::vector<Entity*>& getConnections(Entity* entity) const {
-        static const std::vector<Entity*> empty;
-        auto it = connections.find(entity);
+	//Πίνακες έκθεσης πύργων (τα μονοπάτια και οι πύργοι είναι στατικοί, άρα υπολογίζονται μία φορά)
+	void buildExposure(const std::vector<std::unique_ptr<Entity>>& entities); //Υπολογισμός για όλους τους πύργους
+	void invalidateExposure() { exposure_dirty = true; } //Ακύρωση (αναβάθμιση/μετατροπή)
+	bool isExposureDirty() const { return exposure_dirty; }
+	unsigned int getExposureVersion() const { return exposure_version; }
+	unsigned int getPathVersion() const { return path_version; }
+	const TowerExposure* getTowerExposure(const Entity* tower) const; //nullptr αν δεν υπάρχει
+
+	//Getter για τις συνδέσεις ενός entity
+    const std::vector<EntityHandle>& getConnections(const Entity* entity) const {
+        static const std::vector<EntityHandle> empty;
+        auto it = connections.find(entity->getHandle());
         if (it != connections.end()) {
             return it->second;
         }
@@ -1,186 +1,191 @@
 #include "hover_menu.h"
 #include "sgg/graphics.h"
 
-//  hover menu      
+// Εμφάνιση hover menu σε συγκεκριμένη θέση για συγκεκριμένη οντότητα
 void HoverMenu::show(float menu_x, float menu_y, Entity* entity, bool baby, int upgrade_cost) {
     x = menu_x;
     y = menu_y;
     visible = true;
-    target = entity;
+    target = entity->getHandle();
     is_baby = baby;
     cost = upgrade_cost;
-    buttons.clear();  //   buttons
+    buttons.clear();  // Καθαρισμός παλιών buttons
 
-    //  buttons      
+    // Δημιουργία buttons ανάλογα με τον τύπο της οντότητας
     if (is_baby) {
-        // Menu  Baby: 3  (Warrior, Tower, Wizard)   
-        buttons.push_back({ x - 0.5f, y - 1.3f, 0.4f, 0.4f, 0 });    //  - Warrior
-        buttons.push_back({ x, y - 1.5f, 0.4f, 0.4f, 1 });           //  - Tower  
-        buttons.push_back({ x + 0.5f, y - 1.3f, 0.4f, 0.4f, 2 });    //  - Wizard
+        // Menu για Baby: 3 επιλογές (Warrior, Tower, Wizard) σε τριγωνική διάταξη
+        buttons.push_back({ x - 0.5f, y - 1.3f, 0.4f, 0.4f, 0 });    // Αριστερό - Warrior
+        buttons.push_back({ x, y - 1.5f, 0.4f, 0.4f, 1 });           // Κεντρικό - Tower  
+        buttons.push_back({ x + 0.5f, y - 1.3f, 0.4f, 0.4f, 2 });    // Δεξιό - Wizard
     }
-    else if (entity->getType() == "Wizard") {
-        // Menu  Wizard: spells  ,     level
+    else if (entity->getKind() == EntityKind::WIZARD) {
+        // Menu για Wizard: spells και αναβάθμιση, διαφορετικό ανάλογα με το level
         Wizard* wizard = static_cast<Wizard*>(entity);
         int level = wizard->getLevel();
 
-        //  1: Freeze () +  ()
+        // Επίπεδο 1: Freeze (αριστερά) + Αναβάθμιση (κέντρο)
         if (level == 1) {
             buttons.push_back({ x - 0.5f, y - 1.3f, 0.4f, 0.4f, 10 }); // ID 10 = Freeze spell
-            buttons.push_back({ x, y - 1.5f, 0.4f, 0.4f, 0 });         // ID 0 = 
+            buttons.push_back({ x, y - 1.5f, 0.4f, 0.4f, 0 });         // ID 0 = Αναβάθμιση
         }
-        //  2: Freeze (),  (), Sickness ()
+        // Επίπεδο 2: Freeze (αριστερά), Αναβάθμιση (κέντρο), Sickness (δεξιά)
         else if (level == 2) {
             buttons.push_back({ x - 0.5f, y - 1.3f, 0.4f, 0.4f, 10 }); // Freeze
-            buttons.push_back({ x, y - 1.5f, 0.4f, 0.4f, 0 });         // 
+            buttons.push_back({ x, y - 1.5f, 0.4f, 0.4f, 0 });         // Αναβάθμιση
             buttons.push_back({ x + 0.5f, y - 1.3f, 0.4f, 0.4f, 11 }); // ID 11 = Sickness spell
         }
-        //  3: Freeze (), Convert (), Sickness () -  
+        // Επίπεδο 3: Freeze (αριστερά), Convert (κέντρο), Sickness (δεξιά) - ΧΩΡΙΣ ΑΝΑΒΑΘΜΙΣΗ
         else if (level >= 3) {
             buttons.push_back({ x - 0.5f, y - 1.3f, 0.4f, 0.4f, 10 }); // Freeze
             buttons.push_back({ x, y - 1.5f, 0.4f, 0.4f, 12 });         // ID 12 = Convert spell
             buttons.push_back({ x + 0.5f, y - 1.3f, 0.4f, 0.4f, 11 }); // Sickness
         }
     }
-    else if (entity->getType() == "Warrior") {
-        // Menu  Warrior:   ( level < 5)
+    else if (entity->getKind() == EntityKind::WARRIOR) {
+        // Menu για Warrior: μόνο αναβάθμιση (αν level < 5)
         Warrior* warrior = static_cast<Warrior*>(entity);
         int level = warrior->getLevel();
 
-        //  button   level < 5 ( )
+        // Εμφάνιση button μόνο αν level < 5 (μέγιστο επίπεδο)
         if (level < 5) {
-            buttons.push_back({ x, y - 1.5f, 0.4f, 0.4f, 0 }); //  - 
+            buttons.push_back({ x, y - 1.5f, 0.4f, 0.4f, 0 }); // Κεντρικό - Αναβάθμιση
         }
         else {
-            //  5 -  menu (   )
+            // Επίπεδο 5 - απόκρυψη menu (δεν υπάρχουν άλλες αναβαθμίσεις)
             visible = false;
         }
     }
-    else if (entity->getType() == "Tower") {
-        // Menu  Tower:   ( level < 5)
+    else if (entity->getKind() == EntityKind::TOWER) {
+        // Menu για Tower: αναβάθμιση (αν level < 5) και κλάδος splash (από το SPLASH_UNLOCK_LEVEL)
         Tower* tower = static_cast<Tower*>(entity);
         int level = tower->getLevel();
+        bool splash_option = !tower->isSplash() && level >= tower->getSplashUnlockLevel();
 
-        //  button   level < 5 ( )
+        // Εμφάνιση button αναβάθμισης μόνο αν level < 5 (μέγιστο επίπεδο)
         if (level < 5) {
-            buttons.push_back({ x, y - 1.5f, 0.4f, 0.4f, 0 }); //  - 
+            buttons.push_back({ x, y - 1.5f, 0.4f, 0.4f, 0 }); // Κεντρικό - Αναβάθμιση
         }
-        else {
-            //  5 -  menu (   )
+        if (splash_option) {
+            buttons.push_back({ x - 0.5f, y - 1.3f, 0.4f, 0.4f, 1 }); // Αριστερό - Splash
+        }
+        if (buttons.empty()) {
+            // Δεν υπάρχουν άλλες αναβαθμίσεις - απόκρυψη menu
             visible = false;
         }
     }
 }
 
-//        button  menu
+// Έλεγχος αν ο χρήστης κλικάρει σε κάποιο button του menu
 int HoverMenu::checkClick(float mx, float my) {
-    if (!visible) return -1;  //   menu   ,  -1
+    if (!visible) return -1;  // Αν το menu δεν είναι ορατό, επιστροφή -1
 
     for (size_t i = 0; i < buttons.size(); i++) {
         const Button& btn = buttons[i];
-        //           button
+        // Έλεγχος αν το σημείο κλικ βρίσκεται μέσα στα όρια του button
         if (mx >= btn.center_x - btn.width / 2 && mx <= btn.center_x + btn.width / 2 &&
             my >= btn.center_y - btn.height / 2 && my <= btn.center_y + btn.height / 2) {
-            return btn.option_id;  //  ID  button  
+            return btn.option_id;  // Επιστροφή ID του button που πατήθηκε
         }
     }
-    return -1;  //  button  
+    return -1;  // Κανένα button δεν πατήθηκε
 }
 
-//   hover menu
+// Απόκρυψη του hover menu
 void HoverMenu::hide() {
     visible = false;
-    target = nullptr;  //    
+    target = EntityHandle();  // Μηδενισμός handle προς οντότητα
 }
 
-//   hover menu
+// Σχεδίαση του hover menu
 void HoverMenu::draw() {
-    if (!visible || !target) return;  //          
+    Entity* entity = visible ? getTarget() : nullptr;
+    if (!entity) return;  // Μη σχεδίαση αν δεν είναι ορατό ή δεν έχει στόχο
 
-    float x = target->getX();
-    float y = target->getY();
+    float x = entity->getX();
+    float y = entity->getY();
     graphics::Brush br_back, br_char, br_text;
 
-    //     
-    br_back.fill_color[0] = 0.1f; br_back.fill_color[1] = 0.1f; br_back.fill_color[2] = 0.2f;  //   background
-    br_char.fill_color[0] = 0.1f; br_char.fill_color[1] = 0.1f; br_char.fill_color[2] = 1.0f;  //    
-    br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 1.0f; br_text.fill_color[2] = 1.0f;  //   
+    // Προκαθορισμένα χρώματα για διάφορα στοιχεία
+    br_back.fill_color[0] = 0.1f; br_back.fill_color[1] = 0.1f; br_back.fill_color[2] = 0.2f;  // Σκούρο μπλε background
+    br_char.fill_color[0] = 0.1f; br_char.fill_color[1] = 0.1f; br_char.fill_color[2] = 1.0f;  // Φωτεινό μπλε για στοιχεία
+    br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 1.0f; br_text.fill_color[2] = 1.0f;  // Άσπρο για κείμενο
 
     if (is_baby) {
-        //   BABY: 3  
+        // ΜΕΝΟΥ ΓΙΑ BABY: 3 επιλογές μετατροπής
 
-        //  (5 HP) -    Warrior
+        // ΚΥΚΛΟΣ (5 HP) - για μετατροπή σε Warrior
         graphics::drawRect(x - 0.5f, y + 1.1f - 1.3f, 0.4f, 0.4f, br_back);  // Background
-        graphics::drawDisk(x - 0.5f, y + 1.1f - 1.3f, 0.15f, br_char);        //  
-        graphics::drawText(x - 0.52f, y + 1.1f - 1.20f, 0.15f, "5", br_text); //  "5" ()
+        graphics::drawDisk(x - 0.5f, y + 1.1f - 1.3f, 0.15f, br_char);        // Μπλε δίσκος
+        graphics::drawText(x - 0.52f, y + 1.1f - 1.20f, 0.15f, "5", br_text); // Κείμενο "5" (κόστος)
 
-        //  (10 HP) -    Tower
+        // ΤΕΤΡΑΓΩΝΟ (10 HP) - για μετατροπή σε Tower
         graphics::drawRect(x, y + 1.1f - 1.5f, 0.4f, 0.4f, br_back);         // Background
-        graphics::drawRect(x, y + 1.1f - 1.5f, 0.25f, 0.25f, br_char);       //  
-        graphics::drawText(x - 0.06f, y + 1.1f - 1.4f, 0.15f, "10", br_text); //  "10" ()
+        graphics::drawRect(x, y + 1.1f - 1.5f, 0.25f, 0.25f, br_char);       // Μπλε τετράγωνο
+        graphics::drawText(x - 0.06f, y + 1.1f - 1.4f, 0.15f, "10", br_text); // Κείμενο "10" (κόστος)
 
-        //  (10 HP) -    Wizard
+        // ΤΡΙΓΩΝΟ (10 HP) - για μετατροπή σε Wizard
         graphics::drawRect(x + 0.5f, y + 1.1f - 1.3f, 0.4f, 0.4f, br_back);  // Background
-        graphics::drawSector(x + 0.5f, y + 1.1f - 1.45f, 0, 0.3f, 240, 300, br_char); //   ( )
+        graphics::drawSector(x + 0.5f, y + 1.1f - 1.45f, 0, 0.3f, 240, 300, br_char); // Μπλε τρίγωνο (μέρος κύκλου)
         br_back.outline_color[0] = 0.0f; br_back.outline_color[1] = 0.0f; br_back.outline_color[2] = 0.0f;
-        graphics::drawRect(x + 0.5f, y + 1.1f - 1.15f, 0.3f, 0.08f, br_back); //      
-        graphics::drawLine(x + 0.35f, y + 1.1f - 1.2f, x + 0.65f, y + 1.1f - 1.2f, br_text); //    
-        graphics::drawText(x + 0.44f, y + 1.1f - 1.20f, 0.15f, "10", br_text); //  "10" ()
+        graphics::drawRect(x + 0.5f, y + 1.1f - 1.15f, 0.3f, 0.08f, br_back); // Κάλυψη για να φαίνεται σαν τρίγωνο
+        graphics::drawLine(x + 0.35f, y + 1.1f - 1.2f, x + 0.65f, y + 1.1f - 1.2f, br_text); // Γραμμή για οπτική βελτίωση
+        graphics::drawText(x + 0.44f, y + 1.1f - 1.20f, 0.15f, "10", br_text); // Κείμενο "10" (κόστος)
     }
-    else if (target->getType() == "Wizard") {
-        //   WIZARD: spells  
-        Wizard* wizard = static_cast<Wizard*>(target);
+    else if (entity->getKind() == EntityKind::WIZARD) {
+        // ΜΕΝΟΥ ΓΙΑ WIZARD: spells και αναβάθμιση
+        Wizard* wizard = static_cast<Wizard*>(entity);
         int level = wizard->getLevel();
 
-        //  1: Freeze + 
+        // ΕΠΙΠΕΔΟ 1: Freeze + Αναβάθμιση
         if (level == 1) {
-            // FREEZE BUTTON () -   progress bar  cooldown
+            // FREEZE BUTTON (ΑΡΙΣΤΕΡΑ) - Μπλε με progress bar για cooldown
             graphics::drawRect(x - 0.5f, y + 1.1f - 1.3f, 0.4f, 0.4f, br_back);
 
             float freeze_cd = wizard->getSpellCooldown(0);
             if (freeze_cd > 0.0f) {
-                // Spell  cooldown -  
+                // Spell σε cooldown - γκρι δίσκος
                 br_char.fill_color[0] = 0.5f; br_char.fill_color[1] = 0.5f; br_char.fill_color[2] = 0.5f;
                 graphics::drawDisk(x - 0.5f, y + 1.1f - 1.3f, 0.15f, br_char);
 
-                //   ()     cooldown
+                // Προοδευτική μπάρα (κυκλική) που δείχνει το υπόλοιπο cooldown
                 float cooldown_progress = 1.0f - (freeze_cd / 10.0f);
                 float angle = 360.0f * cooldown_progress;
 
                 br_char.fill_color[0] = 0.3f; br_char.fill_color[1] = 0.3f; br_char.fill_color[2] = 1.0f;
                 graphics::drawSector(x - 0.5f, y + 1.1f - 1.3f, 0, 0.15f, 90, 90 + angle, br_char);
 
-                //  cooldown
+                // Χρονόμετρο cooldown
                 br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 1.0f; br_text.fill_color[2] = 1.0f;
                 graphics::drawText(x - 0.55f, y + 1.1f - 1.17f, 0.12f, std::to_string((int)freeze_cd + 1), br_text);
             }
             else {
-                //    -   
+                // Έτοιμο για χρήση - κανονικό μπλε δίσκο
                 br_char.fill_color[0] = 0.3f; br_char.fill_color[1] = 0.3f; br_char.fill_color[2] = 1.0f;
                 graphics::drawDisk(x - 0.5f, y + 1.1f - 1.3f, 0.15f, br_char);
 
-                //   (25 HP)
+                // Κείμενο κόστους (25 HP)
                 br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 1.0f; br_text.fill_color[2] = 1.0f;
                 if (wizard->canCastSpell(0)) {
-                    graphics::drawText(x - 0.53f, y + 1.1f - 1.17f, 0.12f, "25", br_text);  //   
+                    graphics::drawText(x - 0.53f, y + 1.1f - 1.17f, 0.12f, "25", br_text);  // Άσπρο αν μπορεί
                 }
                 else {
                     br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 0.3f; br_text.fill_color[2] = 0.3f;
-                    graphics::drawText(x - 0.53f, y + 1.1f - 1.17f, 0.12f, "25", br_text);  //    
+                    graphics::drawText(x - 0.53f, y + 1.1f - 1.17f, 0.12f, "25", br_text);  // Κόκκινο αν δεν μπορεί
                 }
             }
 
-            // UPGRADE BUTTON () -  Wizard
+            // UPGRADE BUTTON (ΚΕΝΤΡΟ) - Αναβάθμιση Wizard
             graphics::drawRect(x, y + 1.1f - 1.5f, 0.4f, 0.4f, br_back);
-            graphics::drawSector(x, y + 1.1f - 1.65f, 0, 0.25f, 240, 300, br_char); //  
+            graphics::drawSector(x, y + 1.1f - 1.65f, 0, 0.25f, 240, 300, br_char); // Μπλε τρίγωνο
             br_back.outline_color[0] = 0.1f; br_back.outline_color[1] = 0.1f; br_back.outline_color[2] = 0.2f;
-            graphics::drawRect(x, y + 1.1f - 1.4f, 0.3f, 0.08f, br_back);  // 
-            graphics::drawLine(x - 0.12f, y + 1.1f - 1.45f, x + 0.13f, y + 1.1f - 1.45f, br_text); // 
-            graphics::drawText(x - 0.17f, y + 1.1f - 1.32f, 0.12f, std::to_string(cost), br_text); //  
-            graphics::drawRect(x, y + 1.1f - 1.41f, 0.08f, 0.08f, br_char);  //  
+            graphics::drawRect(x, y + 1.1f - 1.4f, 0.3f, 0.08f, br_back);  // Κάλυψη
+            graphics::drawLine(x - 0.12f, y + 1.1f - 1.45f, x + 0.13f, y + 1.1f - 1.45f, br_text); // Γραμμή
+            graphics::drawText(x - 0.17f, y + 1.1f - 1.32f, 0.12f, std::to_string(cost), br_text); // Κόστος αναβάθμισης
+            graphics::drawRect(x, y + 1.1f - 1.41f, 0.08f, 0.08f, br_char);  // Μικρό τετράγωνο
         }
-        //  2: Freeze +  + Sickness
+        // ΕΠΙΠΕΔΟ 2: Freeze + Αναβάθμιση + Sickness
         else if (level == 2) {
-            // FREEZE BUTTON () -    level 1
+            // FREEZE BUTTON (ΑΡΙΣΤΕΡΑ) - Ίδια λογική με level 1
             graphics::drawRect(x - 0.5f, y + 1.1f - 1.3f, 0.4f, 0.4f, br_back);
 
             float freeze_cd = wizard->getSpellCooldown(0);
@@ -211,7 +216,7 @@ void HoverMenu::draw() {
                 }
             }
 
-            // UPGRADE BUTTON () -    level 1
+            // UPGRADE BUTTON (ΚΕΝΤΡΟ) - Ίδια λογική με level 1
             graphics::drawRect(x, y + 1.1f - 1.5f, 0.4f, 0.4f, br_back);
             graphics::drawSector(x, y + 1.1f - 1.65f, 0, 0.25f, 240, 300, br_char);
             br_back.outline_color[0] = 0.1f; br_back.outline_color[1] = 0.1f; br_back.outline_color[2] = 0.2f;
@@ -220,7 +225,7 @@ void HoverMenu::draw() {
             graphics::drawText(x - 0.17f, y + 1.1f - 1.32f, 0.12f, std::to_string(cost), br_text);
             graphics::drawRect(x, y + 1.1f - 1.41f, 0.08f, 0.08f, br_char);
 
-            // SICKNESS BUTTON () -   progress bar
+            // SICKNESS BUTTON (ΔΕΞΙΑ) - Πράσινο με progress bar
             graphics::drawRect(x + 0.5f, y + 1.1f - 1.3f, 0.4f, 0.4f, br_back);
 
             float sickness_cd = wizard->getSpellCooldown(1);
@@ -243,17 +248,17 @@ void HoverMenu::draw() {
 
                 br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 1.0f; br_text.fill_color[2] = 1.0f;
                 if (wizard->canCastSpell(1)) {
-                    graphics::drawText(x + 0.47f, y + 1.1f - 1.17f, 0.12f, "30", br_text);  //  30 HP
+                    graphics::drawText(x + 0.47f, y + 1.1f - 1.17f, 0.12f, "30", br_text);  // Κόστος 30 HP
                 }
                 else {
                     br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 0.3f; br_text.fill_color[2] = 0.3f;
-                    graphics::drawText(x + 0.47f, y + 1.1f - 1.17f, 0.12f, "30", br_text);  //    
+                    graphics::drawText(x + 0.47f, y + 1.1f - 1.17f, 0.12f, "30", br_text);  // Κόκκινο αν δεν μπορεί
                 }
             }
         }
-        //  3: Freeze + Convert + Sickness ( )
+        // ΕΠΙΠΕΔΟ 3: Freeze + Convert + Sickness (ΧΩΡΙΣ ΑΝΑΒΑΘΜΙΣΗ)
         else if (level >= 3) {
-            // FREEZE BUTTON () -  
+            // FREEZE BUTTON (ΑΡΙΣΤΕΡΑ) - Ίδια λογική
             graphics::drawRect(x - 0.5f, y + 1.1f - 1.3f, 0.4f, 0.4f, br_back);
 
             float freeze_cd = wizard->getSpellCooldown(0);
@@ -284,7 +289,7 @@ void HoverMenu::draw() {
                 }
             }
 
-            // CONVERT BUTTON () -   progress bar
+            // CONVERT BUTTON (ΚΕΝΤΡΟ) - Κόκκινο με progress bar
             graphics::drawRect(x, y + 1.1f - 1.5f, 0.4f, 0.4f, br_back);
 
             float convert_cd = wizard->getSpellCooldown(2);
@@ -307,15 +312,15 @@ void HoverMenu::draw() {
 
                 br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 1.0f; br_text.fill_color[2] = 1.0f;
                 if (wizard->canCastSpell(2)) {
-                    graphics::drawText(x - 0.07f, y + 1.1f - 1.35f, 0.12f, "50", br_text);  //  50 HP
+                    graphics::drawText(x - 0.07f, y + 1.1f - 1.35f, 0.12f, "50", br_text);  // Κόστος 50 HP
                 }
                 else {
                     br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 0.3f; br_text.fill_color[2] = 0.3f;
-                    graphics::drawText(x - 0.07f, y + 1.1f - 1.35f, 0.12f, "50", br_text);  //    
+                    graphics::drawText(x - 0.07f, y + 1.1f - 1.35f, 0.12f, "50", br_text);  // Κόκκινο αν δεν μπορεί
                 }
             }
 
-            // SICKNESS BUTTON () -    level 2
+            // SICKNESS BUTTON (ΔΕΞΙΑ) - Ίδια λογική με level 2
             graphics::drawRect(x + 0.5f, y + 1.1f - 1.3f, 0.4f, 0.4f, br_back);
 
             float sickness_cd = wizard->getSpellCooldown(1);
@@ -338,23 +343,57 @@ void HoverMenu::draw() {
 
                 br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 1.0f; br_text.fill_color[2] = 1.0f;
                 if (wizard->canCastSpell(1)) {
-                    graphics::drawText(x + 0.47f, y - 0.1f, 0.12f, "30", br_text);  //  30 HP
+                    graphics::drawText(x + 0.47f, y - 0.1f, 0.12f, "30", br_text);  // Κόστος 30 HP
                 }
                 else {
                     br_text.fill_color[0] = 1.0f; br_text.fill_color[1] = 0.3f; br_text.fill_color[2] = 0.3f;
-                    graphics::drawText(x + 0.47f, y - 0.1f, 0.12f, "30", br_text);  //    
+                    graphics::drawText(x + 0.47f, y - 0.1f, 0.12f, "30", br_text);  // Κόκκινο αν δεν μπορεί
                 }
             }
         }
     }
+    else if (entity->getKind() == EntityKind::TOWER) {
+        // ΜΕΝΟΥ ΓΙΑ TOWER: αναβάθμιση (κέντρο) και κλάδος splash (αριστερά)
+        Tower* tower = static_cast<Tower*>(entity);
+
+        if (tower->getLevel() < 5) {
+            graphics::drawRect(x, y + 1.1f - 1.5f, 0.4f, 0.4f, br_back);  // Background
+            graphics::drawSector(x, y + 1.1f - 1.65f, 0, 0.25f, 240, 300, br_char);  // Μπλε τρίγωνο
+            graphics::Brush br_cover = br_back;
+            br_cover.outline_color[0] = 0.1f; br_cover.outline_color[1] = 0.1f; br_cover.outline_color[2] = 0.2f;
+            graphics::drawRect(x, y + 1.1f - 1.4f, 0.3f, 0.08f, br_cover);  // Κάλυψη
+            graphics::drawLine(x - 0.12f, y + 1.1f - 1.45f, x + 0.13f, y + 1.1f - 1.45f, br_text);  // Γραμμή
+            graphics::drawText(x - 0.17f, y + 1.1f - 1.32f, 0.12f, std::to_string(cost), br_text);  // Κόστος αναβάθμισης
+            graphics::drawRect(x, y + 1.1f - 1.41f, 0.08f, 0.08f, br_char);  // Μικρό τετράγωνο
+        }
+
+        if (!tower->isSplash() && tower->getLevel() >= tower->getSplashUnlockLevel()) {
+            // SPLASH BUTTON (ΑΡΙΣΤΕΡΑ) - δακτύλιος γύρω από τετράγωνο
+            graphics::drawRect(x - 0.5f, y + 1.1f - 1.3f, 0.4f, 0.4f, br_back);
+            graphics::drawRect(x - 0.5f, y + 1.1f - 1.3f, 0.12f, 0.12f, br_char);
+
+            graphics::Brush br_ring;
+            br_ring.fill_opacity = 0.0f;
+            br_ring.outline_color[0] = 1.0f; br_ring.outline_color[1] = 0.8f; br_ring.outline_color[2] = 0.2f;
+            br_ring.outline_width = 2.0f;
+            graphics::drawDisk(x - 0.5f, y + 1.1f - 1.3f, 0.14f, br_ring);
+
+            // Κόστος: άσπρο αν μπορεί, κόκκινο αν δεν μπορεί
+            graphics::Brush br_cost = br_text;
+            if (!tower->canConvertToSplash()) {
+                br_cost.fill_color[0] = 1.0f; br_cost.fill_color[1] = 0.3f; br_cost.fill_color[2] = 0.3f;
+            }
+            graphics::drawText(x - 0.56f, y + 1.1f - 1.12f, 0.12f, std::to_string(tower->getSplashCost()), br_cost);
+        }
+    }
     else {
-        //  UPGRADE BUTTON    (Warrior, Tower)
+        // ΚΑΝΟΝΙΚΟ UPGRADE BUTTON για άλλες οντότητες (Warrior)
         graphics::drawRect(x, y + 1.1f - 1.5f, 0.4f, 0.4f, br_back);  // Background
-        graphics::drawSector(x, y + 1.1f - 1.65f, 0, 0.25f, 240, 300, br_char);  //  
+        graphics::drawSector(x, y + 1.1f - 1.65f, 0, 0.25f, 240, 300, br_char);  // Μπλε τρίγωνο
         br_back.outline_color[0] = 0.1f; br_back.outline_color[1] = 0.1f; br_back.outline_color[2] = 0.2f;
-        graphics::drawRect(x, y + 1.1f - 1.4f, 0.3f, 0.08f, br_back);  // 
-        graphics::drawLine(x - 0.12f, y + 1.1f - 1.45f, x + 0.13f, y + 1.1f - 1.45f, br_text);  // 
-        graphics::drawText(x - 0.17f, y + 1.1f - 1.32f, 0.12f, std::to_string(cost), br_text);  //  
-        graphics::drawRect(x, y + 1.1f - 1.41f, 0.08f, 0.08f, br_char);  //  
+        graphics::drawRect(x, y + 1.1f - 1.4f, 0.3f, 0.08f, br_back);  // Κάλυψη
+        graphics::drawLine(x - 0.12f, y + 1.1f - 1.45f, x + 0.13f, y + 1.1f - 1.45f, br_text);  // Γραμμή
+        graphics::drawText(x - 0.17f, y + 1.1f - 1.32f, 0.12f, std::to_string(cost), br_text);  // Κόστος αναβάθμισης
+        graphics::drawRect(x, y + 1.1f - 1.41f, 0.08f, 0.08f, br_char);  // Μικρό τετράγωνο
     }
 }
\ No newline at end of file
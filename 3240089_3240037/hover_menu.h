@@ -2,41 +2,41 @@
 #include "entity.h"
 #include <vector>
 
-//    hover menu       hover  entity
-//      ( Baby)
+// Κλάση για το hover menu που εμφανίζεται όταν ο παίκτης κάνει hover σε entity
+// Προσφερει επιλογές αναβαθμισης ή μετατροπής (για Baby)
 class HoverMenu {
 private:
-    float x, y;                 //   
-    bool visible = false;       //   menu  
-    Entity* target = nullptr;   //      menu
-    bool is_baby;               //     Baby
-    int cost;                   //   ( )
+    float x, y;                 // Θέση στην οθόνη
+    bool visible = false;       // Αν το menu είναι ορατό
+    EntityHandle target;        // Οντότητα στην οποία αναφέρεται το menu
+    bool is_baby;               // Αν η οντότητα είναι Baby
+    int cost;                   // Κόστος αναβάθμισης (αν υπάρχει)
 
-    //    buttons  menu
+    // Δομή για τα buttons του menu
     struct Button {
-        float center_x, center_y;  // 
-        float width, height;       // 
-        int option_id;             // ID  (0, 1, 2  10, 11, 12  spells)
+        float center_x, center_y;  // Κέντρο
+        float width, height;       // Μέγεθος
+        int option_id;             // ID επιλογής (0, 1, 2 ή 10, 11, 12 για spells)
     };
-    std::vector<Button> buttons;  //    buttons  menu
+    std::vector<Button> buttons;  // Λίστα όλων των buttons στο menu
 
 public:
-    //  menu      
+    // Εμφάνιση menu σε συγκεκριμένη θέση για συγκεκριμένη οντότητα
     void show(float menu_x, float menu_y, Entity* entity, bool baby, int cost);
 
-    //    click   button  menu
+    // Έλεγχος αν έγινε click αε κάποιο button του menu
     int checkClick(float mx, float my);
 
-    //  menu
+    // Απόκρυψη menu
     void hide();
 
-    //  menu
+    // Σχεδίαση menu
     void draw();
 
     // Getters
     int getUpgradeCost() const { return cost; }
     bool isVisible() const { return visible; }
-    Entity* getTarget() const { return target; }
+    Entity* getTarget() const { return EntityStore::getInstance()->resolve(target); }  // nullptr αν δεν υπάρχει πια
     bool getIsBaby() const { return is_baby; }
 
     float getX() const { return x; }
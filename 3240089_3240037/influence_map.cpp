@@ -0,0 +1,177 @@
+﻿#include "influence_map.h"
+#include "ai_planner.h"
+#include "simd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+const int InfluenceMap::WIDTH;
+const int InfluenceMap::HEIGHT;
+const int InfluenceMap::RADIUS;
+const float InfluenceMap::CELL_SIZE = 0.25f;
+const float InfluenceMap::STAMP_TOLERANCE = 2.0f;
+const float InfluenceMap::LEVEL_WEIGHT = 0.25f;
+const int InfluenceMap::REBUILD_INTERVAL = 64;
+
+// Constructor - ο πυρήνας είναι κώνος που φθίνει γραμμικά μέχρι την ακτίνα
+InfluenceMap::InfluenceMap() : update_count(0) {
+    for (int ky = 0; ky < KERNEL_SIZE; ky++) {
+        for (int kx = 0; kx < KERNEL_STRIDE; kx++) {
+            float weight = 0.0f;
+            if (kx < KERNEL_SIZE) {
+                float dx = (float)(kx - RADIUS);
+                float dy = (float)(ky - RADIUS);
+                float dist = std::sqrt(dx * dx + dy * dy);
+                if (dist <= (float)RADIUS) weight = 1.0f - dist / (float)(RADIUS + 1);
+            }
+            kernel[ky][kx] = weight;
+        }
+    }
+    clear();
+}
+
+int InfluenceMap::layerOf(Side side) {
+    switch (side) {
+    case Side::PLAYER: return 0;
+    case Side::ENEMY: return 1;
+    default: return -1;
+    }
+}
+
+int InfluenceMap::cellX(float x) {
+    return std::max(0, std::min(WIDTH - 1, (int)(x / CELL_SIZE)));
+}
+
+int InfluenceMap::cellY(float y) {
+    return std::max(0, std::min(HEIGHT - 1, (int)(y / CELL_SIZE)));
+}
+
+// Σφράγιση ανά γραμμή του πυρήνα (περικομμένη στα όρια του πλέγματος) - 4 κελιά ανά εντολή SSE
+void InfluenceMap::stamp(float (*cells)[WIDTH], int cx, int cy, float strength) {
+    int x0 = std::max(0, cx - RADIUS);
+    int x1 = std::min(WIDTH, cx + RADIUS + 1);
+    int y0 = std::max(0, cy - RADIUS);
+    int y1 = std::min(HEIGHT, cy + RADIUS + 1);
+    int k0 = x0 - (cx - RADIUS);
+
+#ifdef USE_SSE
+    const __m128 strength4 = _mm_set1_ps(strength);
+#endif
+
+    for (int y = y0; y < y1; y++) {
+        float* row = cells[y] + x0;
+        const float* weights = kernel[y - (cy - RADIUS)] + k0;
+        int count = x1 - x0;
+        int i = 0;
+
+#ifdef USE_SSE
+        for (; i + 4 <= count; i += 4) {
+            __m128 c = _mm_loadu_ps(row + i);
+            __m128 w = _mm_loadu_ps(weights + i);
+            _mm_storeu_ps(row + i, _mm_add_ps(c, _mm_mul_ps(w, strength4)));
+        }
+#endif
+
+        // Υπόλοιπα (ή όλα, χωρίς SSE)
+        for (; i < count; i++) {
+            row[i] += weights[i] * strength;
+        }
+    }
+}
+
+// Πρόσθεση (sign = 1) ή αφαίρεση (sign = -1) της σφραγίδας ενός entity
+void InfluenceMap::stampEntity(const Stamp& s, float sign) {
+    stamp(entity_cells[s.layer], s.cx, s.cy, sign * s.strength);
+}
+
+// Ενημέρωση από εικόνα
+void InfluenceMap::update(const AISnapshot& snapshot) {
+    update_count++;
+
+    // Περιοδικά ξαναχτίζουμε από την αρχή (οι αφαιρέσεις σφραγίδων αφήνουν μικρά υπόλοιπα)
+    if (update_count % REBUILD_INTERVAL == 0) {
+        std::memset(entity_cells, 0, sizeof(entity_cells));
+        for (Stamp& s : stamps) s.layer = -1;
+    }
+
+    const std::vector<AIEntityView>* groups[3] = { &snapshot.opponents, &snapshot.own, &snapshot.neutral };
+    for (const std::vector<AIEntityView>* group : groups) {
+        for (const AIEntityView& view : *group) {
+            int slot = view.handle.slot;
+            if (slot < 0) continue;
+
+            if (slot >= (int)stamps.size()) {
+                Stamp empty = { 0u, -1, 0, 0, 0.0f, 0u };
+                stamps.resize(slot + 1, empty);
+            }
+            Stamp& s = stamps[slot];
+
+            // Νέο entity στο ίδιο slot: η σφραγίδα του παλιού φεύγει
+            if (s.generation != view.handle.generation) {
+                if (s.layer >= 0) stampEntity(s, -1.0f);
+                s.layer = -1;
+                s.generation = view.handle.generation;
+            }
+            s.seen = update_count;
+
+            int layer = layerOf(view.side);
+            float strength = view.health * (1.0f + LEVEL_WEIGHT * (view.level - 1));
+            int cx = cellX(view.x);
+            int cy = cellY(view.y);
+
+            if (layer == s.layer && cx == s.cx && cy == s.cy &&
+                std::fabs(strength - s.strength) <= STAMP_TOLERANCE) continue;
+
+            if (s.layer >= 0) stampEntity(s, -1.0f);
+            s.layer = layer;
+            s.cx = cx;
+            s.cy = cy;
+            s.strength = strength;
+            if (s.layer >= 0) stampEntity(s, 1.0f);
+        }
+    }
+
+    // Entities που δεν υπάρχουν πια στην εικόνα
+    for (Stamp& s : stamps) {
+        if (s.layer >= 0 && s.seen != update_count) {
+            stampEntity(s, -1.0f);
+            s.layer = -1;
+        }
+    }
+
+    // Troops: η ζωή μοιράζεται στα σημεία της υπόλοιπης διαδρομής (μόνο οι εικόνες απόφασης τα έχουν)
+    if (snapshot.decide) {
+        std::memset(troop_cells, 0, sizeof(troop_cells));
+        for (const AITroopView& troop : snapshot.troops) {
+            int layer = layerOf(troop.side);
+            if (layer < 0) continue;
+
+            float share = (float)troop.amount / AITroopView::PATH_SAMPLES;
+            for (int i = 0; i < AITroopView::PATH_SAMPLES; i++) {
+                stamp(troop_cells[layer], cellX(troop.path_x[i]), cellY(troop.path_y[i]), share);
+            }
+        }
+    }
+}
+
+// Άδειασμα όλων των επιπέδων
+void InfluenceMap::clear() {
+    std::memset(entity_cells, 0, sizeof(entity_cells));
+    std::memset(troop_cells, 0, sizeof(troop_cells));
+    stamps.clear();
+    update_count = 0;
+}
+
+float InfluenceMap::sample(Side side, float x, float y) const {
+    int layer = layerOf(side);
+    if (layer < 0) return 0.0f;
+
+    int cx = cellX(x);
+    int cy = cellY(y);
+    return entity_cells[layer][cy][cx] + troop_cells[layer][cy][cx];
+}
+
+float InfluenceMap::balance(Side me, float x, float y) const {
+    Side opponent = (me == Side::ENEMY) ? Side::PLAYER : Side::ENEMY;
+    return sample(me, x, y) - sample(opponent, x, y);
+}
@@ -0,0 +1,66 @@
+﻿#pragma once
+#include "entity.h"
+#include <vector>
+
+struct AISnapshot;
+
+// Χάρτες επιρροής (influence maps) του AI πάνω σε πλέγμα που καλύπτει τον καμβά
+// Κάθε πλευρά (PLAYER, ENEMY) έχει δύο επίπεδα: τα entities, όπου κάθε entity "σφραγίζει"
+// τη δύναμή του (ζωή επί βάρος level) με πυρήνα που φθίνει με την απόσταση, και τα troops
+// σε κίνηση, όπου η ζωή κάθε troop μοιράζεται σε σημεία κατά μήκος της υπόλοιπης διαδρομής
+// Το επίπεδο των entities ενημερώνεται σταδιακά: κρατιέται η σφραγίδα κάθε entity και
+// ξαναγράφεται μόνο όταν αλλάξει κελί, πλευρά ή δύναμη πέρα από το STAMP_TOLERANCE
+// Το επίπεδο των troops ξαναχτίζεται σε κάθε εικόνα απόφασης
+// Η σφράγιση γίνεται ανά γραμμή του πυρήνα με SSE (4 κελιά ανά εντολή), οπότε οι
+// ερωτήσεις είναι ένα διάβασμα κελιού, ανεξάρτητα από το πλήθος των entities
+// Ανήκει στον σχεδιασμό του AI (δεν μοιράζεται με το main thread)
+class InfluenceMap {
+public:
+    static const int WIDTH = 64;         // Κελιά ανά άξονα (ο καμβάς είναι 16 x 8)
+    static const int HEIGHT = 32;
+    static const float CELL_SIZE;        // Μέγεθος κελιού (σε μονάδες καμβά)
+    static const int RADIUS = 8;         // Ακτίνα του πυρήνα (σε κελιά)
+
+private:
+    static const int KERNEL_SIZE = 2 * RADIUS + 1;
+    static const int KERNEL_STRIDE = (KERNEL_SIZE + 3) & ~3;  // Γραμμή πυρήνα σε πολλαπλάσιο του 4
+    static const int LAYERS = 2;         // PLAYER, ENEMY
+    static const float STAMP_TOLERANCE;  // Αλλαγή δύναμης που απαιτεί νέα σφραγίδα
+    static const float LEVEL_WEIGHT;     // Επιπλέον βάρος δύναμης ανά level πάνω από το 1
+    static const int REBUILD_INTERVAL;   // Ενημερώσεις ανάμεσα σε πλήρη ξαναχτίσματα (σφάλματα στρογγυλοποίησης)
+
+    // Σφραγίδα ενός entity (ανά slot του EntityStore)
+    struct Stamp {
+        unsigned int generation;
+        int layer;                       // -1: καμία σφραγίδα
+        int cx, cy;
+        float strength;
+        unsigned int seen;               // Τελευταία ενημέρωση που το είδε
+    };
+
+    float kernel[KERNEL_SIZE][KERNEL_STRIDE];    // Βάρη (0 έξω από την ακτίνα και στο padding)
+    float entity_cells[LAYERS][HEIGHT][WIDTH];
+    float troop_cells[LAYERS][HEIGHT][WIDTH];
+    std::vector<Stamp> stamps;
+    unsigned int update_count;
+
+    static int layerOf(Side side);       // -1 για NEUTRAL
+    static int cellX(float x);
+    static int cellY(float y);
+
+    // Πρόσθεση strength * πυρήνα με κέντρο το κελί (cx, cy)
+    void stamp(float (*cells)[WIDTH], int cx, int cy, float strength);
+    void stampEntity(const Stamp& s, float sign);
+
+public:
+    InfluenceMap();
+
+    // Ενημέρωση από εικόνα (τα troops μόνο αν η εικόνα τα περιέχει, δηλαδή στις αποφάσεις)
+    void update(const AISnapshot& snapshot);
+    void clear();
+
+    // Επιρροή μιας πλευράς στο σημείο (entities και troops - 0 για NEUTRAL)
+    float sample(Side side, float x, float y) const;
+    // Επιρροή της πλευράς me μείον του αντιπάλου της (θετικό: η περιοχή ελέγχεται από την me)
+    float balance(Side me, float x, float y) const;
+};
@@ -2,7 +2,6 @@
 #include "graph.h"
 #include <cmath>  // Προςθήκη για sqrt
 #include <memory> // Προςθήκη για std::make_unique
-#include "global_state.h" // Για πρόσβαση σε troops
 
 LevelManager::LevelManager() : current_level(1), max_levels(3) {}
 
@@ -1,5 +1,6 @@
 ﻿#include "global_state.h"
 #include "sgg/graphics.h"
+#include <string>
 
 // Wrapper functions για τα callbacks της sgg
 void draw() {
@@ -10,7 +11,28 @@ void update(float dt) {
     GlobalState::getInstance()->update(dt);
 }
 
-int main() {
+int main(int argc, char** argv) {
+    // --autoplay: αγώνας AI εναντίον AI (benchmarks και soak tests χωρίς ποντίκι)
+    // --params <αρχείο>: παράμετροι του AI του εχθρού (π.χ. το αρχείο του ai_tuner)
+    // --search: δυσκολία με αναζήτηση (οι αποστολές των AI επιλέγονται με search)
+    // --trace: ίχνος αποφάσεων των AI (dump με το F9 και σε αιχμή του frame)
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--autoplay") {
+            GlobalState::getInstance()->setAutoplay(true);
+        }
+        else if (arg == "--params" && i + 1 < argc) {
+            AIParams params;
+            if (params.load(argv[++i])) GlobalState::getInstance()->setAIParams(params);
+        }
+        else if (arg == "--search") {
+            GlobalState::getInstance()->setAISearch(true);
+        }
+        else if (arg == "--trace") {
+            GlobalState::getInstance()->enableAITrace();
+        }
+    }
+
     // Αρχικοποίηση του παιχνιδιού μέσω του GlobalState (Singleton pattern)
     GlobalState::getInstance()->init();
 
@@ -1,28 +1,28 @@
 #pragma once
 
 
-//    ,      (Troop  Entity)
+//Αφηρημένη κλάση για κόμβους γραφικων, που κληρονομείται από άλλες κλάσεις (Troop και Entity)
 class Node {
 protected:
-	float x, y; // 
+	float x, y; //Συντεταγμένες κόμβου
 
 public:
 
-	// Constructor  Destructor
+	//Δήλωση Constructor και Destructor
     Node(float x = 0.0f, float y = 0.0f);
     virtual ~Node() = default;
 
-    //E    
+    //Eνημέρωση κατάστασης και σχεδίαση κόμβου
     virtual void update(float dt) = 0;
     virtual void draw() = 0;
 
-	//   (mx, my)    
+	//Έλεγχος αν το (mx, my) βρίσκεται εντός του κόμβου
     virtual bool contains(float mx, float my) const;
 
-    // Getters 
+    // Getters συντεταγμενων
     float getX() const;
     float getY() const;
 
-    // Setter 
+    // Setter θεσης
     void setPosition(float new_x, float new_y);
 };
\ No newline at end of file
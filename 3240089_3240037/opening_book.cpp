@@ -0,0 +1,114 @@
+﻿#include "opening_book.h"
+#include "binary_io.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+const char* OpeningBook::DEFAULT_FILE = "assets/opening_book.bin";
+const unsigned char OpeningBook::VERSION = 1;
+
+static const char BOOK_MAGIC[4] = { 'J', 'G', 'O', 'B' };
+
+// Χρόνοι σε εκατοστά του δευτερολέπτου (έως 655 δευτερόλεπτα)
+static unsigned short packTime(float seconds) {
+    float value = std::round(seconds * 100.0f);
+    return (unsigned short)std::min(std::max(value, 0.0f), 65535.0f);
+}
+
+bool OpeningBook::load(const std::string& path) {
+    lines.clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    char magic[4];
+    unsigned int version, count;
+    if (!file.read(magic, 4) || !std::equal(magic, magic + 4, BOOK_MAGIC)) return false;
+    if (!readValue(file, version, 1) || version != VERSION || !readValue(file, count, 2)) return false;
+
+    std::vector<OpeningLine> loaded(count);
+    for (OpeningLine& line : loaded) {
+        unsigned int level, side, hash, end_time, moves;
+        if (!readValue(file, level, 1) || !readValue(file, side, 1) || !readValue(file, hash, 4) ||
+            !readValue(file, end_time, 2) || !readValue(file, moves, 2)) return false;
+        if (side > (unsigned int)Side::NEUTRAL) return false;
+
+        line.level = (int)level;
+        line.side = static_cast<Side>(side);
+        line.layout_hash = hash;
+        line.end_time = end_time / 100.0f;
+        line.moves.resize(moves);
+        for (OpeningMove& move : line.moves) {
+            unsigned int time, from, to, amount;
+            if (!readValue(file, time, 2) || !readValue(file, from, 1) || !readValue(file, to, 1) ||
+                !readValue(file, amount, 2)) return false;
+            move.time = time / 100.0f;
+            move.from = (int)from;
+            move.to = (int)to;
+            move.amount = (int)amount;
+        }
+    }
+
+    lines.swap(loaded);
+    return true;
+}
+
+bool OpeningBook::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    file.write(BOOK_MAGIC, 4);
+    writeValue(file, VERSION, 1);
+    writeValue(file, (unsigned int)lines.size(), 2);
+    for (const OpeningLine& line : lines) {
+        writeValue(file, (unsigned int)line.level, 1);
+        writeValue(file, (unsigned int)line.side, 1);
+        writeValue(file, line.layout_hash, 4);
+        writeValue(file, packTime(line.end_time), 2);
+        writeValue(file, (unsigned int)line.moves.size(), 2);
+        for (const OpeningMove& move : line.moves) {
+            writeValue(file, packTime(move.time), 2);
+            writeValue(file, (unsigned int)move.from, 1);
+            writeValue(file, (unsigned int)move.to, 1);
+            writeValue(file, (unsigned int)std::min(std::max(move.amount, 0), 65535), 2);
+        }
+    }
+    return (bool)file;
+}
+
+void OpeningBook::add(const OpeningLine& line) {
+    for (OpeningLine& existing : lines) {
+        if (existing.level == line.level && existing.side == line.side) {
+            existing = line;
+            return;
+        }
+    }
+    lines.push_back(line);
+}
+
+const OpeningLine* OpeningBook::find(int level, Side side, unsigned int layout_hash) const {
+    for (const OpeningLine& line : lines) {
+        if (line.level == level && line.side == side && line.layout_hash == layout_hash) return &line;
+    }
+    return nullptr;
+}
+
+// FNV-1a πάνω στα στοιχεία κάθε entity (θέσεις σε εκατοστά της μονάδας του καμβά)
+unsigned int OpeningBook::hashLayout(const std::vector<std::unique_ptr<Entity>>& entities) {
+    unsigned int hash = 2166136261u;
+    for (const std::unique_ptr<Entity>& entity : entities) {
+        unsigned int fields[5] = {
+            (unsigned int)entity->getKind(),
+            (unsigned int)entity->getSide(),
+            (unsigned int)(int)std::round(entity->getX() * 100.0f),
+            (unsigned int)(int)std::round(entity->getY() * 100.0f),
+            (unsigned int)entity->getHealth()
+        };
+        for (unsigned int field : fields) {
+            for (int i = 0; i < 4; i++) {
+                hash ^= (field >> (8 * i)) & 0xFF;
+                hash *= 16777619u;
+            }
+        }
+    }
+    return hash;
+}
@@ -0,0 +1,56 @@
+﻿#pragma once
+#include "entity.h"
+#include <vector>
+#include <memory>
+#include <string>
+
+// Αποστολή troops του βιβλίου ανοιγμάτων
+struct OpeningMove {
+    float time = 0.0f;     // Δευτερόλεπτα από την αρχή του level
+    int from = -1;         // Θέσεις στη σειρά δημιουργίας του level (LevelManager)
+    int to = -1;
+    int amount = 0;
+};
+
+// Άνοιγμα μιας πλευράς σε ένα level: οι αποστολές μέχρι το end_time (ο χρόνος της
+// τελευταίας), όπου αρχίζουν οι κανονικές αποφάσεις του AI. Ισχύει μόνο για τη διάταξη
+// με το ίδιο layout_hash
+struct OpeningLine {
+    int level = 0;
+    Side side = Side::ENEMY;
+    unsigned int layout_hash = 0;
+    float end_time = 0.0f;
+    std::vector<OpeningMove> moves;
+};
+
+// Βιβλίο ανοιγμάτων του AI (προϋπολογισμένο από το opening_book_gen με αγώνες χωρίς γραφικά)
+// Οι πρώτες αποφάσεις σε κάθε level είναι σχεδόν ίδιες σε κάθε αγώνα, οπότε αντί να
+// υπολογίζονται κάθε φορά διαβάζονται από εδώ στο initLevel
+// Δυαδικό αρχείο little-endian: "JGOB", έκδοση (1 byte), πλήθος γραμμών (2 bytes) και ανά γραμμή
+// level, πλευρά (1 byte το καθένα), layout_hash (4), end_time (2) και πλήθος κινήσεων (2).
+// Κάθε κίνηση είναι 6 bytes: χρόνος (2), from, to (1 το καθένα) και ποσότητα (2). Οι χρόνοι
+// είναι σε εκατοστά του δευτερολέπτου
+class OpeningBook {
+public:
+    static const char* DEFAULT_FILE;
+
+private:
+    static const unsigned char VERSION;
+
+    std::vector<OpeningLine> lines;
+
+public:
+    // false αν το αρχείο δεν υπάρχει ή δεν είναι έγκυρο (το βιβλίο μένει άδειο)
+    bool load(const std::string& path);
+    bool save(const std::string& path) const;
+
+    void add(const OpeningLine& line);   // Αντικαθιστά τη γραμμή του ίδιου level και πλευράς
+    void clear() { lines.clear(); }
+
+    // Γραμμή για το level και την πλευρά (nullptr αν δεν υπάρχει ή η διάταξη άλλαξε)
+    const OpeningLine* find(int level, Side side, unsigned int layout_hash) const;
+    const std::vector<OpeningLine>& getLines() const { return lines; }
+
+    // Αποτύπωμα της διάταξης ενός level (είδος, πλευρά, θέση και ζωή κάθε entity με τη σειρά)
+    static unsigned int hashLayout(const std::vector<std::unique_ptr<Entity>>& entities);
+};
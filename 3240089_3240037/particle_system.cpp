@@ -0,0 +1,119 @@
+﻿#include "particle_system.h"
+#include "sgg/graphics.h"
+#include "simd.h"
+#include <algorithm>
+
+// Constructor
+ParticleSystem::ParticleSystem() : head(0), count(0) {}
+
+// Δημιουργία νέου particle
+void ParticleSystem::spawn(float sx, float sy, float ex, float ey, float r0, float r1,
+    float duration, float r, float g, float b, Shape s) {
+    if (duration <= 0.0f) return;
+
+    int i = head;
+    start_x[i] = sx;
+    start_y[i] = sy;
+    end_x[i] = ex;
+    end_y[i] = ey;
+    radius_start[i] = r0;
+    radius_end[i] = r1;
+    elapsed[i] = 0.0f;
+    inv_duration[i] = 1.0f / duration;
+    progress[i] = 0.0f;
+    color_r[i] = r;
+    color_g[i] = g;
+    color_b[i] = b;
+    shape[i] = s;
+
+    head = (head + 1) & MASK;
+
+    // Αν ο buffer ήταν γεμάτος, το παλιότερο particle αντικαταστάθηκε
+    if (count < CAPACITY) count++;
+}
+
+// Ενημέρωση συνεχούς τμήματος [begin, end) - 4 particles ανά εντολή SSE
+void ParticleSystem::updateSpan(int begin, int end, float dt_seconds) {
+    int i = begin;
+
+#ifdef USE_SSE
+    const __m128 dt4 = _mm_set1_ps(dt_seconds);
+    const __m128 one4 = _mm_set1_ps(1.0f);
+    for (; i + 4 <= end; i += 4) {
+        __m128 e = _mm_add_ps(_mm_loadu_ps(&elapsed[i]), dt4);
+        _mm_storeu_ps(&elapsed[i], e);
+        __m128 p = _mm_min_ps(_mm_mul_ps(e, _mm_loadu_ps(&inv_duration[i])), one4);
+        _mm_storeu_ps(&progress[i], p);
+    }
+#endif
+
+    // Υπόλοιπα (ή όλα, χωρίς SSE)
+    for (; i < end; i++) {
+        elapsed[i] += dt_seconds;
+        progress[i] = std::min(elapsed[i] * inv_duration[i], 1.0f);
+    }
+}
+
+// Ενημέρωση όλων των ενεργών particles
+void ParticleSystem::update(float dt) {
+    if (count == 0) return;
+
+    float dt_seconds = dt / 1000.0f;
+    int tail = (head - count) & MASK;
+
+    // Τα ενεργά particles είναι ένα ή δύο συνεχή τμήματα (αν ο buffer έχει τυλιχτεί)
+    if (tail + count <= CAPACITY) {
+        updateSpan(tail, tail + count, dt_seconds);
+    }
+    else {
+        updateSpan(tail, CAPACITY, dt_seconds);
+        updateSpan(0, head, dt_seconds);
+    }
+
+    // Απόσυρση των particles της ουράς που έληξαν
+    while (count > 0 && progress[tail] >= 1.0f) {
+        tail = (tail + 1) & MASK;
+        count--;
+    }
+}
+
+// Σχεδίαση όλων των ενεργών particles
+void ParticleSystem::draw() const {
+    graphics::Brush br;
+
+    for (int n = 0, i = (head - count) & MASK; n < count; n++, i = (i + 1) & MASK) {
+        float p = progress[i];
+        if (p >= 1.0f) continue;  // Έληξε αλλά βρίσκεται πίσω από particle που ζει ακόμα
+
+        float alpha = 1.0f - p;  // Απόσβεση με το χρόνο
+        br.fill_color[0] = color_r[i];
+        br.fill_color[1] = color_g[i];
+        br.fill_color[2] = color_b[i];
+        br.outline_width = 3.0f;
+        br.outline_opacity = alpha;
+
+        if (shape[i] == RING) {
+            // Μόνο περίγραμμα στο χρώμα του effect
+            br.outline_color[0] = color_r[i];
+            br.outline_color[1] = color_g[i];
+            br.outline_color[2] = color_b[i];
+            br.fill_opacity = 0.0f;
+        }
+        else {
+            br.fill_opacity = alpha;
+        }
+
+        // Τρέχουσα θέση και ακτίνα (γραμμική παρεμβολή)
+        float cx = start_x[i] + (end_x[i] - start_x[i]) * p;
+        float cy = start_y[i] + (end_y[i] - start_y[i]) * p;
+        float radius = radius_start[i] + (radius_end[i] - radius_start[i]) * p;
+
+        graphics::drawDisk(cx, cy, radius, br);
+    }
+}
+
+// Αφαίρεση όλων των particles
+void ParticleSystem::clear() {
+    head = 0;
+    count = 0;
+}
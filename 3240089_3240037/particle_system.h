@@ -0,0 +1,50 @@
+﻿#pragma once
+
+// Σύστημα particles σταθερής χωρητικότητας για τα οπτικά effects
+// (βολές πύργων, μετατροπές, αφίξεις troops, spells)
+// Τα δεδομένα είναι σε μορφή SoA (ένας πίνακας ανά πεδίο) ώστε η ενημέρωση να γίνεται
+// με SIMD, και οι θέσεις χρησιμοποιούνται κυκλικά (ring buffer): τα νέα particles
+// γράφονται στο head και τα παλιότερα αποσύρονται από την ουρά όταν λήξουν
+// Όταν ο buffer γεμίσει, το νέο particle αντικαθιστά το παλιότερο (σταθερό budget)
+class ParticleSystem {
+public:
+    static const int CAPACITY = 512; // Μέγιστο πλήθος ενεργών effects (δύναμη του 2)
+
+    // Είδος σχεδίασης
+    enum Shape : unsigned char {
+        DISK = 0,   // Γεμάτος δίσκος (π.χ. βολή πύργου)
+        RING = 1    // Δακτύλιος που ανοίγει (π.χ. μετατροπή, spell)
+    };
+
+private:
+    static const int MASK = CAPACITY - 1;
+
+    // SoA αποθήκευση
+    float start_x[CAPACITY], start_y[CAPACITY]; // Θέση έναρξης
+    float end_x[CAPACITY], end_y[CAPACITY];     // Θέση λήξης (γραμμική παρεμβολή)
+    float radius_start[CAPACITY];               // Ακτίνα στην αρχή
+    float radius_end[CAPACITY];                 // Ακτίνα στο τέλος
+    float elapsed[CAPACITY];                    // Χρόνος από τη δημιουργία (δευτερόλεπτα)
+    float inv_duration[CAPACITY];               // 1 / διάρκεια
+    float progress[CAPACITY];                   // elapsed / duration, περικομμένο στο [0, 1]
+    float color_r[CAPACITY], color_g[CAPACITY], color_b[CAPACITY];
+    unsigned char shape[CAPACITY];
+
+    int head;   // Θέση του επόμενου particle
+    int count;  // Πλήθος particles από την ουρά μέχρι το head
+
+    void updateSpan(int begin, int end, float dt_seconds); // Ενημέρωση συνεχούς τμήματος (SIMD)
+
+public:
+    ParticleSystem();
+
+    // Δημιουργία effect που κινείται από (sx, sy) σε (ex, ey) και αλλάζει ακτίνα από r0 σε r1
+    void spawn(float sx, float sy, float ex, float ey, float r0, float r1,
+        float duration, float r, float g, float b, Shape s);
+
+    void update(float dt);  // dt σε ms όπως όλα τα update του παιχνιδιού
+    void draw() const;
+    void clear();
+
+    int getCount() const { return count; }
+};
@@ -2,19 +2,19 @@
 #include "sgg/graphics.h"
 #include <string>
 
-//    pause menu  
-//   pause button         paused
+// Κλάση για το pause menu του παιχνιδιού
+// Χειρίζεται το pause button και το μενού επιλογών όταν το παιχνίδι είναι paused
 class PauseMenu {
 private:
-    //           //    :
-    bool game_paused;           //    paused
-    bool pause_button_hovered;  //      pause button
-    bool resume_button_hovered; //      resume button
-    bool restart_button_hovered;//      restart button
-    bool next_level_hovered;    //      next level button
+    // Κατάσταση παύσης         //Οι παρακάτω συναρτησεις ελέγχουν αν:
+    bool game_paused;           // το παιχνίδι είναι paused
+    bool pause_button_hovered;  // ο δείκτης είναι πάνω στο pause button
+    bool resume_button_hovered; // ο δείκτης είναι πάνω στο resume button
+    bool restart_button_hovered;// ο δείκτης είναι πάνω στο restart button
+    bool next_level_hovered;    // ο δείκτης είναι πάνω στο next level button
     bool exit_button_hovered;
 
-    //    buttons (resume, restart, next level (  -))
+    // Αποτελέσματα κλικ σε buttons (resume, restart, next level (αν είναι διαθέσιμο-υπάρχει))
     bool resume_clicked;        
     bool restart_clicked;       
     bool next_level_clicked;    
@@ -23,20 +23,20 @@ private:
     bool next_level_available;  
     bool exit_available;
 
-    //    pause button
+    // Θέση και μέγεθος pause button
     float pause_button_x, pause_button_y;
     float pause_button_width, pause_button_height;
 
-    //    pause menu
+    // Θέση και μέγεθος pause menu
     float pause_menu_x, pause_menu_y;
     float pause_menu_width, pause_menu_height;
 
-    //  buttons  
+    // Θέσεις buttons στο μενού
     float resume_button_x, resume_button_y;
     float restart_button_x, restart_button_y;
     float next_level_button_x, next_level_button_y;
     float exit_button_x, exit_button_y;
-    float button_width, button_height;  //    buttons
+    float button_width, button_height;  // Μέγεθος όλων των buttons
 
 public:
     //constructor
@@ -46,13 +46,13 @@ public:
 
     void setExitAvailable(bool available);
 
-    //   buttons       level
+    // Ενημέρωση θέσεων buttons ανάλογα με το αν υπάρχει επόμενο level
     void updateButtonPositions(bool has_next_level);
 
-    //   (, hover)  frame
+    // Ενημέρωση κατάστασης (κλικ, hover) κάθε frame
     void update(float canvas_x, float canvas_y, bool mouse_pressed);
 
-    //   pause button    (  visible)
+    // Σχεδίαση του pause button και του μενού (αν είναι visible)
     void draw() const;
 
     // Setters/Getters
@@ -63,16 +63,16 @@ public:
     bool isNextLevelClicked() { bool val = next_level_clicked; next_level_clicked = false; return val; }
     bool isExitClicked() { bool val = exit_clicked; exit_clicked = false; return val; }
 
-    //  / 
+    // Έλεγχος παύσης/συνέχισης παιχνιδιού
     void pauseGame();
     void resumeGame();
 
-    //   (   level)
+    // Επαναφορά κατάστασης (όταν ξεκινάει νέο level)
     void reset();
 
-    //        pause button
+    // Έλεγχος αν ο δείκτης είναι πάνω στο pause button
     bool isMouseOverPauseButton(float mx, float my) const;
 
-    //        next level button
+    // Έλεγχος αν ο δείκτης είναι πάνω στο next level button
     bool isMouseOverNextLevelButton(float mx, float my) const;
 };
\ No newline at end of file
@@ -0,0 +1,283 @@
+﻿#include "self_play.h"
+#include "level_manager.h"
+#include "graph.h"
+#include "opening_book.h"
+#include <algorithm>
+#include <cmath>
+
+const float SelfPlayMatch::STEP_SECONDS = 0.25f;
+const float SelfPlayMatch::MAX_SECONDS = 180.0f;
+const float SelfPlayMatch::FIRST_DECISION = 2.0f;
+
+// Εικόνα ενός entity του level (χωρίς αναβαθμίσεις και spells, που ο SimWorld δεν έχει)
+static void fillLayoutView(AIEntityView& view, Entity* entity, int index) {
+    view.handle.slot = index;
+    view.handle.generation = 1;
+    view.kind = entity->getKind();
+    view.side = entity->getSide();
+    view.health = entity->getHealth();
+    view.max_health = entity->getMaxHealth();
+    view.level = entity->getLevel();
+    view.x = entity->getX();
+    view.y = entity->getY();
+    view.healing_speed = entity->getHealingSpeed();
+    view.defense = entity->getDefense();
+    view.attacking_speed = entity->getAttackingSpeed();
+    view.tower_damage = 0;
+    view.attack_interval = 0.0f;
+    view.attack_radius = 0.0f;
+    if (view.kind == EntityKind::TOWER) {
+        Tower* tower = static_cast<Tower*>(entity);
+        view.tower_damage = tower->getDamage();
+        view.attack_interval = tower->getAttackInterval();
+        view.attack_radius = tower->getAttackRadius();
+    }
+
+    view.can_upgrade = false;
+    view.can_splash = false;
+    view.splash_cost = 0;
+    for (int i = 0; i < 3; i++) {
+        view.can_cast[i] = false;
+        view.spell_cost[i] = 0;
+    }
+    view.projected_side = view.side;
+    view.projected_health = view.health;
+}
+
+// Μήκος του ευθύγραμμου τμήματος (ax, ay) - (bx, by) μέσα στον κύκλο (cx, cy, radius)
+static float chordLength(float ax, float ay, float bx, float by, float cx, float cy, float radius) {
+    float dx = bx - ax;
+    float dy = by - ay;
+    float a = dx * dx + dy * dy;
+    if (a <= 0.0f) return 0.0f;
+
+    float fx = ax - cx;
+    float fy = ay - cy;
+    float b = 2.0f * (fx * dx + fy * dy);
+    float c = fx * fx + fy * fy - radius * radius;
+    float disc = b * b - 4.0f * a * c;
+    if (disc <= 0.0f) return 0.0f;
+
+    float root = std::sqrt(disc);
+    float t1 = std::max(0.0f, (-b - root) / (2.0f * a));
+    float t2 = std::min(1.0f, (-b + root) / (2.0f * a));
+    return t2 > t1 ? (t2 - t1) * std::sqrt(a) : 0.0f;
+}
+
+bool MatchLayout::buildFromLevel(int level_number) {
+    LevelManager levels;
+    if (level_number < 1 || level_number > levels.getMaxLevels()) return false;
+
+    std::vector<std::unique_ptr<Entity>> entities;
+    EntityGraph graph;
+    levels.initLevel(level_number, entities, graph);
+    int n = (int)entities.size();
+    if (n == 0 || n > SimWorld::MAX_ENTITIES) return false;
+
+    // Όλα τα entities σε μία ομάδα της εικόνας, ώστε ο κόσμος να έχει τη σειρά του level
+    AISnapshot all;
+    all.neutral.resize(n);
+    for (int i = 0; i < n; i++) fillLayoutView(all.neutral[i], entities[i].get(), i);
+    start.build(all);
+
+    level = level_number;
+    layout_hash = OpeningBook::hashLayout(entities);
+    views = all.neutral;
+    towers.clear();
+    for (int i = 0; i < n; i++) {
+        if (start.tower[i]) towers.push_back(i);
+    }
+
+    distance.assign(n * n, 0.0f);
+    exposed.assign(n * n * n, 0.0f);
+    for (int from = 0; from < n; from++) {
+        for (int to = 0; to < n; to++) {
+            float dx = start.x[to] - start.x[from];
+            float dy = start.y[to] - start.y[from];
+            distance[from * n + to] = std::sqrt(dx * dx + dy * dy);
+
+            for (int tower : towers) {
+                exposed[(tower * n + from) * n + to] = chordLength(start.x[from], start.y[from], start.x[to], start.y[to],
+                    start.x[tower], start.y[tower], start.tower_radius[tower]);
+            }
+        }
+    }
+    return true;
+}
+
+// Constructor (ο κόσμος ξεκινά από την αρχική κατάσταση του χάρτη)
+SelfPlayMatch::SelfPlayMatch(const MatchLayout& match_layout, unsigned int seed)
+    : layout(&match_layout), world(match_layout.start), time(0.0f), rng_state(seed ? seed : 1u) {
+    next_decision[0] = FIRST_DECISION;
+    next_decision[1] = FIRST_DECISION;
+}
+
+unsigned int SelfPlayMatch::nextRandom() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Εικόνα όπως του AISystem::takeSnapshot, από τον κόσμο του αγώνα
+// Οι διαδρομές είναι ευθείες (όπως κινούνται τα troops του SimWorld) και η ζημιά τους είναι
+// ο χρόνος μέσα στην ακτίνα κάθε πύργου άλλης πλευράς επί τη ζημιά του ανά δευτερόλεπτο
+void SelfPlayMatch::buildSnapshot(Side side, AISnapshot& snapshot) const {
+    Side opponent = (side == Side::ENEMY) ? Side::PLAYER : Side::ENEMY;
+    int n = world.entity_count;
+
+    snapshot.opponents.clear();
+    snapshot.own.clear();
+    snapshot.neutral.clear();
+    snapshot.troops.clear();
+    float own_power = 0.0f;
+    float opponent_power = 0.0f;
+
+    for (int i = 0; i < n; i++) {
+        AIEntityView view = layout->views[i];
+        view.side = world.side[i];
+        view.health = (int)world.health[i];
+
+        float projected_health;
+        world.project(i, view.projected_side, projected_health);
+        view.projected_health = (int)projected_health;
+
+        float power = view.health * AIPlanner::getPowerFactor(view.kind, view.level);
+        if (view.side == side) {
+            snapshot.own.push_back(view);
+            own_power += power;
+        }
+        else if (view.side == opponent) {
+            snapshot.opponents.push_back(view);
+            opponent_power += power;
+        }
+        else {
+            snapshot.neutral.push_back(view);
+        }
+    }
+
+    for (int t = 0; t < world.troop_count; t++) {
+        int target = world.troop_target[t];
+        float f = world.troop_eta[t] / world.troop_total[t];
+        float tx = world.x[target];
+        float ty = world.y[target];
+
+        AITroopView troop;
+        troop.target = layout->views[target].handle;
+        troop.side = world.troop_side[t];
+        troop.amount = (int)world.troop_amount[t];
+        troop.x = tx + (world.troop_x[t] - tx) * f;
+        troop.y = ty + (world.troop_y[t] - ty) * f;
+        troop.eta = world.troop_eta[t];
+        for (int i = 0; i < AITroopView::PATH_SAMPLES; i++) {
+            float s = (float)i / (AITroopView::PATH_SAMPLES - 1);
+            troop.path_x[i] = troop.x + (tx - troop.x) * s;
+            troop.path_y[i] = troop.y + (ty - troop.y) * s;
+        }
+        snapshot.troops.push_back(troop);
+    }
+
+    int sources = (int)snapshot.own.size();
+    int opponent_count = (int)snapshot.opponents.size();
+    int targets = opponent_count + (int)snapshot.neutral.size();
+    snapshot.routes.assign(sources * targets, AIRoute());
+    for (int i = 0; i < sources; i++) {
+        int from = snapshot.own[i].handle.slot;
+        float speed = world.troop_speed[from];
+        if (speed <= 0.0f) continue;
+
+        for (int j = 0; j < targets; j++) {
+            int to = (j < opponent_count ? snapshot.opponents[j] : snapshot.neutral[j - opponent_count]).handle.slot;
+            AIRoute& route = snapshot.routes[i * targets + j];
+            route.travel = layout->distance[from * n + to] / speed;
+
+            float exposure = 0.0f;
+            for (int tower : layout->towers) {
+                if (world.side[tower] == side) continue;
+                exposure += layout->exposed[(tower * n + from) * n + to] * world.tower_dps[tower];
+            }
+            route.loss = exposure / speed;
+        }
+    }
+
+    snapshot.own_power = (int)own_power;
+    snapshot.opponent_power = (int)opponent_power;
+    snapshot.side = side;
+    snapshot.decide = true;
+    snapshot.search_budget_ms = 0.0f;
+}
+
+// Μόνο αποστολές troops (ο SimWorld δεν έχει αναβαθμίσεις, splash ή spells)
+void SelfPlayMatch::apply(Side side, const AICommand& command) {
+    if (command.type != AICommand::SEND) return;
+
+    int from = command.actor.slot;
+    int to = command.target.slot;
+    if (from < 0 || from >= world.entity_count || to < 0 || to >= world.entity_count) return;
+    if (from == to || world.side[from] != side) return;
+
+    // Αφήνουμε τουλάχιστον 10 ζωή για να μην πεθάνει αμέσως
+    int amount = command.amount;
+    int health = (int)world.health[from];
+    if (health <= amount + 10) {
+        amount = health - 10;
+        if (amount < 5) return;
+    }
+    world.send(from, to, amount);
+}
+
+void SelfPlayMatch::step(SelfPlayAgent& player, SelfPlayAgent& enemy) {
+    SelfPlayAgent* agents[2] = { &player, &enemy };
+    for (int s = 0; s < 2; s++) {
+        if (time < next_decision[s]) continue;
+
+        agents[s]->decide(*this);
+
+        // Τυχαίο διάστημα μεταξύ αποφάσεων (1.5-2.5 δευτερόλεπτα)
+        next_decision[s] = time + 1.5f + (nextRandom() % 1000) / 1000.0f;
+    }
+
+    world.step(STEP_SECONDS);
+    time += STEP_SECONDS;
+}
+
+float SelfPlayMatch::play(SelfPlayAgent& player, SelfPlayAgent& enemy) {
+    while (!isOver()) step(player, enemy);
+    return world.score(Side::ENEMY);
+}
+
+void SelfPlayMatch::setNextDecision(Side side, float decision_time) {
+    next_decision[side == Side::ENEMY ? 1 : 0] = decision_time;
+}
+
+// Μια πλευρά χωρίς entities και χωρίς troops σε κίνηση έχει χάσει
+bool SelfPlayMatch::isOver() const {
+    if (time >= MAX_SECONDS) return true;
+
+    bool alive[2] = { false, false };
+    for (int i = 0; i < world.entity_count; i++) {
+        if (world.side[i] == Side::PLAYER) alive[0] = true;
+        else if (world.side[i] == Side::ENEMY) alive[1] = true;
+    }
+    for (int t = 0; t < world.troop_count; t++) {
+        if (world.troop_side[t] == Side::PLAYER) alive[0] = true;
+        else if (world.troop_side[t] == Side::ENEMY) alive[1] = true;
+    }
+    return !alive[0] || !alive[1];
+}
+
+// Constructor (χωρίς GlobalState και γράφο - μόνο σχεδιασμός πάνω σε εικόνες)
+SelfPlayAgent::SelfPlayAgent(Side side)
+    : planner(side, side == Side::ENEMY ? Side::PLAYER : Side::ENEMY) {
+}
+
+void SelfPlayAgent::decide(SelfPlayMatch& match) {
+    match.buildSnapshot(planner.getSide(), snapshot);
+    if (snapshot.own.empty()) return;
+
+    commands.clear();
+    planner.planSnapshot(snapshot, commands);
+    for (const AICommand& command : commands) {
+        match.apply(planner.getSide(), command);
+    }
+}
@@ -0,0 +1,83 @@
+﻿#pragma once
+#include "ai_search.h"
+#include "ai_planner.h"
+#include <vector>
+
+// Χάρτης αγώνα χωρίς γραφικά: η αρχική κατάσταση ενός level σε SimWorld μαζί με ό,τι
+// χρειάζονται οι εικόνες του AI (είδος, level, στατιστικά) και τα δεδομένα των διαδρομών
+// Φτιάχνεται μία φορά και μετά μόνο διαβάζεται, οπότε τον μοιράζονται όλα τα threads
+struct MatchLayout {
+    int level = 0;
+    unsigned int layout_hash = 0;      // OpeningBook::hashLayout της διάταξης
+    SimWorld start;
+    std::vector<AIEntityView> views;   // Πρότυπα εικόνων (handle.slot = θέση στον κόσμο)
+    std::vector<int> towers;           // Θέσεις των πύργων
+    std::vector<float> distance;       // [from * n + to] ευθεία απόσταση
+    std::vector<float> exposed;        // [(tower * n + from) * n + to] μήκος της ευθείας μέσα στην ακτίνα του πύργου
+
+    // Από level του LevelManager. Δημιουργεί προσωρινά entities στο EntityStore, οπότε
+    // καλείται από ένα thread πριν ξεκινήσουν οι αγώνες (false αν το level δεν χωρά στον SimWorld)
+    bool buildFromLevel(int level_number);
+    int getCount() const { return start.entity_count; }
+};
+
+class SelfPlayAgent;
+
+// Αγώνας χωρίς γραφικά ανάμεσα σε δύο AI (PLAYER και ENEMY) πάνω σε αντίγραφο του χάρτη
+// Η κατάσταση είναι ένας SimWorld, ο χρόνος και τα χρονόμετρα των αποφάσεων, οπότε η αρχή
+// ενός αγώνα είναι μια αντιγραφή struct και ένας αγώνας σε εξέλιξη κλωνοποιείται με απλή
+// αντιγραφή (π.χ. για δοκιμή διαφορετικών συνεχειών από την ίδια θέση)
+// Οι αποφάσεις παίρνονται με τον ίδιο ρυθμό με το παιχνίδι (2 δευτερόλεπτα για την πρώτη,
+// μετά 1.5-2.5). Ο SimWorld δεν έχει αναβαθμίσεις ούτε spells, άρα μόνο οι αποστολές troops
+// εφαρμόζονται (οι εικόνες δηλώνουν ότι καμία αναβάθμιση ή spell δεν είναι διαθέσιμη)
+class SelfPlayMatch {
+public:
+    static const float STEP_SECONDS;        // Βήμα της προσομοίωσης
+    static const float MAX_SECONDS;         // Διάρκεια αγώνα αν καμία πλευρά δεν χάσει
+    static const float FIRST_DECISION;      // Πρώτη απόφαση κάθε πλευράς (όπως το AISystem)
+
+private:
+    const MatchLayout* layout;
+    SimWorld world;
+    float time;
+    float next_decision[2];                 // [0]: PLAYER, [1]: ENEMY
+    unsigned int rng_state;
+
+    unsigned int nextRandom();              // xorshift (όπως το AISearch)
+
+public:
+    SelfPlayMatch(const MatchLayout& match_layout, unsigned int seed);
+
+    // Εικόνα απόφασης για την πλευρά side (με διαδρομές σε ευθεία και ζημιά από πύργους)
+    void buildSnapshot(Side side, AISnapshot& snapshot) const;
+    // Εφαρμογή εντολής της πλευράς side με τους ελέγχους του AISystem::applyCommand
+    void apply(Side side, const AICommand& command);
+
+    void step(SelfPlayAgent& player, SelfPlayAgent& enemy);   // Αποφάσεις που έληξαν και STEP_SECONDS προσομοίωσης
+    float play(SelfPlayAgent& player, SelfPlayAgent& enemy);  // Μέχρι το τέλος - αξιολόγηση της ENEMY στο [0, 1]
+    bool isOver() const;                                      // Μια πλευρά έχασε τα πάντα ή τέλος χρόνου
+
+    // Χρόνος της επόμενης απόφασης μιας πλευράς (π.χ. μετά από άνοιγμα του βιβλίου)
+    void setNextDecision(Side side, float decision_time);
+
+    float getScore(Side side) const { return world.score(side); }
+    float getTime() const { return time; }
+    const SimWorld& getWorld() const { return world; }
+};
+
+// Παίκτης αγώνων χωρίς γραφικά: ένας AIPlanner και οι πίνακες της εικόνας του
+// Ένας ανά πλευρά και thread - επαναχρησιμοποιείται σε όλους τους αγώνες του thread
+class SelfPlayAgent {
+private:
+    AIPlanner planner;
+    AISnapshot snapshot;
+    std::vector<AICommand> commands;
+
+public:
+    explicit SelfPlayAgent(Side side);
+
+    void decide(SelfPlayMatch& match);   // Μία απόφαση στην τρέχουσα κατάσταση του αγώνα
+
+    AIPlanner& getPlanner() { return planner; }
+    Side getSide() const { return planner.getSide(); }
+};
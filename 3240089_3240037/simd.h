@@ -0,0 +1,8 @@
+﻿#pragma once
+
+// SSE είναι διαθέσιμο σε όλους τους x86/x64 compilers που χρησιμοποιούμε
+// Με USE_SSE τα αρχεία χρησιμοποιούν τα intrinsics, αλλιώς τον απλό βρόχο
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define USE_SSE 1
+#endif
@@ -0,0 +1,87 @@
+﻿#include "spatial_hash.h"
+#include <cfloat>
+#include <cmath>
+
+// Το πλέγμα καλύπτει τον καμβά 16x8 με περιθώριο 2 μονάδων γύρω-γύρω
+const float TroopSpatialHash::CELL_SIZE = 1.0f;
+const float TroopSpatialHash::ORIGIN_X = -2.0f;
+const float TroopSpatialHash::ORIGIN_Y = -2.0f;
+const int TroopSpatialHash::GRID_W = 20;
+const int TroopSpatialHash::GRID_H = 12;
+
+// Constructor
+TroopSpatialHash::TroopSpatialHash()
+    : cell_start(GRID_W * GRID_H + 1, 0), cell_cursor(GRID_W * GRID_H, 0) {}
+
+// Κελί στον άξονα x (οι θέσεις εκτός πλέγματος πάνε στα ακριανά κελιά)
+int TroopSpatialHash::cellX(float x) const {
+    int c = (int)std::floor((x - ORIGIN_X) / CELL_SIZE);
+    return std::max(0, std::min(c, GRID_W - 1));
+}
+
+// Κελί στον άξονα y
+int TroopSpatialHash::cellY(float y) const {
+    int c = (int)std::floor((y - ORIGIN_Y) / CELL_SIZE);
+    return std::max(0, std::min(c, GRID_H - 1));
+}
+
+// Χτίσιμο hash με counting sort (δύο περάσματα, χωρίς δεσμεύσεις μετά το πρώτο tick)
+void TroopSpatialHash::build(const std::vector<Troop*>& troops) {
+    std::fill(cell_start.begin(), cell_start.end(), 0);
+    cell_of.resize(troops.size());
+
+    // 1ο πέρασμα: μέτρηση troops ανά κελί
+    int count = 0;
+    for (size_t i = 0; i < troops.size(); i++) {
+        const Troop* troop = troops[i];
+        if (troop->hasArrived() || troop->isDead()) {
+            cell_of[i] = -1;
+            continue;
+        }
+        int cell = cellY(troop->getY()) * GRID_W + cellX(troop->getX());
+        cell_of[i] = cell;
+        cell_start[cell + 1]++;
+        count++;
+    }
+
+    // Prefix sum - η αρχή κάθε κελιού
+    for (size_t c = 1; c < cell_start.size(); c++) {
+        cell_start[c] += cell_start[c - 1];
+    }
+
+    xs.resize(count);
+    ys.resize(count);
+    sides.resize(count);
+    items.resize(count);
+
+    // 2ο πέρασμα: τοποθέτηση κάθε troop στην επόμενη ελεύθερη θέση του κελιού του
+    std::copy(cell_start.begin(), cell_start.end() - 1, cell_cursor.begin());
+    for (size_t i = 0; i < troops.size(); i++) {
+        int cell = cell_of[i];
+        if (cell < 0) continue;
+        int slot = cell_cursor[cell]++;
+        Troop* troop = troops[i];
+        xs[slot] = troop->getX();
+        ys[slot] = troop->getY();
+        sides[slot] = troop->getSide();
+        items[slot] = troop;
+    }
+}
+
+// Εύρεση κοντινότερου αντίπαλου troop
+Troop* TroopSpatialHash::findClosestEnemy(float x, float y, float radius, Side exclude_side) const {
+    Troop* closest = nullptr;
+    float closest_sq = FLT_MAX;
+
+    forEachEnemyInRadius(x, y, radius, exclude_side, [&](Troop* troop) {
+        float dx = troop->getX() - x;
+        float dy = troop->getY() - y;
+        float dist_sq = dx * dx + dy * dy;
+        if (dist_sq < closest_sq) {
+            closest_sq = dist_sq;
+            closest = troop;
+        }
+    });
+
+    return closest;
+}
@@ -0,0 +1,63 @@
+﻿#pragma once
+#include "entity.h"
+#include "troop.h"
+#include <vector>
+#include <algorithm>
+
+// Χωρικό hash (ομοιόμορφο πλέγμα) των ζωντανών troops
+// Ξαναχτίζεται μία φορά ανά tick με counting sort, ώστε κάθε κελί να είναι συνεχές
+// κομμάτι των πινάκων. Οι ερωτήσεις ακτίνας εξετάζουν μόνο τα κελιά που
+// επικαλύπτουν τον κύκλο και συγκρίνουν τετράγωνα αποστάσεων (χωρίς sqrt)
+class TroopSpatialHash {
+private:
+    static const float CELL_SIZE;  // Μέγεθος κελιού (σε μονάδες καμβά)
+    static const float ORIGIN_X;   // Αρχή πλέγματος (λίγο έξω από τον καμβά)
+    static const float ORIGIN_Y;
+    static const int GRID_W;       // Πλήθος κελιών ανά άξονα
+    static const int GRID_H;
+
+    std::vector<int> cell_start;   // Αρχή κάθε κελιού στους πίνακες (GRID_W * GRID_H + 1)
+    std::vector<int> cell_cursor;  // Επόμενη θέση εγγραφής ανά κελί (προσωρινό, κατά το χτίσιμο)
+    std::vector<int> cell_of;      // Κελί κάθε troop κατά το χτίσιμο (προσωρινό)
+
+    // Δεδομένα troops ταξινομημένα ανά κελί (SoA)
+    std::vector<float> xs, ys;
+    std::vector<Side> sides;
+    std::vector<Troop*> items;
+
+    int cellX(float x) const;
+    int cellY(float y) const;
+
+public:
+    TroopSpatialHash();
+
+    // Χτίσιμο από τα ενεργά troops (αγνοούνται όσα έφτασαν ή πέθαναν)
+    void build(const std::vector<Troop*>& troops);
+
+    // Κοντινότερο troop που δεν ανήκει στην πλευρά exclude_side μέσα σε ακτίνα radius
+    Troop* findClosestEnemy(float x, float y, float radius, Side exclude_side) const;
+
+    // Κλήση fn(troop) για κάθε troop που δεν ανήκει στην exclude_side μέσα σε ακτίνα radius
+    template <typename Fn>
+    void forEachEnemyInRadius(float x, float y, float radius, Side exclude_side, Fn fn) const {
+        const float radius_sq = radius * radius;
+        int cx0 = cellX(x - radius), cx1 = cellX(x + radius);
+        int cy0 = cellY(y - radius), cy1 = cellY(y + radius);
+
+        for (int cy = cy0; cy <= cy1; cy++) {
+            for (int cx = cx0; cx <= cx1; cx++) {
+                int cell = cy * GRID_W + cx;
+                for (int i = cell_start[cell]; i < cell_start[cell + 1]; i++) {
+                    if (sides[i] == exclude_side) continue;
+                    float dx = xs[i] - x;
+                    float dy = ys[i] - y;
+                    if (dx * dx + dy * dy <= radius_sq) {
+                        fn(items[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    size_t size() const { return items.size(); }
+};
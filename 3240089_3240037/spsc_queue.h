@@ -0,0 +1,55 @@
+﻿#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// Ουρά ενός παραγωγού και ενός καταναλωτή (single-producer single-consumer) χωρίς locks
+// Κυκλικός πίνακας CAPACITY θέσεων (δύναμη του 2). Ο παραγωγός γράφει μόνο το tail και ο
+// καταναλωτής μόνο το head, οπότε αρκούν atomic μεταβλητές με acquire/release σειρά:
+// κανένα από τα δύο threads δεν περιμένει ποτέ το άλλο
+// Χρησιμοποιείται για την επικοινωνία του main thread με το thread του AI
+template <typename T, size_t CAPACITY>
+class SpscQueue {
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+private:
+    T items[CAPACITY];
+    std::atomic<size_t> head;  // Επόμενη θέση για ανάγνωση (γράφεται μόνο από τον καταναλωτή)
+    std::atomic<size_t> tail;  // Επόμενη θέση για εγγραφή (γράφεται μόνο από τον παραγωγό)
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Προσθήκη (μόνο από τον παραγωγό) - false αν η ουρά είναι γεμάτη
+    bool tryPush(T&& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == CAPACITY) return false;
+
+        items[t & (CAPACITY - 1)] = std::move(item);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPush(const T& item) {
+        T copy = item;
+        return tryPush(std::move(copy));
+    }
+
+    // Αφαίρεση (μόνο από τον καταναλωτή) - false αν η ουρά είναι άδεια
+    bool tryPop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+
+        item = std::move(items[h & (CAPACITY - 1)]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Αν η ουρά είναι άδεια (ακριβές μόνο από την πλευρά του καταναλωτή)
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
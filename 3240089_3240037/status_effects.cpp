@@ -0,0 +1,162 @@
+﻿#include "status_effects.h"
+#include "entity.h"
+#include <algorithm>
+
+StatusEffects* StatusEffects::instance = nullptr;
+
+// Ρυθμίσεις ανά είδος (διάρκεια σε δευτερόλεπτα, κανόνας επανεφαρμογής, μέγιστες εφαρμογές)
+const StatusEffects::Rule StatusEffects::RULES[StatusEffects::KIND_COUNT] = {
+    { 8.0f, StatusEffects::REFRESH, 1 },    // Freeze
+    { 12.0f, StatusEffects::EXTEND, 2 }     // Sickness (έως 24 δευτερόλεπτα)
+};
+
+// Λήψη του μοναδικού instance
+StatusEffects* StatusEffects::getInstance() {
+    if (!instance) {
+        instance = new StatusEffects();
+    }
+    return instance;
+}
+
+// Αναζήτηση effect (λίγα ενεργά effects - γραμμική αναζήτηση σε συνεχή πίνακα)
+int StatusEffects::find(int slot, Kind k) const {
+    for (size_t i = 0; i < target.size(); i++) {
+        if (target[i].slot == slot && kind[i] == k) return (int)i;
+    }
+    return -1;
+}
+
+// Εφαρμογή effect
+void StatusEffects::apply(Entity* entity, Kind k) {
+    if (!entity) return;
+
+    TimerWheel* wheel = TimerWheel::getInstance();
+    const Rule& rule = RULES[k];
+
+    // Υπάρχει ήδη: μόνο νέα διάρκεια με βάση τον κανόνα του είδους
+    int dense = find(entity->getSlot(), k);
+    if (dense >= 0) {
+        float duration = rule.duration;
+        if (rule.stacking == EXTEND) {
+            duration = std::min(wheel->remaining(expiry[dense]) + rule.duration,
+                rule.duration * rule.max_stacks);
+        }
+        if (stacks[dense] < rule.max_stacks) stacks[dense]++;
+
+        int id = id_of[dense];
+        wheel->cancel(expiry[dense]);
+        expiry[dense] = wheel->schedule(duration, [this, id]() { onExpire(id); });
+        return;
+    }
+
+    // Νέο effect στο τέλος των πινάκων
+    int id;
+    if (!free_ids.empty()) {
+        id = free_ids.back();
+        free_ids.pop_back();
+    }
+    else {
+        id = (int)dense_of_id.size();
+        dense_of_id.push_back(-1);
+    }
+
+    dense_of_id[id] = (int)target.size();
+    target.push_back(entity->getHandle());
+    kind.push_back(k);
+    stacks.push_back(1);
+    saved_side.push_back(entity->getSide());
+    expiry.push_back(wheel->schedule(rule.duration, [this, id]() { onExpire(id); }));
+    id_of.push_back(id);
+
+    // Ενέργεια έναρξης
+    switch (k) {
+    case FREEZE:
+        entity->setSide(Side::NEUTRAL);
+        break;
+    case SICKNESS:
+        entity->setSick(true);
+        entity->setMaxHealth(0);
+        break;
+    default:
+        break;
+    }
+}
+
+// Αφαίρεση θέσης: το τελευταίο effect μεταφέρεται στη θέση της
+void StatusEffects::removeAt(int dense) {
+    TimerWheel::getInstance()->cancel(expiry[dense]);
+    dense_of_id[id_of[dense]] = -1;
+    free_ids.push_back(id_of[dense]);
+
+    int last = (int)target.size() - 1;
+    if (dense != last) {
+        target[dense] = target[last];
+        kind[dense] = kind[last];
+        stacks[dense] = stacks[last];
+        saved_side[dense] = saved_side[last];
+        expiry[dense] = expiry[last];
+        id_of[dense] = id_of[last];
+        dense_of_id[id_of[dense]] = dense;
+    }
+
+    target.pop_back();
+    kind.pop_back();
+    stacks.pop_back();
+    saved_side.pop_back();
+    expiry.pop_back();
+    id_of.pop_back();
+}
+
+// Λήξη effect (από το TimerWheel): αφαίρεση και ενέργεια λήξης
+void StatusEffects::onExpire(int id) {
+    int dense = dense_of_id[id];
+    if (dense < 0) return;
+
+    EntityHandle handle = target[dense];
+    Kind k = (Kind)kind[dense];
+    Side side = saved_side[dense];
+    removeAt(dense);  // Πριν από την ενέργεια, γιατί η setSide/setSick μπορεί να ξαναμπεί εδώ
+
+    Entity* entity = EntityStore::getInstance()->resolve(handle);
+    if (!entity) return;
+
+    switch (k) {
+    case FREEZE:
+        // Επιστροφή στην αρχική πλευρά (αν δεν κατακτήθηκε στο μεταξύ)
+        if (entity->getSide() == Side::NEUTRAL) {
+            entity->setSide(side);
+        }
+        break;
+    case SICKNESS:
+        if (entity->isSick()) {
+            entity->setSick(false);
+            entity->setMaxHealth(entity->getOriginalMaxHealth());
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Αφαίρεση χωρίς ενέργεια λήξης
+void StatusEffects::remove(int slot, Kind k) {
+    int dense = find(slot, k);
+    if (dense >= 0) removeAt(dense);
+}
+
+// Αφαίρεση όλων των effects ενός entity (από το τέλος, ώστε η μεταφορά να μη χάνει θέσεις)
+void StatusEffects::removeAll(int slot) {
+    for (int i = (int)target.size() - 1; i >= 0; i--) {
+        if (target[i].slot == slot) removeAt(i);
+    }
+}
+
+bool StatusEffects::has(const Entity* entity, Kind k) const {
+    return entity && find(entity->getSlot(), k) >= 0;
+}
+
+float StatusEffects::remaining(const Entity* entity, Kind k) const {
+    if (!entity) return 0.0f;
+    int dense = find(entity->getSlot(), k);
+    return dense >= 0 ? TimerWheel::getInstance()->remaining(expiry[dense]) : 0.0f;
+}
@@ -0,0 +1,74 @@
+﻿#pragma once
+#include "entity_store.h"
+#include "timer_wheel.h"
+#include <vector>
+
+// Σύστημα χρονικών καταστάσεων (status effects) των spells
+// Κάθε effect έχει διάρκεια, κανόνα για το τι γίνεται όταν ξαναεφαρμοστεί στο ίδιο entity
+// και ενέργεια λήξης. Η λήξη είναι χρονόμετρο στο TimerWheel, οπότε τα entities με effects
+// δεν ελέγχονται κάθε frame
+// Τα effects αποθηκεύονται σε συνεχείς πίνακες (SoA) χωρίς κενά: η αφαίρεση μεταφέρει το
+// τελευταίο effect στη θέση του αφαιρεμένου. Τα callbacks του TimerWheel κρατούν ένα
+// σταθερό id που αντιστοιχίζεται στη θέση του effect μέσω του dense_of_id
+class StatusEffects {
+public:
+    // Είδη effects
+    enum Kind : unsigned char {
+        FREEZE = 0,     // Προσωρινά NEUTRAL, επιστροφή στην αρχική πλευρά στη λήξη
+        SICKNESS = 1,   // Μέγιστη ζωή 0 (χάνει 1 hp/δευτερόλεπτο) μέχρι τη λήξη
+        KIND_COUNT = 2
+    };
+
+    // Κανόνας επανεφαρμογής στο ίδιο entity
+    enum Stacking : unsigned char {
+        REFRESH,        // Η διάρκεια ξεκινά από την αρχή
+        EXTEND          // Η διάρκεια προστίθεται στην υπόλοιπη (μέχρι max_stacks φορές τη βασική)
+    };
+
+    // Ρυθμίσεις ανά είδος
+    struct Rule {
+        float duration;
+        Stacking stacking;
+        int max_stacks;
+    };
+
+private:
+    static StatusEffects* instance;  // Μοναδικό instance (Singleton pattern, όπως το EntityStore)
+    static const Rule RULES[KIND_COUNT];
+
+    // SoA αποθήκευση (θέσεις 0..count-1 σε χρήση)
+    std::vector<EntityHandle> target;   // Entity στο οποίο εφαρμόζεται
+    std::vector<unsigned char> kind;
+    std::vector<unsigned char> stacks;  // Πόσες φορές εφαρμόστηκε
+    std::vector<Side> saved_side;       // Πλευρά πριν από το Freeze
+    std::vector<TimerHandle> expiry;    // Χρονόμετρο λήξης
+    std::vector<int> id_of;             // Σταθερό id κάθε θέσης
+
+    std::vector<int> dense_of_id;       // id -> θέση (-1 αν το id είναι ελεύθερο)
+    std::vector<int> free_ids;
+
+    int find(int slot, Kind k) const;   // Θέση του effect k στο entity slot (-1 αν δεν υπάρχει)
+    void removeAt(int dense);
+    void onExpire(int id);
+
+public:
+    StatusEffects() {}
+
+    static StatusEffects* getInstance();
+
+    StatusEffects(const StatusEffects&) = delete;
+    StatusEffects& operator=(const StatusEffects&) = delete;
+
+    // Εφαρμογή effect σε entity (με τον κανόνα επανεφαρμογής του είδους)
+    void apply(Entity* entity, Kind k);
+
+    // Αφαίρεση χωρίς ενέργεια λήξης (π.χ. όταν το sickness θεραπεύεται νωρίτερα)
+    void remove(int slot, Kind k);
+
+    // Αφαίρεση όλων των effects ενός entity (καταστροφή ή μετατροπή)
+    void removeAll(int slot);
+
+    bool has(const Entity* entity, Kind k) const;
+    float remaining(const Entity* entity, Kind k) const;  // Δευτερόλεπτα μέχρι τη λήξη
+    int getCount() const { return (int)target.size(); }
+};
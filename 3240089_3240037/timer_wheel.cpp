@@ -0,0 +1,170 @@
+﻿#include "timer_wheel.h"
+#include <cmath>
+#include <utility>
+
+const float TimerWheel::TICK_SECONDS = 0.01f;
+const int TimerWheel::LEVELS;
+const int TimerWheel::SLOTS;
+TimerWheel* TimerWheel::instance = nullptr;
+
+// Constructor
+TimerWheel::TimerWheel() : time(0.0), current_tick(0), pending_count(0) {
+    for (int l = 0; l < LEVELS; l++) {
+        for (int s = 0; s < SLOTS; s++) {
+            heads[l][s] = -1;
+        }
+    }
+}
+
+// Λήψη του μοναδικού instance
+TimerWheel* TimerWheel::getInstance() {
+    if (!instance) {
+        instance = new TimerWheel();
+    }
+    return instance;
+}
+
+// Τοποθέτηση κόμβου: το επίπεδο εξαρτάται από το πόσα ticks απέχει η λήξη
+// (επίπεδο 0 για < SLOTS ticks, επίπεδο 1 για < SLOTS^2 κλπ.)
+void TimerWheel::insert(int index) {
+    Node& node = nodes[index];
+    long long delta = node.expiry - current_tick;
+    if (delta < 0) delta = 0;
+
+    int level = 0;
+    long long span = SLOTS;
+    while (level < LEVELS - 1 && delta >= span) {
+        level++;
+        span <<= SLOT_BITS;
+    }
+
+    // Λήξεις πέρα από το τελευταίο επίπεδο μπαίνουν στην πιο μακρινή θέση του
+    // και ξανατοποθετούνται όταν έρθει η σειρά τους
+    long long position = node.expiry;
+    if (delta >= span) position = current_tick + span - 1;
+
+    int slot = (int)((position >> (SLOT_BITS * level)) & (SLOTS - 1));
+    node.level = level;
+    node.slot = slot;
+    node.prev = -1;
+    node.next = heads[level][slot];
+    if (node.next >= 0) nodes[node.next].prev = index;
+    heads[level][slot] = index;
+}
+
+// Αφαίρεση κόμβου από τη λίστα της θέσης του
+void TimerWheel::unlink(int index) {
+    Node& node = nodes[index];
+    if (node.prev >= 0) nodes[node.prev].next = node.next;
+    else heads[node.level][node.slot] = node.next;
+    if (node.next >= 0) nodes[node.next].prev = node.prev;
+    node.prev = node.next = -1;
+}
+
+// Επιστροφή κόμβου στους ελεύθερους (τα handles του παύουν να ισχύουν)
+void TimerWheel::freeNode(int index) {
+    Node& node = nodes[index];
+    node.level = -1;
+    node.callback = nullptr;
+    node.generation++;
+    free_nodes.push_back(index);
+    pending_count--;
+}
+
+// Οι κόμβοι της θέσης που αντιστοιχεί στο τρέχον tick κατεβαίνουν σε χαμηλότερο επίπεδο
+void TimerWheel::cascade(int level) {
+    int slot = (int)((current_tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+    int index = heads[level][slot];
+    heads[level][slot] = -1;
+
+    while (index >= 0) {
+        int next = nodes[index].next;
+        insert(index);
+        index = next;
+    }
+}
+
+// Ένα tick: cascade όταν το χαμηλότερο επίπεδο κάνει κύκλο, και εκτέλεση της θέσης του tick
+void TimerWheel::tick() {
+    current_tick++;
+
+    int slot = (int)(current_tick & (SLOTS - 1));
+    if (slot == 0) {
+        for (int level = 1; level < LEVELS; level++) {
+            cascade(level);
+            if (((current_tick >> (SLOT_BITS * level)) & (SLOTS - 1)) != 0) break;
+        }
+    }
+
+    // Τα callbacks μπορεί να προγραμματίσουν νέα χρονόμετρα, οπότε ο κόμβος
+    // αφαιρείται και ελευθερώνεται πριν από την εκτέλεση
+    while (heads[0][slot] >= 0) {
+        int index = heads[0][slot];
+        unlink(index);
+
+        std::function<void()> callback = std::move(nodes[index].callback);
+        freeNode(index);
+        if (callback) callback();
+    }
+}
+
+// Προγραμματισμός χρονομέτρου (στρογγυλοποίηση προς τα πάνω στο επόμενο tick)
+TimerHandle TimerWheel::schedule(float delay, std::function<void()> callback) {
+    long long expiry = (long long)std::ceil((time + delay) / TICK_SECONDS);
+    if (expiry <= current_tick) expiry = current_tick + 1;
+
+    int index;
+    if (!free_nodes.empty()) {
+        index = free_nodes.back();
+        free_nodes.pop_back();
+    }
+    else {
+        index = (int)nodes.size();
+        nodes.push_back(Node());
+        nodes[index].generation = 0;
+    }
+
+    Node& node = nodes[index];
+    node.expiry = expiry;
+    node.callback = std::move(callback);
+    insert(index);
+    pending_count++;
+
+    TimerHandle handle;
+    handle.index = index;
+    handle.generation = node.generation;
+    return handle;
+}
+
+// Ακύρωση χρονομέτρου (χωρίς εκτέλεση του callback)
+void TimerWheel::cancel(TimerHandle& handle) {
+    if (isPending(handle)) {
+        unlink(handle.index);
+        freeNode(handle.index);
+    }
+    handle = TimerHandle();
+}
+
+// Αν το χρονόμετρο δεν έχει λήξει ακόμα
+bool TimerWheel::isPending(TimerHandle handle) const {
+    if (handle.index < 0 || handle.index >= (int)nodes.size()) return false;
+    const Node& node = nodes[handle.index];
+    return node.level >= 0 && node.generation == handle.generation;
+}
+
+// Υπόλοιπο χρόνου μέχρι τη λήξη
+float TimerWheel::remaining(TimerHandle handle) const {
+    if (!isPending(handle)) return 0.0f;
+    double left = nodes[handle.index].expiry * (double)TICK_SECONDS - time;
+    return left > 0.0 ? (float)left : 0.0f;
+}
+
+// Προώθηση χρόνου (dt σε ms, όπως όλα τα update του παιχνιδιού)
+void TimerWheel::advance(float dt) {
+    time += dt / 1000.0f;
+
+    long long target_tick = (long long)std::floor(time / TICK_SECONDS);
+    while (current_tick < target_tick) {
+        tick();
+    }
+}
@@ -0,0 +1,80 @@
+﻿#pragma once
+#include <vector>
+#include <functional>
+
+// Handle σε χρονόμετρο του TimerWheel (index στον πίνακα κόμβων και generation του κόμβου)
+// Ένα handle χρονομέτρου που έληξε ή ακυρώθηκε δεν είναι πια pending
+struct TimerHandle {
+    int index = -1;
+    unsigned int generation = 0;
+
+    bool isNull() const { return index < 0; }
+};
+
+// Κεντρικός ιεραρχικός τροχός χρονομέτρων (hierarchical timer wheel)
+// Όλα τα χρονόμετρα του παιχνιδιού (cooldowns spells, επιθέσεις πύργων, όρια ζωής,
+// αποφάσεις AI, προετοιμασία spells) προγραμματίζουν εδώ τη λήξη τους αντί να
+// μετράνε χρόνο το καθένα σε δικό του loop κάθε frame
+// Ο χρόνος χωρίζεται σε ticks των TICK_SECONDS. Κάθε επίπεδο έχει SLOTS θέσεις και
+// καλύπτει SLOTS φορές μεγαλύτερο διάστημα από το προηγούμενο. Ένα χρονόμετρο μπαίνει
+// στο επίπεδο που αντιστοιχεί στην απόσταση της λήξης του και κατεβαίνει επίπεδο
+// (cascade) όταν πλησιάσει, οπότε η δουλειά ανά tick είναι ανάλογη των χρονομέτρων
+// που λήγουν και όχι του πλήθους όσων υπάρχουν
+class TimerWheel {
+public:
+    static const float TICK_SECONDS;   // Διάρκεια ενός tick
+    static const int LEVELS = 4;       // Επίπεδα του τροχού
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+
+private:
+    static TimerWheel* instance;  // Μοναδικό instance (Singleton pattern, όπως το EntityStore)
+
+    // Κόμβος χρονομέτρου (διπλά συνδεδεμένη λίστα ανά θέση του τροχού)
+    struct Node {
+        long long expiry;                // Tick λήξης
+        std::function<void()> callback;  // Ενέργεια στη λήξη (κενή για απλή αντίστροφη μέτρηση)
+        int prev, next;
+        int level, slot;                 // Θέση στον τροχό (level = -1 αν ο κόμβος είναι ελεύθερος)
+        unsigned int generation;         // Αυξάνεται όταν ο κόμβος ελευθερώνεται
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> free_nodes;
+    int heads[LEVELS][SLOTS];      // Πρώτος κόμβος κάθε θέσης (-1 αν είναι άδεια)
+
+    double time;                   // Χρόνος σε δευτερόλεπτα από τη δημιουργία
+    long long current_tick;        // Τελευταίο tick που επεξεργάστηκε
+    int pending_count;
+
+    void insert(int index);        // Τοποθέτηση κόμβου στο σωστό επίπεδο βάσει της λήξης
+    void unlink(int index);
+    void freeNode(int index);
+    void cascade(int level);       // Κατέβασμα των κόμβων της τρέχουσας θέσης ενός επιπέδου
+    void tick();                   // Επεξεργασία ενός tick
+
+public:
+    TimerWheel();
+
+    static TimerWheel* getInstance();
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Προγραμματισμός χρονομέτρου που λήγει μετά από delay δευτερόλεπτα
+    TimerHandle schedule(float delay, std::function<void()> callback = std::function<void()>());
+
+    // Ακύρωση (το handle γίνεται null)
+    void cancel(TimerHandle& handle);
+
+    bool isPending(TimerHandle handle) const;
+
+    // Δευτερόλεπτα μέχρι τη λήξη (0 αν δεν είναι pending)
+    float remaining(TimerHandle handle) const;
+
+    // Προώθηση του χρόνου κατά dt (ms) και εκτέλεση των χρονομέτρων που έληξαν
+    void advance(float dt);
+
+    double now() const { return time; }
+    int getPendingCount() const { return pending_count; }
+};
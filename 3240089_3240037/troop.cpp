@@ -4,29 +4,61 @@
 #include "sgg/graphics.h"
 
 // Constructor
-Troop::Troop(Entity* src, Entity* tgt, int amount, const std::vector<std::pair<float, float>>& path)
-    : Node(path.empty() ? 0.0f : path[0].first,
-        path.empty() ? 0.0f : path[0].second),
-    source(src), target(tgt), health_amount(amount),
-    waypoints(path), progress(0.0f), arrived(false) {
+Troop::Troop(Entity* src, Entity* tgt, int amount, std::shared_ptr<const PathData> travel_path)
+    : Node(0.0f, 0.0f),
+    source(src->getHandle()), target(tgt->getHandle()), health_amount(amount),
+    path(std::move(travel_path)), progress(0.0f), path_length(0.0f), arrived(false), ledger_index(-1) {
 
-    //    attacking_speed  
+    // Ταχύτητα βασισμένη στο attacking_speed της πηγής
     speed = src->getAttackingSpeed() * 0.2f;
 
-    if (waypoints.empty()) {
+    if (!path || path->waypoints.empty()) {
         arrived = true;
+        return;
     }
+
+    x = path->waypoints[0].first;
+    y = path->waypoints[0].second;
+    path_length = path->length;
+}
+
+// Πλευρά της πηγής
+Side Troop::getSide() const {
+    const Entity* src = getSource();
+    return src ? src->getSide() : Side::NEUTRAL;
+}
+
+// Χρόνος μέχρι την άφιξη (η πρόοδος και η ταχύτητα μετριούνται σε waypoints)
+float Troop::getTimeToArrival() const {
+    if (arrived || !path || path->waypoints.empty() || speed <= 0.0f) return 0.0f;
+    float left = (float)(path->waypoints.size() - 1) - progress;
+    return left > 0.0f ? left / speed : 0.0f;
+}
+
+// Θέση πιο μπροστά στο μονοπάτι
+std::pair<float, float> Troop::getPositionAhead(float fraction) const {
+    if (!path || path->waypoints.empty()) return std::make_pair(x, y);
+    float left = (float)(path->waypoints.size() - 1) - progress;
+    return interpolatePosition(progress + fraction * std::max(0.0f, left));
+}
+
+// Κανονικοποιημένη πρόοδος στο μονοπάτι
+float Troop::getEdgeParam() const {
+    if (!path || path->waypoints.size() < 2) return 1.0f;
+    const auto& waypoints = path->waypoints;
+    return std::min(1.0f, progress / (float)(waypoints.size() - 1));
 }
 
-//       troop
+// Έλεγχος αν σημείο βρίσκεται μέσα στο troop
 bool Troop::contains(float mx, float my) const {
     float dx = mx - x;
     float dy = my - y;
-    return (dx * dx + dy * dy) <= (0.2f * 0.2f);  //  0.2
+    return (dx * dx + dy * dy) <= (0.2f * 0.2f);  // Ακτίνα 0.2
 }
 
-// Catmull-Rom interpolation     waypoints
-std::pair<float, float> Troop::interpolatePosition(float t) {
+// Catmull-Rom interpolation για ομαλή κίνηση μεταξύ waypoints
+std::pair<float, float> Troop::interpolatePosition(float t) const {
+    const auto& waypoints = path->waypoints;
     if (waypoints.size() < 2) return waypoints[0];
 
     t = std::max(0.0f, std::min(t, (float)(waypoints.size() - 1)));
@@ -34,7 +66,7 @@ std::pair<float, float> Troop::interpolatePosition(float t) {
     int segment = (int)t;
     float local_t = t - segment;
 
-    //  4   Catmull-Rom spline
+    // Εύρεση 4 σημείων για Catmull-Rom spline
     int p0_idx = std::max(0, segment - 1);
     int p1_idx = segment;
     int p2_idx = std::min(segment + 1, (int)waypoints.size() - 1);
@@ -45,7 +77,7 @@ std::pair<float, float> Troop::interpolatePosition(float t) {
     auto& p2 = waypoints[p2_idx];
     auto& p3 = waypoints[p3_idx];
 
-    //  Catmull-Rom spline
+    // Υπολογισμός Catmull-Rom spline
     float t2 = local_t * local_t;
     float t3 = t2 * local_t;
 
@@ -66,16 +98,17 @@ std::pair<float, float> Troop::interpolatePosition(float t) {
     return { x, y };
 }
 
-//   troop  frame
+// Ενημέρωση κατάστασης troop κάθε frame
 void Troop::update(float dt) {
-    if (arrived || waypoints.empty()) return;
+    if (arrived || !path || path->waypoints.empty()) return;
+    const auto& waypoints = path->waypoints;
 
     float dt_sec = dt / 1000.0f;
 
-    //     
+    // Κίνηση κατά μήκος της καμπύλης
     progress += speed * dt_sec * 1.0f; // Adjust multiplier for desired speed
 
-    //    
+    // Έλεγχος άφιξης στον στόχο
     if (progress >= waypoints.size() - 1) {
         arrived = true;
         x = waypoints.back().first;
@@ -83,21 +116,22 @@ void Troop::update(float dt) {
         return;
     }
 
-    //   
+    // Υπολογισμός νέας θέσης
     auto pos = interpolatePosition(progress);
     x = pos.first;
     y = pos.second;
 }
 
-//  troop (     )
+// Σχεδίαση troop (μικρός δίσκος με χρώμα ανάλογα πλευράς)
 void Troop::draw() {
     if (arrived) return;
 
     graphics::Brush br;
-    if (source->getSide() == Side::PLAYER) {
+    Side side = getSide();
+    if (side == Side::PLAYER) {
         br.fill_color[0] = 0.3f; br.fill_color[1] = 0.3f; br.fill_color[2] = 1.0f;
     }
-    else if (source->getSide() == Side::ENEMY) {
+    else if (side == Side::ENEMY) {
         br.fill_color[0] = 1.0f; br.fill_color[1] = 0.3f; br.fill_color[2] = 0.3f;
     }
     else {
@@ -106,13 +140,13 @@ void Troop::draw() {
 
     graphics::drawDisk(x, y, 0.2f, br);
 
-    //    hp  
+    // Κείμενο με το hp που μεταφέρει
     graphics::Brush txt;
     txt.fill_color[0] = txt.fill_color[1] = txt.fill_color[2] = 1.0f;
     graphics::drawText(x - 0.1f, y + 0.1f, 0.15f, std::to_string(health_amount), txt);
 }
 
-//  HP  troop (    )
+// Μείωση HP του troop (όταν δέχεται επίθεση από πύργο)
 void Troop::reduceHealth(int amount) {
     health_amount -= amount;
     if (health_amount < 0) {
@@ -1,43 +1,65 @@
 #pragma once
 #include "node.h"
 #include <vector>
+#include <memory>
 #include "entity.h"
+#include "graph.h"
 
-// Forward declarations ( circular dependencies)
+// Forward declarations (αποφυγή circular dependencies)
 enum class Side;
 class Entity;
 
-//    troops    
-//     Node     hp  
+// Κλάση για τα troops που ταξιδεύουν μεταξύ οντοτήτων
+// Κληρονομεί από  την Node και αναπαριστά μια ομάδα hp που μετακινείται
 class Troop : public Node {
 private:
-    Entity* source; // Entity     troop
-	Entity* target; // Entity     troop
-    int health_amount; //  hp    troop
-    std::vector<std::pair<float, float>> waypoints; //  
-    float progress; //   
-    float speed; //   (  attacking_speed  )
-    bool arrived; //    
+    EntityHandle source; // Entity πηγής που στέλνει το troop
+	EntityHandle target; // Entity στόχος που λαμβάνει το troop
+    int health_amount; // Ποσότητα hp που μεταφέρει το troop
+    std::shared_ptr<const PathData> path; // Μονοπάτι ταξιδιού (κοινόχρηστο με τον γράφο, χωρίς αντιγραφή)
+    float progress; // Πρόοδος στο μονοπάτι
+    float speed; // Ταχύτητα κίνησης (εξαρτάται από attacking_speed της πηγής)
+    float path_length; // Συνολικό μήκος μονοπατιού (σε μονάδες καμβά)
+    bool arrived; // Αν έφτασε στον στόχο
+    int ledger_index; // Θέση στη λίστα αφίξεων του στόχου στο TroopLedger (-1 αν δεν είναι γραμμένο)
 
-    //        
-    std::pair<float, float> interpolatePosition(float t);
+    // Εσωτερική συνάρτηση για εύρεση θέσης σε συγκεκριμένο χρόνο
+    std::pair<float, float> interpolatePosition(float t) const;
 
 public:
 	// Constructor
-    Troop(Entity* src, Entity* tgt, int amount, const std::vector<std::pair<float, float>>& path);
+    Troop(Entity* src, Entity* tgt, int amount, std::shared_ptr<const PathData> travel_path);
 
-    //     Node
+    // Βασικές συναρτήσεις από τη Node
     void update(float dt) override;
     void draw() override;
     bool contains(float mx, float my) const override;
 
     // Getters
     bool hasArrived() const { return arrived; }
-    Entity* getTarget() const { return target; }
-    Entity* getSource() const { return source; }
+    // Πηγή και στόχος (nullptr αν το entity δεν υπάρχει πια)
+    Entity* getTarget() const { return EntityStore::getInstance()->resolve(target); }
+    Entity* getSource() const { return EntityStore::getInstance()->resolve(source); }
+    EntityHandle getTargetHandle() const { return target; }
+    EntityHandle getSourceHandle() const { return source; }
+
+    // Πλευρά του troop (της πηγής του - NEUTRAL αν η πηγή δεν υπάρχει πια)
+    Side getSide() const;
     int getHealthAmount() const { return health_amount; }
+    float getPathLength() const { return path_length; }
+    const PathData* getPath() const { return path.get(); } // Το μονοπάτι με το οποίο ξεκίνησε (ο γράφος μπορεί να έχει νεότερο)
+    float getProgress() const { return progress; }
+    float getTimeToArrival() const; // Δευτερόλεπτα μέχρι την άφιξη με την τρέχουσα ταχύτητα
+    // Θέση μετά από fraction της υπόλοιπης διαδρομής (0 = τρέχουσα θέση, 1 = στόχος)
+    std::pair<float, float> getPositionAhead(float fraction) const;
+
+    // Πρόοδος στο μονοπάτι κανονικοποιημένη στο [0, 1] (0 = πηγή, 1 = στόχος)
+    float getEdgeParam() const;
+
+    int getLedgerIndex() const { return ledger_index; }
+    void setLedgerIndex(int index) { ledger_index = index; }
 
-    //     
+    // Συναρτήσεις για ζημιά από πύργους και από αντίπαλα troops
     void reduceHealth(int amount);
     bool isDead() const { return health_amount <= 0; }
 };
\ No newline at end of file
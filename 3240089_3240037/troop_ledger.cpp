@@ -0,0 +1,115 @@
+﻿#include "troop_ledger.h"
+#include "timer_wheel.h"
+#include <algorithm>
+#include <cmath>
+
+// Ενημέρωση των θέσεων που κρατούν τα troops από το from και μετά
+void TroopLedger::reindex(std::vector<Arrival>& list, size_t from) {
+    for (size_t i = from; i < list.size(); i++) {
+        list[i].troop->setLedgerIndex((int)i);
+    }
+}
+
+// Εισαγωγή στη θέση του χρόνου άφιξης (οι λίστες ανά στόχο είναι μικρές)
+void TroopLedger::add(Troop* troop) {
+    int slot = troop->getTargetHandle().slot;
+    if (slot < 0) return;
+    if (slot >= (int)incoming.size()) incoming.resize(slot + 1);
+
+    Arrival arrival;
+    arrival.troop = troop;
+    arrival.time = TimerWheel::getInstance()->now() + troop->getTimeToArrival();
+
+    std::vector<Arrival>& list = incoming[slot];
+    auto it = std::upper_bound(list.begin(), list.end(), arrival.time,
+        [](double time, const Arrival& a) { return time < a.time; });
+    size_t pos = (size_t)(it - list.begin());
+    list.insert(it, arrival);
+    reindex(list, pos);
+}
+
+void TroopLedger::remove(Troop* troop) {
+    int index = troop->getLedgerIndex();
+    if (index < 0) return;
+
+    std::vector<Arrival>& list = incoming[troop->getTargetHandle().slot];
+    list.erase(list.begin() + index);
+    reindex(list, (size_t)index);
+    troop->setLedgerIndex(-1);
+}
+
+void TroopLedger::clear() {
+    for (auto& list : incoming) {
+        for (Arrival& arrival : list) arrival.troop->setLedgerIndex(-1);
+        list.clear();
+    }
+}
+
+// Άθροισμα της ζωής των troops μιας πλευράς που έρχονται προς το target
+int TroopLedger::getIncoming(const Entity* target, Side side) const {
+    EntityHandle handle = target->getHandle();
+    if (handle.slot < 0 || handle.slot >= (int)incoming.size()) return 0;
+
+    int total = 0;
+    for (const Arrival& arrival : incoming[handle.slot]) {
+        const Troop* troop = arrival.troop;
+        // Troops προς παλιό entity της ίδιας θέσης αφαιρούνται στο επόμενο handleTroopArrivals
+        if (troop->getTargetHandle() != handle || troop->isDead()) continue;
+        if (troop->getSide() == side) total += troop->getHealthAmount();
+    }
+    return total;
+}
+
+// Προσομοίωση των αφίξεων με τη σειρά τους
+TroopLedger::Projection TroopLedger::project(const Entity* target, float seconds) const {
+    Projection result;
+    result.side = target->getSide();
+    result.health = target->getHealth();
+    result.arrivals = 0;
+    result.settle_time = 0.0f;
+
+    EntityHandle handle = target->getHandle();
+    if (handle.slot < 0 || handle.slot >= (int)incoming.size()) return result;
+
+    double now = TimerWheel::getInstance()->now();
+    int max_health = target->getMaxHealth();
+    float healing_speed = target->getHealingSpeed();
+    int defense = (int)target->getDefense();
+    float elapsed = 0.0f;
+
+    for (const Arrival& arrival : incoming[handle.slot]) {
+        float at = std::max(0.0f, (float)(arrival.time - now));
+        if (at > seconds) break;
+
+        const Troop* troop = arrival.troop;
+        if (troop->getTargetHandle() != handle || troop->isDead()) continue;
+        const Entity* source = troop->getSource();
+        if (!source) continue;
+
+        // Healing (ή μείωση πάνω από το μέγιστο) μέχρι την άφιξη - τα NEUTRAL δεν θεραπεύονται
+        float dt = at - elapsed;
+        if (result.side != Side::NEUTRAL && result.health < max_health && healing_speed > 0.0f) {
+            result.health = std::min(max_health, result.health + (int)std::floor(healing_speed * dt));
+        }
+        else if (result.health > max_health) {
+            result.health = std::max(max_health, result.health - (int)std::floor(dt));
+        }
+        elapsed = at;
+
+        int amount = troop->getHealthAmount();
+        Side troop_side = source->getSide();
+        if (troop_side == result.side) {
+            result.health += amount;
+        }
+        else {
+            result.health -= std::max(1, amount - defense);
+            if (result.health < 0) {
+                result.side = troop_side;
+                result.health = -result.health;
+            }
+        }
+        result.arrivals++;
+        result.settle_time = at;
+    }
+    return result;
+}
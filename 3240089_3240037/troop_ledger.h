@@ -0,0 +1,46 @@
+﻿#pragma once
+#include "entity.h"
+#include "troop.h"
+#include <vector>
+
+// Μητρώο των troops που ταξιδεύουν προς κάθε entity (ανά slot του EntityStore)
+// Κάθε troop γράφεται όταν δημιουργείται και σβήνεται όταν φτάσει, πεθάνει ή χαθεί η πηγή
+// ή ο στόχος του, οπότε οι ερωτήσεις για ένα entity εξετάζουν μόνο τα δικά του εισερχόμενα
+// και όχι όλο τον πίνακα των troops. Οι λίστες κρατιούνται ταξινομημένες βάσει χρόνου άφιξης
+// (η ταχύτητα ενός troop δεν αλλάζει, άρα ο χρόνος άφιξης είναι γνωστός από την αποστολή)
+// Η ποσότητα και η πλευρά διαβάζονται από το ίδιο το troop, ώστε οι ζημιές από πύργους
+// και μάχες στη διαδρομή να φαίνονται χωρίς επιπλέον ενημερώσεις
+class TroopLedger {
+public:
+    // Πρόβλεψη της κατάστασης ενός entity μετά από τις αφίξεις
+    struct Projection {
+        Side side;
+        int health;
+        int arrivals;              // Troops που υπολογίστηκαν
+        float settle_time;         // Δευτερόλεπτα μέχρι την τελευταία από αυτές
+    };
+
+private:
+    struct Arrival {
+        Troop* troop;
+        double time;               // Χρόνος άφιξης (στο ρολόι του TimerWheel)
+    };
+
+    std::vector<std::vector<Arrival>> incoming;  // [slot του στόχου]
+
+    void reindex(std::vector<Arrival>& list, size_t from);
+
+public:
+    // Εγγραφή troop που μόλις δημιουργήθηκε και διαγραφή όταν φεύγει από το παιχνίδι
+    void add(Troop* troop);
+    void remove(Troop* troop);
+    void clear();
+
+    // Ζωή που φέρνουν τα troops της πλευράς side προς το target (όσα δεν έχουν φτάσει)
+    int getIncoming(const Entity* target, Side side) const;
+
+    // Πλευρά και ζωή του target μετά από όσα troops φτάνουν μέσα σε seconds, με τους
+    // ίδιους κανόνες με το handleTroopArrivals (άμυνα, κατάληψη) και healing ανάμεσα στις αφίξεις
+    // Η sickness και οι μελλοντικές αποστολές δεν υπολογίζονται
+    Projection project(const Entity* target, float seconds) const;
+};
@@ -0,0 +1,43 @@
+﻿#include "troop_pool.h"
+
+// Constructor
+TroopPool::TroopPool() : in_use(0) {}
+
+// Destructor - αποδέσμευση blocks
+TroopPool::~TroopPool() {
+    clear();
+}
+
+// Δέσμευση νέου block
+void TroopPool::addBlock() {
+    blocks.push_back(std::unique_ptr<Slot[]>(new Slot[BLOCK_SIZE]));
+    Slot* block = blocks.back().get();
+
+    // Οι θέσεις μπαίνουν ανάποδα ώστε η πρώτη acquire να πάρει την αρχή του block
+    free_slots.reserve(free_slots.size() + BLOCK_SIZE);
+    for (size_t i = BLOCK_SIZE; i > 0; i--) {
+        free_slots.push_back(reinterpret_cast<Troop*>(&block[i - 1]));
+    }
+}
+
+// Προ-δέσμευση θέσεων για ομαδική δημιουργία troops
+void TroopPool::reserve(size_t count) {
+    while (free_slots.size() < count) {
+        addBlock();
+    }
+}
+
+// Επιστροφή troop στο pool
+void TroopPool::release(Troop* troop) {
+    if (!troop) return;
+    troop->~Troop();
+    free_slots.push_back(troop);
+    in_use--;
+}
+
+// Καθαρισμός pool
+void TroopPool::clear() {
+    free_slots.clear();
+    blocks.clear();
+    in_use = 0;
+}
@@ -0,0 +1,54 @@
+﻿#pragma once
+#include "troop.h"
+#include <vector>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Pool σταθερών blocks για αποθήκευση troops
+// Τα troops δημιουργούνται μέσα σε προ-δεσμευμένα blocks και επιστρέφουν σε free list
+// όταν φτάσουν ή πεθάνουν, ώστε εκατοντάδες αποστολές ανά δευτερόλεπτο να μην
+// κατακερματίζουν το heap (η μνήμη ενός block δεν ελευθερώνεται μέχρι το clear)
+class TroopPool {
+private:
+    static const size_t BLOCK_SIZE = 256; // Troops ανά block
+
+    typedef std::aligned_storage<sizeof(Troop), alignof(Troop)>::type Slot;
+
+    std::vector<std::unique_ptr<Slot[]>> blocks; // Όλα τα blocks που έχουν δεσμευτεί
+    std::vector<Troop*> free_slots;              // Ελεύθερες θέσεις (LIFO για καλύτερη χρήση cache)
+    size_t in_use;                               // Πλήθος ζωντανών troops
+
+    void addBlock(); // Δέσμευση νέου block και προσθήκη των θέσεών του στη free list
+
+public:
+    TroopPool();
+    ~TroopPool();
+
+    TroopPool(const TroopPool&) = delete;
+    TroopPool& operator=(const TroopPool&) = delete;
+
+    // Εξασφάλιση ότι υπάρχουν τουλάχιστον count ελεύθερες θέσεις (για batched spawning)
+    void reserve(size_t count);
+
+    // Δημιουργία troop σε ελεύθερη θέση του pool
+    template <typename... Args>
+    Troop* acquire(Args&&... args) {
+        if (free_slots.empty()) addBlock();
+        Troop* slot = free_slots.back();
+        free_slots.pop_back();
+        Troop* troop = new (slot) Troop(std::forward<Args>(args)...);
+        in_use++;
+        return troop;
+    }
+
+    // Καταστροφή troop και επιστροφή της θέσης στο pool
+    void release(Troop* troop);
+
+    // Αποδέσμευση όλης της μνήμης (όλα τα troops πρέπει να έχουν επιστραφεί)
+    void clear();
+
+    // Getters
+    size_t getInUse() const { return in_use; }
+    size_t getCapacity() const { return blocks.size() * BLOCK_SIZE; }
+};
@@ -0,0 +1,68 @@
+﻿#include "ai_trace.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Εκτύπωση του ίχνους αποφάσεων (αρχείο του GlobalState::dumpAITrace) σε κείμενο
+// Μία γραμμή ανά εγγραφή, από την παλαιότερη στη νεότερη. Οι εντολές κάθε σχεδιασμού έχουν
+// τον αριθμό του (#plan) και ο σχεδιασμός κλείνει με τη γραμμή plan, με τον χρόνο του
+//
+// Χρήση: ai_trace_view [αρχείο] (προεπιλογή ai_trace.bin)
+
+static const char* TYPE_NAMES[] = { "plan", "send", "upgrade", "splash", "cast", "snapshot", "tick" };
+static const char* ORIGIN_NAMES[] = { "rule", "policy", "search", "opening" };
+static const char* STRATEGY_NAMES[] = { "aggressive", "defensive", "expansive", "mixed", "adaptive" };
+static const char* SIDE_NAMES[] = { "player", "enemy", "neutral" };
+
+static const char* name(const char* const* names, int count, int index) {
+    return (index >= 0 && index < count) ? names[index] : "?";
+}
+
+static void printRecord(const AITraceRecord& r) {
+    std::printf("%10.3f ms  %-7s %-8s", r.time_us / 1000.0, name(SIDE_NAMES, 3, r.side), name(TYPE_NAMES, 7, r.type));
+
+    switch (r.type) {
+    case AITraceRecord::PLAN:
+        std::printf(" #%-5u %-10s%s%s%s aggression %.2f power ratio %.2f entities %u commands %d  %.1f us\n",
+            r.plan, name(STRATEGY_NAMES, 5, r.detail),
+            (r.flags & AITraceRecord::DECIDE) ? " decide" : " spells",
+            (r.flags & AITraceRecord::SEARCHED) ? " search" : "",
+            (r.flags & AITraceRecord::WITH_POLICY) ? " policy" : "",
+            r.score, r.runner_up, r.candidates, r.amount, r.cost_us);
+        break;
+    case AITraceRecord::SEND:
+    case AITraceRecord::UPGRADE:
+    case AITraceRecord::SPLASH:
+    case AITraceRecord::CAST:
+        std::printf(" #%-5u %-8s %3d -> %3d  %s %d  score %.3f (next %.3f, %u candidates)\n",
+            r.plan, name(ORIGIN_NAMES, 4, r.detail), r.actor, r.target,
+            r.type == AITraceRecord::CAST ? "spell" : "amount", r.amount,
+            r.score, r.runner_up, r.candidates);
+        break;
+    case AITraceRecord::SNAPSHOT:
+        std::printf(" %s entities %d troops %u  %.1f us\n",
+            (r.flags & AITraceRecord::DECIDE) ? "decide" : "spells", r.amount, r.candidates, r.cost_us);
+        break;
+    case AITraceRecord::TICK:
+        std::printf(" applied %d%s  %.1f us\n", r.amount, (r.flags & AITraceRecord::SPILLED) ? " spilled" : "", r.cost_us);
+        break;
+    default:
+        std::printf("\n");
+        break;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "ai_trace.bin";
+
+    std::vector<AITraceRecord> records;
+    unsigned long long dropped = 0;
+    if (!AITrace::load(path, records, dropped)) {
+        std::printf("cannot read %s\n", path.c_str());
+        return 1;
+    }
+
+    for (const AITraceRecord& record : records) printRecord(record);
+    std::printf("%d records, %llu dropped\n", (int)records.size(), dropped);
+    return 0;
+}
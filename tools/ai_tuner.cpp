@@ -0,0 +1,221 @@
+﻿#include "self_play.h"
+#include "ai_params.h"
+#include "timer_wheel.h"
+#include "cmaes.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Ρύθμιση των παραμέτρων του AI με CMA-ES πάνω σε αγώνες χωρίς γραφικά (self-play)
+// Κάθε υποψήφιος παίζει εναντίον των αρχικών παραμέτρων σε όλα τα levels και από τις δύο
+// πλευρές, με τους ίδιους σπόρους για όλους τους υποψηφίους μιας γενιάς (λιγότερος θόρυβος
+// στη σύγκριση). Οι αγώνες μοιράζονται σε όλους τους πυρήνες και κάθε βελτίωση γράφεται
+// αμέσως στο αρχείο εξόδου, που φορτώνεται στο παιχνίδι με --params. Οι καλύτερες
+// παράμετροι μέχρι τώρα παίζουν ξανά σε κάθε γενιά με τους σπόρους της, οπότε η σύγκριση
+// με τους νέους υποψηφίους γίνεται πάντα στους ίδιους αγώνες
+//
+// Χρήση: ai_tuner [--generations N] [--matches N] [--threads N] [--seed N] [--policy]
+//                 [--start αρχείο] [--out αρχείο]
+//   --matches: αγώνες ανά level και πλευρά για κάθε υποψήφιο
+//   --policy:  ρύθμιση των βαρών της γραμμικής policy αντί για τους κανόνες της στρατηγικής
+// Τα βάρη των spells δεν ρυθμίζονται (ο SimWorld δεν έχει spells) και μένουν όπως στο --start
+
+static const double INITIAL_SIGMA = 0.3;     // Σε μονάδες της κλίμακας κάθε παραμέτρου
+static const float MIN_SCALE = 0.1f;         // Κλίμακα παραμέτρων με μηδενική αρχική τιμή
+
+struct TunerOptions {
+    int generations = 100;
+    int matches = 16;
+    int threads = 0;                          // 0: όλοι οι πυρήνες
+    unsigned int seed = 1;
+    bool policy = false;
+    std::string start_file;
+    std::string out_file = "ai_params.txt";
+};
+
+// Υποψήφιοι μιας γενιάς και οι αγώνες τους (κοινά για όλα τα threads)
+struct Generation {
+    const std::vector<MatchLayout>* layouts;
+    const AIParams* baseline;
+    std::vector<AIParams> candidates;
+    std::vector<float> scores;                // Ανά αγώνα (θέσεις ξεχωριστές για κάθε thread)
+    int matches_per_candidate;
+    int matches_per_side;
+    unsigned int seed;
+    std::atomic<int> next_match;
+};
+
+// Αγώνες από την κοινή ουρά. Οι αγώνες κάθε υποψηφίου είναι συνεχόμενοι, οπότε οι παράμετροι
+// αλλάζουν μόνο όταν το thread περάσει σε νέο υποψήφιο
+static void runMatches(Generation& generation) {
+    // Παίκτες του thread: ο υποψήφιος και οι αρχικές παράμετροι, σε κάθε πλευρά
+    SelfPlayAgent candidate_player(Side::PLAYER);
+    SelfPlayAgent candidate_enemy(Side::ENEMY);
+    SelfPlayAgent baseline_player(Side::PLAYER);
+    SelfPlayAgent baseline_enemy(Side::ENEMY);
+    baseline_player.getPlanner().setParams(*generation.baseline);
+    baseline_enemy.getPlanner().setParams(*generation.baseline);
+
+    int total = (int)generation.candidates.size() * generation.matches_per_candidate;
+    int loaded = -1;
+    while (true) {
+        int index = generation.next_match.fetch_add(1);
+        if (index >= total) return;
+
+        int c = index / generation.matches_per_candidate;
+        int m = index % generation.matches_per_candidate;
+        if (c != loaded) {
+            candidate_player.getPlanner().setParams(generation.candidates[c]);
+            candidate_enemy.getPlanner().setParams(generation.candidates[c]);
+            loaded = c;
+        }
+
+        // m -> (level, πλευρά του υποψηφίου, αγώνας) - ίδιος σπόρος για όλους τους υποψηφίους
+        int level = m / (2 * generation.matches_per_side);
+        int side = (m / generation.matches_per_side) % 2;
+        unsigned int seed = generation.seed * 7919u + (unsigned int)m * 104729u + 1u;
+
+        SelfPlayAgent& player = side == 0 ? candidate_player : baseline_player;
+        SelfPlayAgent& enemy = side == 0 ? baseline_enemy : candidate_enemy;
+        player.getPlanner().seed(seed);
+        enemy.getPlanner().seed(seed ^ 0x9e3779b9u);
+
+        SelfPlayMatch match((*generation.layouts)[level], seed);
+        float enemy_score = match.play(player, enemy);
+        generation.scores[index] = side == 0 ? 1.0f - enemy_score : enemy_score;
+    }
+}
+
+static bool parseOptions(int argc, char** argv, TunerOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--generations" && has_value) options.generations = std::atoi(argv[++i]);
+        else if (arg == "--matches" && has_value) options.matches = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--threads" && has_value) options.threads = std::atoi(argv[++i]);
+        else if (arg == "--seed" && has_value) options.seed = (unsigned int)std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--start" && has_value) options.start_file = argv[++i];
+        else if (arg == "--out" && has_value) options.out_file = argv[++i];
+        else if (arg == "--policy") options.policy = true;
+        else {
+            std::printf("usage: ai_tuner [--generations N] [--matches N] [--threads N] [--seed N] [--policy] [--start file] [--out file]\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    TunerOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    AIParams baseline;
+    if (!options.start_file.empty() && !baseline.load(options.start_file)) {
+        std::printf("cannot read %s\n", options.start_file.c_str());
+        return 1;
+    }
+
+    // Οι χάρτες και τα singletons δημιουργούνται εδώ, πριν από τα threads (τα entities
+    // του level προγραμματίζουν χρονόμετρα στο TimerWheel)
+    TimerWheel::getInstance();
+    std::vector<MatchLayout> layouts;
+    for (int level = 1; ; level++) {
+        MatchLayout layout;
+        if (!layout.buildFromLevel(level)) break;
+        layouts.push_back(layout);
+    }
+    if (layouts.empty()) return 1;
+
+    // Παράμετροι που ρυθμίζονται: τα βάρη της policy ή οι κανόνες (χωρίς τα spells)
+    std::vector<int> tuned;
+    for (int i = 0; i < AIParams::getCount(); i++) {
+        bool spell = std::string(AIParams::getName(i)).compare(0, 6, "spell_") == 0;
+        if (AIParams::isPolicyWeight(i) == options.policy && !spell) tuned.push_back(i);
+    }
+    std::vector<float> base_values = baseline.toVector();
+    std::vector<double> scale(tuned.size());
+    std::vector<double> start(tuned.size());
+    for (size_t d = 0; d < tuned.size(); d++) {
+        scale[d] = std::max(std::fabs(base_values[tuned[d]]), MIN_SCALE);
+        start[d] = base_values[tuned[d]] / scale[d];
+    }
+
+    int threads = options.threads > 0 ? options.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    CMAES cmaes(start, INITIAL_SIGMA, options.seed);
+
+    Generation generation;
+    generation.layouts = &layouts;
+    generation.baseline = &baseline;
+    generation.matches_per_side = options.matches;
+    generation.matches_per_candidate = (int)layouts.size() * 2 * options.matches;
+
+    std::printf("tuning %d parameters, population %d, %d matches per candidate, %d threads\n",
+        (int)tuned.size(), cmaes.getPopulationSize(), generation.matches_per_candidate, threads);
+
+    // Καλύτερες παράμετροι μέχρι τώρα (τελευταίος υποψήφιος κάθε γενιάς, εκτός από την CMA-ES)
+    AIParams incumbent;
+    bool has_incumbent = false;
+    float best_score = -1.0f;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for (int g = 0; g < options.generations; g++) {
+        const std::vector<std::vector<double>>& points = cmaes.ask();
+
+        generation.candidates.assign(points.size(), baseline);
+        for (size_t c = 0; c < points.size(); c++) {
+            std::vector<float> values = base_values;
+            for (size_t d = 0; d < tuned.size(); d++) values[tuned[d]] = (float)(points[c][d] * scale[d]);
+            generation.candidates[c].fromVector(values);
+            generation.candidates[c].use_policy = options.policy;
+        }
+        if (has_incumbent) generation.candidates.push_back(incumbent);
+        generation.scores.assign(generation.candidates.size() * generation.matches_per_candidate, 0.0f);
+        generation.seed = options.seed + (unsigned int)g;
+        generation.next_match = 0;
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < threads; t++) workers.push_back(std::thread(runMatches, std::ref(generation)));
+        for (std::thread& worker : workers) worker.join();
+
+        // Αξιολόγηση υποψηφίου: μέσο μερίδιο στο τέλος των αγώνων του
+        std::vector<double> fitness(generation.candidates.size(), 0.0);
+        int best = 0;
+        for (size_t c = 0; c < fitness.size(); c++) {
+            for (int m = 0; m < generation.matches_per_candidate; m++) {
+                fitness[c] += generation.scores[c * generation.matches_per_candidate + m];
+            }
+            fitness[c] /= generation.matches_per_candidate;
+            if (c < points.size() && fitness[c] > fitness[best]) best = (int)c;
+        }
+        if (has_incumbent) {
+            best_score = (float)fitness.back();
+            fitness.pop_back();
+        }
+        double average = 0.0;
+        for (double f : fitness) average += f;
+        average /= fitness.size();
+
+        cmaes.tell(fitness);
+
+        if (fitness[best] > best_score) {
+            best_score = (float)fitness[best];
+            incumbent = generation.candidates[best];
+            has_incumbent = true;
+            incumbent.save(options.out_file);
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        std::printf("generation %d: best %.4f mean %.4f incumbent %.4f sigma %.3f (%.1f s)\n", g + 1, fitness[best], average,
+            best_score, cmaes.getSigma(), seconds);
+        std::fflush(stdout);
+    }
+
+    std::printf("best score %.4f against the starting parameters, written to %s\n", best_score, options.out_file.c_str());
+    return 0;
+}
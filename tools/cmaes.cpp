@@ -0,0 +1,165 @@
+﻿#include "cmaes.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+// Constructor (C = I, βάρη log για τους mu καλύτερους)
+CMAES::CMAES(const std::vector<double>& initial_mean, double initial_sigma, unsigned int seed)
+    : dimension((int)initial_mean.size()), mean(initial_mean), sigma(initial_sigma), generation(0), rng(seed) {
+    int n = dimension;
+    population_size = 4 + (int)(3.0 * std::log((double)std::max(n, 1)));
+    parents = population_size / 2;
+
+    weights.resize(parents);
+    for (int i = 0; i < parents; i++) {
+        weights[i] = std::log(parents + 0.5) - std::log(i + 1.0);
+    }
+    double sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    double sum_sq = 0.0;
+    for (double& w : weights) {
+        w /= sum;
+        sum_sq += w * w;
+    }
+    mueff = 1.0 / sum_sq;
+
+    cc = (4.0 + mueff / n) / (n + 4.0 + 2.0 * mueff / n);
+    cs = (mueff + 2.0) / (n + mueff + 5.0);
+    c1 = 2.0 / ((n + 1.3) * (n + 1.3) + mueff);
+    cmu = std::min(1.0 - c1, 2.0 * (mueff - 2.0 + 1.0 / mueff) / ((n + 2.0) * (n + 2.0) + mueff));
+    damps = 1.0 + 2.0 * std::max(0.0, std::sqrt((mueff - 1.0) / (n + 1.0)) - 1.0) + cs;
+    chi_n = std::sqrt((double)n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+
+    pc.assign(n, 0.0);
+    ps.assign(n, 0.0);
+    C.assign(n * n, 0.0);
+    B.assign(n * n, 0.0);
+    D.assign(n, 1.0);
+    for (int i = 0; i < n; i++) {
+        C[i * n + i] = 1.0;
+        B[i * n + i] = 1.0;
+    }
+}
+
+// Υποψήφιοι: x = mean + sigma * B D z με z ~ N(0, I)
+const std::vector<std::vector<double>>& CMAES::ask() {
+    int n = dimension;
+    std::normal_distribution<double> normal(0.0, 1.0);
+    candidates.assign(population_size, std::vector<double>(n));
+    steps.assign(population_size, std::vector<double>(n));
+
+    std::vector<double> z(n);
+    for (int k = 0; k < population_size; k++) {
+        for (int i = 0; i < n; i++) z[i] = D[i] * normal(rng);
+        for (int i = 0; i < n; i++) {
+            double y = 0.0;
+            for (int j = 0; j < n; j++) y += B[i * n + j] * z[j];
+            steps[k][i] = y;
+            candidates[k][i] = mean[i] + sigma * y;
+        }
+    }
+    return candidates;
+}
+
+void CMAES::tell(const std::vector<double>& fitness) {
+    int n = dimension;
+    std::vector<int> order(population_size);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&fitness](int a, int b) { return fitness[a] > fitness[b]; });
+
+    // Νέος μέσος από τους mu καλύτερους (σταθμισμένο βήμα y_w)
+    std::vector<double> y_w(n, 0.0);
+    for (int i = 0; i < parents; i++) {
+        const std::vector<double>& y = steps[order[i]];
+        for (int d = 0; d < n; d++) y_w[d] += weights[i] * y[d];
+    }
+    for (int d = 0; d < n; d++) mean[d] += sigma * y_w[d];
+
+    // Διαδρομή του sigma: C^-1/2 y_w = B D^-1 B^T y_w
+    std::vector<double> t(n, 0.0);
+    for (int i = 0; i < n; i++) {
+        double s = 0.0;
+        for (int j = 0; j < n; j++) s += B[j * n + i] * y_w[j];
+        t[i] = s / D[i];
+    }
+    double ps_norm_sq = 0.0;
+    double cs_factor = std::sqrt(cs * (2.0 - cs) * mueff);
+    for (int i = 0; i < n; i++) {
+        double s = 0.0;
+        for (int j = 0; j < n; j++) s += B[i * n + j] * t[j];
+        ps[i] = (1.0 - cs) * ps[i] + cs_factor * s;
+        ps_norm_sq += ps[i] * ps[i];
+    }
+    generation++;
+    double ps_norm = std::sqrt(ps_norm_sq);
+    bool hsig = ps_norm / std::sqrt(1.0 - std::pow(1.0 - cs, 2.0 * generation)) / chi_n < 1.4 + 2.0 / (n + 1.0);
+
+    // Διαδρομή και ενημέρωση του C (rank-one και rank-mu)
+    double cc_factor = hsig ? std::sqrt(cc * (2.0 - cc) * mueff) : 0.0;
+    for (int i = 0; i < n; i++) pc[i] = (1.0 - cc) * pc[i] + cc_factor * y_w[i];
+
+    double keep = 1.0 - c1 - cmu + (hsig ? 0.0 : c1 * cc * (2.0 - cc));
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            double rank_mu = 0.0;
+            for (int k = 0; k < parents; k++) {
+                const std::vector<double>& y = steps[order[k]];
+                rank_mu += weights[k] * y[i] * y[j];
+            }
+            double value = keep * C[i * n + j] + c1 * pc[i] * pc[j] + cmu * rank_mu;
+            C[i * n + j] = value;
+            C[j * n + i] = value;
+        }
+    }
+
+    sigma *= std::exp((cs / damps) * (ps_norm / chi_n - 1.0));
+    decompose();
+}
+
+// Jacobi με κυκλικές περιστροφές: B οι ιδιοδιανύσματα (στήλες), D οι τετραγωνικές ρίζες των ιδιοτιμών
+void CMAES::decompose() {
+    int n = dimension;
+    std::vector<double> a = C;
+    std::fill(B.begin(), B.end(), 0.0);
+    for (int i = 0; i < n; i++) B[i * n + i] = 1.0;
+
+    for (int sweep = 0; sweep < 50; sweep++) {
+        double off = 0.0;
+        for (int p = 0; p < n; p++) {
+            for (int q = p + 1; q < n; q++) off += a[p * n + q] * a[p * n + q];
+        }
+        if (off < 1e-20) break;
+
+        for (int p = 0; p < n; p++) {
+            for (int q = p + 1; q < n; q++) {
+                double apq = a[p * n + q];
+                if (std::fabs(apq) < 1e-300) continue;
+
+                double theta = (a[q * n + q] - a[p * n + p]) / (2.0 * apq);
+                double tangent = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                double c = 1.0 / std::sqrt(tangent * tangent + 1.0);
+                double s = tangent * c;
+
+                for (int k = 0; k < n; k++) {
+                    double akp = a[k * n + p];
+                    double akq = a[k * n + q];
+                    a[k * n + p] = c * akp - s * akq;
+                    a[k * n + q] = s * akp + c * akq;
+                }
+                for (int k = 0; k < n; k++) {
+                    double apk = a[p * n + k];
+                    double aqk = a[q * n + k];
+                    a[p * n + k] = c * apk - s * aqk;
+                    a[q * n + k] = s * apk + c * aqk;
+                }
+                for (int k = 0; k < n; k++) {
+                    double bkp = B[k * n + p];
+                    double bkq = B[k * n + q];
+                    B[k * n + p] = c * bkp - s * bkq;
+                    B[k * n + q] = s * bkp + c * bkq;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < n; i++) D[i] = std::sqrt(std::max(a[i * n + i], 1e-20));
+}
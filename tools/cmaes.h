@@ -0,0 +1,42 @@
+﻿#pragma once
+#include <vector>
+#include <random>
+
+// CMA-ES (Covariance Matrix Adaptation Evolution Strategy) για μεγιστοποίηση χωρίς παραγώγους
+// Σε κάθε γενιά η ask δίνει population_size υποψήφιους από την κανονική κατανομή N(mean, sigma^2 C)
+// και η tell παίρνει τις αξιολογήσεις τους: ο μέσος μετακινείται προς τους καλύτερους και ο
+// πίνακας C μαθαίνει τις κατευθύνσεις που βελτιώνουν, οπότε αντέχει θόρυβο στις αξιολογήσεις
+// (όπως οι αγώνες με τυχαιότητα) και παραμέτρους σε διαφορετικές κλίμακες
+// Οι σταθερές είναι οι προεπιλογές του Hansen (The CMA Evolution Strategy: A Tutorial)
+class CMAES {
+private:
+    int dimension;
+    int population_size;     // lambda
+    int parents;             // mu
+    std::vector<double> weights;
+    double mueff;
+    double cc, cs, c1, cmu, damps, chi_n;
+
+    std::vector<double> mean;
+    double sigma;
+    std::vector<double> pc, ps;             // Διαδρομές εξέλιξης
+    std::vector<double> C, B, D;            // C = B diag(D^2) B^T (πίνακες n x n κατά γραμμές)
+    std::vector<std::vector<double>> candidates;
+    std::vector<std::vector<double>> steps; // y = B D z κάθε υποψηφίου
+    long long generation;
+    std::mt19937 rng;
+
+    void decompose();        // Ιδιοδιάσπαση του C (Jacobi - οι διαστάσεις είναι λίγες δεκάδες)
+
+public:
+    CMAES(const std::vector<double>& initial_mean, double initial_sigma, unsigned int seed);
+
+    const std::vector<std::vector<double>>& ask();
+    void tell(const std::vector<double>& fitness);   // Μία αξιολόγηση ανά υποψήφιο της ask (μεγαλύτερη = καλύτερη)
+
+    int getPopulationSize() const { return population_size; }
+    int getDimension() const { return dimension; }
+    const std::vector<double>& getMean() const { return mean; }
+    double getSigma() const { return sigma; }
+    long long getGeneration() const { return generation; }
+};
@@ -0,0 +1,276 @@
+﻿#include "self_play.h"
+#include "opening_book.h"
+#include "timer_wheel.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Δημιουργία του βιβλίου ανοιγμάτων με αγώνες χωρίς γραφικά
+// Για κάθε level και πλευρά το άνοιγμα χτίζεται άπληστα: σε κάθε σημείο απόφασης (όπως
+// του AI) δοκιμάζονται όλες οι αποστολές από τα entities της πλευράς με λίγες ποσότητες
+// και κρατιέται η καλύτερη, αν είναι καλύτερη από το να μη σταλεί τίποτα. Κάθε δοκιμή
+// αξιολογείται με αγώνες μέχρι το τέλος (rollouts), όπου και οι δύο πλευρές παίζουν με το
+// AI και η πλευρά του ανοίγματος ξεκινά τις αποφάσεις της αμέσως μετά τη δοκιμή, όπως
+// στο παιχνίδι μετά την τελευταία αποστολή του ανοίγματος. Όταν η καλύτερη δοκιμή είναι
+// "καμία αποστολή" το άνοιγμα τελειώνει εκεί. Όλες οι δοκιμές ενός σημείου χρησιμοποιούν
+// τους ίδιους σπόρους και μοιράζονται σε όλους τους πυρήνες. Στο τέλος κάθε γραμμή
+// συγκρίνεται με το AI χωρίς άνοιγμα σε αγώνες με άλλους σπόρους και κρατιέται μόνο αν
+// είναι καλύτερη. Και οι δύο πλευρές παίζουν με τους κανόνες χωρίς αναζήτηση, οπότε το
+// παιχνίδι δεν χρησιμοποιεί το βιβλίο στη δυσκολία με αναζήτηση
+//
+// Χρήση: opening_book_gen [--rollouts N] [--seconds S] [--threads N] [--seed N] [--out αρχείο]
+
+static const float DECISION_SPACING = 2.0f;      // Απόσταση σημείων απόφασης (μέσο διάστημα του AI)
+static const int MAX_MOVES_PER_POINT = 2;        // Αποστολές ανά σημείο απόφασης
+static const float AMOUNT_FRACTIONS[] = { 0.3f, 0.6f, 1.0f };  // Μέρος της ζωής πάνω από 10
+static const int EVALUATION_MATCHES = 200;       // Αγώνες για τη σύγκριση με το AI χωρίς άνοιγμα
+
+struct GeneratorOptions {
+    int rollouts = 64;
+    float seconds = 10.0f;
+    int threads = 0;                              // 0: όλοι οι πυρήνες
+    unsigned int seed = 1;
+    std::string out_file = OpeningBook::DEFAULT_FILE;
+};
+
+// Δοκιμές ενός σημείου απόφασης (κοινές για όλα τα threads)
+struct Batch {
+    const SelfPlayMatch* base;                    // Κατάσταση στο σημείο απόφασης
+    Side side;
+    std::vector<AICommand> candidates;            // Η πρώτη είναι "καμία αποστολή" (DONE)
+    const OpeningLine* line;                      // Άλλες δοκιμές: ολόκληρο άνοιγμα από την αρχή
+    int rollouts;
+    unsigned int seed;
+    std::vector<float> scores;                    // [candidate * rollouts + rollout]
+    std::atomic<int> next_job;
+};
+
+// Αγώνας μέχρι το τέλος, με τις αποστολές του ανοίγματος στους χρόνους τους
+static float playLine(SelfPlayMatch match, const OpeningLine* line, Side side, SelfPlayAgent& player, SelfPlayAgent& enemy) {
+    size_t next = 0;
+    while (!match.isOver()) {
+        while (line && next < line->moves.size() && line->moves[next].time <= match.getTime()) {
+            const OpeningMove& move = line->moves[next++];
+            AICommand command;
+            command.type = AICommand::SEND;
+            command.actor.slot = move.from;
+            command.target.slot = move.to;
+            command.amount = move.amount;
+            match.apply(side, command);
+        }
+        match.step(player, enemy);
+    }
+    return match.getScore(side);
+}
+
+static void runBatch(Batch& batch) {
+    SelfPlayAgent player(Side::PLAYER);
+    SelfPlayAgent enemy(Side::ENEMY);
+
+    int total = (int)batch.candidates.size() * batch.rollouts;
+    while (true) {
+        int index = batch.next_job.fetch_add(1);
+        if (index >= total) return;
+
+        int c = index / batch.rollouts;
+        int r = index % batch.rollouts;
+        unsigned int seed = batch.seed * 7919u + (unsigned int)r * 104729u + 1u;
+        player.getPlanner().seed(seed);
+        enemy.getPlanner().seed(seed ^ 0x9e3779b9u);
+
+        SelfPlayMatch match = *batch.base;
+        match.apply(batch.side, batch.candidates[c]);
+        batch.scores[index] = playLine(match, batch.line, batch.side, player, enemy);
+    }
+}
+
+// Μέση αξιολόγηση κάθε δοκιμής (παράλληλα)
+static std::vector<float> evaluate(Batch& batch, int threads) {
+    batch.scores.assign(batch.candidates.size() * batch.rollouts, 0.0f);
+    batch.next_job = 0;
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) workers.push_back(std::thread(runBatch, std::ref(batch)));
+    for (std::thread& worker : workers) worker.join();
+
+    std::vector<float> means(batch.candidates.size(), 0.0f);
+    for (size_t c = 0; c < means.size(); c++) {
+        for (int r = 0; r < batch.rollouts; r++) means[c] += batch.scores[c * batch.rollouts + r];
+        means[c] /= batch.rollouts;
+    }
+    return means;
+}
+
+// Αποστολές της πλευράς στην τρέχουσα κατάσταση (με την "καμία αποστολή" πρώτη)
+static void listCandidates(const SimWorld& world, Side side, std::vector<AICommand>& out) {
+    out.assign(1, AICommand());
+    for (int from = 0; from < world.entity_count; from++) {
+        if (world.side[from] != side || world.troop_speed[from] <= 0.0f) continue;
+
+        int spare = (int)world.health[from] - 10;
+        int last_amount = 0;
+        for (float fraction : AMOUNT_FRACTIONS) {
+            int amount = (int)(spare * fraction);
+            if (amount < 5 || amount == last_amount) continue;
+            last_amount = amount;
+
+            for (int to = 0; to < world.entity_count; to++) {
+                if (to == from || world.side[to] == side) continue;
+
+                AICommand command;
+                command.type = AICommand::SEND;
+                command.actor.slot = from;
+                command.target.slot = to;
+                command.amount = amount;
+                out.push_back(command);
+            }
+        }
+    }
+}
+
+// Άνοιγμα μιας πλευράς σε ένα level
+static OpeningLine buildLine(const MatchLayout& layout, Side side, const GeneratorOptions& options, int threads) {
+    OpeningLine line;
+    line.level = layout.level;
+    line.side = side;
+    line.layout_hash = layout.layout_hash;
+
+    // Η κατάσταση προχωρά με το AI του αντιπάλου (η πλευρά του ανοίγματος παίζει μόνο τις
+    // αποστολές της γραμμής)
+    SelfPlayAgent player(Side::PLAYER);
+    SelfPlayAgent enemy(Side::ENEMY);
+    player.getPlanner().seed(options.seed);
+    enemy.getPlanner().seed(options.seed ^ 0x9e3779b9u);
+    SelfPlayMatch state(layout, options.seed);
+    state.setNextDecision(side, options.seconds);
+
+    Batch batch;
+    batch.side = side;
+    batch.line = nullptr;
+    batch.rollouts = options.rollouts;
+
+    bool ended = false;
+    int point = 0;
+    for (float t = SelfPlayMatch::FIRST_DECISION; t < options.seconds && !ended; t += DECISION_SPACING, point++) {
+        while (state.getTime() < t && !state.isOver()) state.step(player, enemy);
+        if (state.isOver()) break;
+
+        for (int m = 0; m < MAX_MOVES_PER_POINT; m++) {
+            listCandidates(state.getWorld(), side, batch.candidates);
+            if (batch.candidates.size() <= 1) break;
+
+            // Στις δοκιμές το AI της πλευράς αναλαμβάνει αμέσως μετά την αποστολή
+            SelfPlayMatch handover = state;
+            handover.setNextDecision(side, std::max(SelfPlayMatch::FIRST_DECISION, state.getTime()));
+            batch.base = &handover;
+            batch.seed = options.seed + (unsigned int)(point * MAX_MOVES_PER_POINT + m);
+            std::vector<float> means = evaluate(batch, threads);
+
+            int best = (int)(std::max_element(means.begin(), means.end()) - means.begin());
+            if (best == 0) {
+                ended = true;   // Καλύτερα να αποφασίσει το AI από εδώ
+                break;
+            }
+
+            const AICommand& command = batch.candidates[best];
+            OpeningMove move;
+            move.time = state.getTime();
+            move.from = command.actor.slot;
+            move.to = command.target.slot;
+            move.amount = command.amount;
+            line.moves.push_back(move);
+            line.end_time = move.time;
+            state.apply(side, command);
+        }
+    }
+    return line;
+}
+
+// Μέση αξιολόγηση της πλευράς με το άνοιγμα και με το AI από την αρχή (ίδιοι σπόροι)
+static void compareLine(const MatchLayout& layout, const OpeningLine& line, const GeneratorOptions& options, int threads,
+    float& with_book, float& without_book) {
+    SelfPlayMatch start(layout, options.seed + 1000u);
+
+    Batch batch;
+    batch.base = &start;
+    batch.side = line.side;
+    batch.candidates.assign(1, AICommand());
+    batch.rollouts = EVALUATION_MATCHES;
+    batch.seed = options.seed + 1000u;
+
+    batch.line = nullptr;
+    without_book = evaluate(batch, threads)[0];
+
+    SelfPlayMatch delayed = start;
+    delayed.setNextDecision(line.side, std::max(SelfPlayMatch::FIRST_DECISION, line.end_time));
+    batch.base = &delayed;
+    batch.line = &line;
+    with_book = evaluate(batch, threads)[0];
+}
+
+static bool parseOptions(int argc, char** argv, GeneratorOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--rollouts" && has_value) options.rollouts = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--seconds" && has_value) options.seconds = (float)std::atof(argv[++i]);
+        else if (arg == "--threads" && has_value) options.threads = std::atoi(argv[++i]);
+        else if (arg == "--seed" && has_value) options.seed = (unsigned int)std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--out" && has_value) options.out_file = argv[++i];
+        else {
+            std::printf("usage: opening_book_gen [--rollouts N] [--seconds S] [--threads N] [--seed N] [--out file]\n");
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    GeneratorOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    // Οι χάρτες και τα singletons δημιουργούνται εδώ, πριν από τα threads
+    TimerWheel::getInstance();
+    std::vector<MatchLayout> layouts;
+    for (int level = 1; ; level++) {
+        MatchLayout layout;
+        if (!layout.buildFromLevel(level)) break;
+        layouts.push_back(layout);
+    }
+    if (layouts.empty()) return 1;
+
+    int threads = options.threads > 0 ? options.threads : (int)std::max(1u, std::thread::hardware_concurrency());
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    OpeningBook book;
+    const Side sides[2] = { Side::ENEMY, Side::PLAYER };
+    for (const MatchLayout& layout : layouts) {
+        for (Side side : sides) {
+            OpeningLine line = buildLine(layout, side, options, threads);
+
+            // Γραμμή που δεν ξεπερνά το AI σε αγώνες με άλλους σπόρους δεν μπαίνει στο βιβλίο
+            float with_book, without_book;
+            compareLine(layout, line, options, threads, with_book, without_book);
+            bool kept = !line.moves.empty() && with_book > without_book;
+            if (kept) book.add(line);
+
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            std::printf("level %d %s: %d moves, score %.3f (without book %.3f)%s (%.1f s)\n", layout.level,
+                side == Side::ENEMY ? "enemy" : "player", (int)line.moves.size(), with_book, without_book,
+                kept ? "" : " - skipped", seconds);
+            std::fflush(stdout);
+        }
+    }
+
+    if (!book.save(options.out_file)) {
+        std::printf("cannot write %s\n", options.out_file.c_str());
+        return 1;
+    }
+    std::printf("written to %s\n", options.out_file.c_str());
+    return 0;
+}